@@ -13,6 +13,9 @@ template <typename UintT>
 class ModArith
 {
 public:
+    /// The type of the unreduced double-width products (see mul_wide()).
+    using WideT = intx::uint<UintT::num_bits * 2>;
+
     const UintT mod;  ///< The modulus.
 
 private:
@@ -113,6 +116,136 @@ public:
         return static_cast<UintT>(t);
     }
 
+    /// Performs a Montgomery modular squaring.
+    ///
+    /// The result is the same as of mul(x, x) but it is computed with sqr_wide()
+    /// what saves almost half of the word multiplications.
+    constexpr UintT sqr(const UintT& x) const noexcept { return reduce(sqr_wide(x)); }
+
+    /// Computes the full (double-width) product without the modular reduction.
+    ///
+    /// This is the building block of the lazy reduction: the sum of the products is reduced once
+    /// with reduce() instead of reducing every product, e.g. reduce(add_wide(mul_wide(a, b),
+    /// mul_wide(c, d))) is the Montgomery form of a⋅b + c⋅d for the inputs in Montgomery form.
+    static constexpr WideT mul_wide(const UintT& x, const UintT& y) noexcept
+    {
+        constexpr auto S = UintT::num_words;  // TODO(C++23): Make it static
+
+        WideT t;
+        for (size_t i = 0; i != S; ++i)
+        {
+            uint64_t c = 0;
+#pragma GCC unroll 8
+            for (size_t j = 0; j != S; ++j)
+                std::tie(c, t[i + j]) = addmul(t[i + j], x[j], y[i], c);
+            t[i + S] = c;
+        }
+        return t;
+    }
+
+    /// Computes the full (double-width) square without the modular reduction.
+    ///
+    /// The symmetric partial products x[i]⋅x[j] (i ≠ j) are computed once and doubled.
+    static constexpr WideT sqr_wide(const UintT& x) noexcept
+    {
+        constexpr auto S = UintT::num_words;  // TODO(C++23): Make it static
+
+        // The products above the diagonal.
+        WideT t;
+#pragma GCC unroll 8
+        for (size_t i = 0; i != S - 1; ++i)
+        {
+            uint64_t c = 0;
+#pragma GCC unroll 8
+            for (size_t j = i + 1; j != S; ++j)
+                std::tie(c, t[i + j]) = addmul(t[i + j], x[j], x[i], c);
+            t[i + S] = c;
+        }
+
+        // Double the products above the diagonal.
+#pragma GCC unroll 8
+        for (size_t i = 2 * S - 1; i != 0; --i)
+            t[i] = (t[i] << 1) | (t[i - 1] >> 63);
+        t[0] <<= 1;
+
+        // Add the squares of the words on the diagonal.
+        bool carry = false;
+#pragma GCC unroll 8
+        for (size_t i = 0; i != S; ++i)
+        {
+            const auto p = intx::umul(x[i], x[i]);
+            const auto lo = intx::addc(t[2 * i], p[0], carry);
+            t[2 * i] = lo.value;
+            const auto hi = intx::addc(t[2 * i + 1], p[1], lo.carry);
+            t[2 * i + 1] = hi.value;
+            carry = hi.carry;
+        }
+        return t;
+    }
+
+    /// Adds the unreduced products.
+    ///
+    /// The result must stay below mod⋅R to be reduced, e.g. the sum of two products
+    /// is always reducible if the modulus top bit is clear (2⋅mod < R).
+    static constexpr WideT add_wide(const WideT& x, const WideT& y) noexcept { return x + y; }
+
+    /// Subtracts the unreduced products. It is required that x < mod⋅R and y < mod⋅R.
+    /// The result is also less than mod⋅R.
+    ///
+    /// In case of the underflow, mod⋅R (0 modulo mod) is added back. This only adds the modulus
+    /// to the upper half of the result, so no additional constant (e.g. mod²) is needed.
+    constexpr WideT sub_wide(const WideT& x, const WideT& y) const noexcept
+    {
+        constexpr auto S = UintT::num_words;  // TODO(C++23): Make it static
+
+        auto d = subc(x, y);
+        if (d.carry)
+        {
+            // The final carry of the addition cancels the borrow.
+            bool carry = false;
+            for (size_t i = 0; i != S; ++i)
+            {
+                const auto s = intx::addc(d.value[S + i], mod[i], carry);
+                d.value[S + i] = s.value;
+                carry = s.carry;
+            }
+        }
+        return d.value;
+    }
+
+    /// Performs the Montgomery reduction of the unreduced product: xR⁻¹ % mod.
+    ///
+    /// Uses the Separated Operand Scanning (SOS) method. It is required that x < mod⋅R.
+    constexpr UintT reduce(const WideT& x) const noexcept
+    {
+        constexpr auto S = UintT::num_words;  // TODO(C++23): Make it static
+
+        // Make the lower S words 0 by adding multiples of the modulus.
+        auto t = x;
+        bool carry = false;
+        for (size_t i = 0; i != S; ++i)
+        {
+            const auto m = t[i] * m_mod_inv;
+            uint64_t c = 0;
+#pragma GCC unroll 8
+            for (size_t j = 0; j != S; ++j)
+                std::tie(c, t[i + j]) = addmul(t[i + j], m, mod[j], c);
+            const auto s = intx::addc(t[i + S], c, carry);
+            t[i + S] = s.value;
+            carry = s.carry;
+        }
+
+        // The result is in the upper S words with the carry and is less than 2⋅mod.
+        UintT r;
+        for (size_t i = 0; i != S; ++i)
+            r[i] = t[S + i];
+
+        if (carry || r >= mod)
+            r -= mod;
+
+        return r;
+    }
+
     /// Performs a modular addition. It is required that x < mod and y < mod, but x and y may be
     /// but are not required to be in Montgomery form.
     constexpr UintT add(const UintT& x, const UintT& y) const noexcept
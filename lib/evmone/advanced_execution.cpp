@@ -22,7 +22,7 @@ evmc_result execute(AdvancedExecutionState& state, const AdvancedCodeAnalysis& a
     const auto gas_refund = (state.status == EVMC_SUCCESS) ? state.gas_refund : 0;
 
     assert(state.output_size != 0 || state.output_offset == 0);
-    return evmc::make_result(state.status, gas_left, gas_refund,
+    return state.output_buffer.make_result(state.status, gas_left, gas_refund,
         state.memory.data() + state.output_offset, state.output_size);
 }
 
@@ -0,0 +1,220 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "analysis_store.hpp"
+#include "eof.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef _WIN32
+#include <cstdlib>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace evmone::baseline
+{
+namespace
+{
+/// The header of the store image.
+struct Header
+{
+    /// The magic identifying the image file.
+    uint8_t magic[8];
+
+    /// The image format version.
+    uint32_t version;
+
+    /// The number of the index entries following the header.
+    uint32_t num_entries;
+};
+
+constexpr uint8_t MAGIC[8] = {'e', 'v', 'm', 'o', 'n', 'e', 'A', 'S'};
+
+/// The format version. It also includes the byte order: the image written on big-endian
+/// architecture has the version value swapped and is rejected by little-endian loader.
+constexpr uint32_t VERSION = 1;
+
+constexpr auto ALIGNMENT = alignof(BitsetSpan::word_type);
+
+static_assert(sizeof(Header) % ALIGNMENT == 0);
+static_assert(sizeof(AnalysisStore::IndexEntry) % ALIGNMENT == 0);
+static_assert(std::is_trivially_copyable_v<AnalysisStore::IndexEntry>);
+
+constexpr size_t align(size_t size) noexcept
+{
+    return (size + (ALIGNMENT - 1)) / ALIGNMENT * ALIGNMENT;
+}
+
+#ifdef _WIN32
+/// Loads the whole file to the heap memory. The memory mapping is not implemented for Windows.
+std::pair<std::shared_ptr<const void>, bytes_view> map_file(const char* path) noexcept
+{
+    const auto f = std::fopen(path, "rb");
+    if (f == nullptr)
+        return {};
+
+    std::shared_ptr<const void> image;
+    bytes_view data;
+    if (std::fseek(f, 0, SEEK_END) == 0)
+    {
+        if (const auto size = std::ftell(f); size > 0 && std::fseek(f, 0, SEEK_SET) == 0)
+        {
+            const auto buffer = static_cast<uint8_t*>(std::malloc(static_cast<size_t>(size)));
+            if (buffer != nullptr)
+            {
+                image.reset(buffer, std::free);
+                if (std::fread(buffer, 1, static_cast<size_t>(size), f) ==
+                    static_cast<size_t>(size))
+                    data = {buffer, static_cast<size_t>(size)};
+            }
+        }
+    }
+    std::fclose(f);
+    return {std::move(image), data};
+}
+#else
+/// The read-only memory mapping of a file.
+struct Mapping
+{
+    void* addr = nullptr;
+    size_t size = 0;
+
+    Mapping(void* a, size_t s) noexcept : addr{a}, size{s} {}
+    Mapping(const Mapping&) = delete;
+    Mapping& operator=(const Mapping&) = delete;
+    ~Mapping() noexcept { ::munmap(addr, size); }
+};
+
+/// Memory-maps the whole file.
+std::pair<std::shared_ptr<const void>, bytes_view> map_file(const char* path) noexcept
+{
+    const auto fd = ::open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0)
+        return {};
+
+    std::pair<std::shared_ptr<const void>, bytes_view> result;
+    struct stat st = {};
+    if (::fstat(fd, &st) == 0 && st.st_size > 0)
+    {
+        const auto size = static_cast<size_t>(st.st_size);
+        if (const auto addr = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+            addr != MAP_FAILED)
+        {
+            result.first = std::make_shared<const Mapping>(addr, size);
+            result.second = {static_cast<const uint8_t*>(addr), size};
+        }
+    }
+    ::close(fd);
+    return result;
+}
+#endif
+
+bool operator<(const AnalysisStore::IndexEntry& entry, const evmc::bytes32& code_hash) noexcept
+{
+    return entry.code_hash < code_hash;
+}
+}  // namespace
+
+AnalysisStore::AnalysisStore(std::shared_ptr<const void> image, bytes_view data) noexcept
+  : m_image{std::move(image)},
+    m_data{data},
+    m_index{reinterpret_cast<const IndexEntry*>(&data[sizeof(Header)]),
+        reinterpret_cast<const Header*>(data.data())->num_entries}
+{}
+
+std::shared_ptr<const AnalysisStore> AnalysisStore::load(const char* path) noexcept
+{
+    auto [image, data] = map_file(path);
+    if (data.size() < sizeof(Header))
+        return nullptr;
+
+    Header header;
+    std::memcpy(&header, data.data(), sizeof(header));
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION)
+        return nullptr;
+    if ((data.size() - sizeof(Header)) / sizeof(IndexEntry) < header.num_entries)
+        return nullptr;
+
+    return std::shared_ptr<const AnalysisStore>{new AnalysisStore{std::move(image), data}};
+}
+
+std::optional<CodeAnalysis> AnalysisStore::find(
+    const evmc::bytes32& code_hash, bytes_view code) const noexcept
+{
+    const auto it = std::lower_bound(m_index.begin(), m_index.end(), code_hash);
+    if (it == m_index.end() || it->code_hash != code_hash || it->code_size != code.size())
+        return std::nullopt;
+
+    // Check the entry bounds because the image may be corrupted.
+    const auto layout = get_legacy_analysis_layout(static_cast<size_t>(it->code_size));
+    if (it->offset % ALIGNMENT != 0 || it->offset > m_data.size() ||
+        m_data.size() - it->offset < layout.total_size())
+        return std::nullopt;
+
+    const auto storage = &m_data[static_cast<size_t>(it->offset)];
+    if (bytes_view{storage, code.size()} != code)
+        return std::nullopt;
+
+    // The bitset is read-only: BitsetSpan::set() is never used for the analysis.
+    const BitsetSpan jumpdest_bitset{reinterpret_cast<BitsetSpan::word_type*>(
+        const_cast<uint8_t*>(&storage[layout.bitset_offset]))};
+    return CodeAnalysis{storage, static_cast<size_t>(it->code_size), jumpdest_bitset, m_image};
+}
+
+bool write_analysis_store(
+    const char* path, std::span<const std::pair<evmc::bytes32, bytes_view>> codes) noexcept
+{
+    std::vector<std::pair<evmc::bytes32, bytes_view>> entries;
+    entries.reserve(codes.size());
+    for (const auto& entry : codes)
+    {
+        if (!is_eof_container(entry.second))
+            entries.emplace_back(entry);
+    }
+    std::ranges::sort(entries, {}, &std::pair<evmc::bytes32, bytes_view>::first);
+    const auto [dups_begin, dups_end] = std::ranges::unique(
+        entries, {}, &std::pair<evmc::bytes32, bytes_view>::first);
+    entries.erase(dups_begin, dups_end);
+
+    Header header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.num_entries = static_cast<uint32_t>(entries.size());
+
+    std::vector<AnalysisStore::IndexEntry> index;
+    index.reserve(entries.size());
+    auto offset = sizeof(Header) + entries.size() * sizeof(AnalysisStore::IndexEntry);
+    for (const auto& [code_hash, code] : entries)
+    {
+        index.push_back({code_hash, offset, code.size()});
+        offset += align(get_legacy_analysis_layout(code.size()).total_size());
+    }
+
+    const auto f = std::fopen(path, "wb");
+    if (f == nullptr)
+        return false;
+
+    bool ok = std::fwrite(&header, sizeof(header), 1, f) == 1 &&
+              std::fwrite(index.data(), sizeof(index[0]), index.size(), f) == index.size();
+
+    std::vector<uint8_t> storage;
+    for (const auto& [code_hash, code] : entries)
+    {
+        if (!ok)
+            break;
+        const auto layout = get_legacy_analysis_layout(code.size());
+        storage.assign(align(layout.total_size()), 0);
+        build_legacy_analysis(code, storage.data());
+        ok = std::fwrite(storage.data(), 1, storage.size(), f) == storage.size();
+    }
+
+    return std::fclose(f) == 0 && ok;
+}
+}  // namespace evmone::baseline
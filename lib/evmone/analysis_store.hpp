@@ -0,0 +1,71 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "baseline.hpp"
+#include <evmc/evmc.hpp>
+#include <memory>
+#include <optional>
+#include <span>
+#include <utility>
+
+namespace evmone::baseline
+{
+/// The persistent store of the legacy code analyses keyed by the code hash.
+///
+/// The store is a single file image with the header, the index sorted by the code hash
+/// and the analyses in the layout of the in-memory analysis (LegacyAnalysisLayout).
+/// The image is memory-mapped and the analyses are constructed as views into it (zero-copy).
+/// The image uses the native byte order and is not portable between architectures.
+///
+/// EOF code is not stored: its analysis is already zero-copy and only parses the header.
+class AnalysisStore
+{
+public:
+    /// The index entry of the store image.
+    struct IndexEntry
+    {
+        evmc::bytes32 code_hash;  ///< The code hash (the index key).
+        uint64_t offset = 0;      ///< The offset of the analysis in the image.
+        uint64_t code_size = 0;   ///< The code size.
+    };
+
+private:
+    /// The owner of the image memory.
+    std::shared_ptr<const void> m_image;
+
+    /// The image data.
+    bytes_view m_data;
+
+    /// The index of the analyses sorted by the code hash.
+    std::span<const IndexEntry> m_index;
+
+    AnalysisStore(std::shared_ptr<const void> image, bytes_view data) noexcept;
+
+public:
+    /// Loads (memory-maps) the store image from the file.
+    ///
+    /// @return  The store or nullptr if the file cannot be loaded or has invalid format.
+    EVMC_EXPORT static std::shared_ptr<const AnalysisStore> load(const char* path) noexcept;
+
+    /// The number of analyses in the store.
+    [[nodiscard]] size_t size() const noexcept { return m_index.size(); }
+
+    /// Finds the code analysis by the code hash.
+    ///
+    /// The stored code must be equal to the given code, otherwise the entry is rejected.
+    /// This protects from executing wrong code from a stale or corrupted image.
+    /// The returned analysis is a view into the store image which is kept alive by it.
+    [[nodiscard]] EVMC_EXPORT std::optional<CodeAnalysis> find(
+        const evmc::bytes32& code_hash, bytes_view code) const noexcept;
+};
+
+/// Analyzes the legacy codes and writes the AnalysisStore image to the file.
+///
+/// @param path   The path of the file to create.
+/// @param codes  The pairs of the code hash and the code. EOF codes and duplicates are skipped.
+/// @return       True if the file has been successfully written.
+EVMC_EXPORT bool write_analysis_store(
+    const char* path, std::span<const std::pair<evmc::bytes32, bytes_view>> codes) noexcept;
+}  // namespace evmone::baseline
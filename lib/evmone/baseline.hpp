@@ -7,6 +7,8 @@
 #include <evmc/evmc.h>
 #include <evmc/utils.h>
 #include <memory>
+#include <span>
+#include <vector>
 
 namespace evmone
 {
@@ -54,6 +56,31 @@ private:
 
 namespace baseline
 {
+class JitCode;
+
+/// The basic block of the legacy code for the block execution mode (see analyze_blocks()).
+struct BlockInfo
+{
+    /// The offset of the first instruction of the block.
+    uint32_t begin = 0;
+
+    /// The offset of the last instruction of the block.
+    uint32_t last = 0;
+
+    /// The offset of the instruction following the block in the code order.
+    uint32_t end = 0;
+
+    /// The total base gas cost of all instructions in the block.
+    uint32_t gas_cost = 0;
+
+    /// The stack height required to execute the block.
+    int16_t stack_req = 0;
+
+    /// The maximum stack height growth relative to the stack height at block start.
+    int16_t stack_max_growth = 0;
+};
+static_assert(sizeof(BlockInfo) == 20);
+
 class CodeAnalysis
 {
 private:
@@ -67,6 +94,20 @@ private:
 
     BitsetSpan m_jumpdest_bitset{nullptr};
 
+    /// The owner of the external storage of the padded code and the JUMPDEST bitset
+    /// (e.g. a memory-mapped AnalysisStore image). If not nullptr the m_padded_code is nullptr.
+    std::shared_ptr<const void> m_storage_owner;
+
+    /// The padded legacy code with superinstructions (see fuse_instructions()).
+    /// If not nullptr the executable_code must point to it.
+    std::unique_ptr<uint8_t[]> m_fused_code;
+
+    /// The basic blocks of the legacy code (see analyze_blocks()).
+    std::vector<BlockInfo> m_blocks;
+
+    /// The JIT compiled legacy code (see compile_jit()).
+    std::shared_ptr<const JitCode> m_jit_code;
+
 public:
     /// Constructor for legacy code.
     CodeAnalysis(std::unique_ptr<uint8_t[]> padded_code, size_t code_size, BitsetSpan map)
@@ -76,6 +117,16 @@ public:
         m_jumpdest_bitset{map}
     {}
 
+    /// Constructor for legacy code with the padded code and the JUMPDEST bitset
+    /// in the external storage which is kept alive by the storage_owner.
+    CodeAnalysis(const uint8_t* padded_code, size_t code_size, BitsetSpan map,
+        std::shared_ptr<const void> storage_owner)
+      : m_raw_code{padded_code, code_size},
+        m_executable_code{padded_code, code_size},
+        m_jumpdest_bitset{map},
+        m_storage_owner{std::move(storage_owner)}
+    {}
+
     /// Constructor for EOF.
     CodeAnalysis(bytes_view container, bytes_view executable_code, EOF1Header header)
       : m_raw_code{container}, m_executable_code(executable_code), m_eof_header{std::move(header)}
@@ -87,6 +138,39 @@ public:
     /// The pre-processed executable code. This is where interpreter should start execution.
     [[nodiscard]] bytes_view executable_code() const noexcept { return m_executable_code; }
 
+    /// The executable code without superinstructions. This is the same as the executable_code()
+    /// unless the code has been fused. The code offsets are the same in both variants.
+    [[nodiscard]] bytes_view unfused_code() const noexcept
+    {
+        return m_fused_code ? m_raw_code : m_executable_code;
+    }
+
+    /// Checks if the executable code contains superinstructions.
+    [[nodiscard]] bool is_fused() const noexcept { return m_fused_code != nullptr; }
+
+    /// Replaces the executable code with the fused variant of the legacy code.
+    void set_fused_code(std::unique_ptr<uint8_t[]> fused_code) noexcept
+    {
+        m_executable_code = {fused_code.get(), m_raw_code.size()};
+        m_fused_code = std::move(fused_code);
+    }
+
+    /// The basic blocks of the legacy code terminated with the sentinel block
+    /// (with the begin offset beyond the code). Empty if the blocks have not been analyzed.
+    [[nodiscard]] std::span<const BlockInfo> blocks() const noexcept { return m_blocks; }
+
+    /// Sets the basic blocks of the legacy code.
+    void set_blocks(std::vector<BlockInfo> blocks) noexcept { m_blocks = std::move(blocks); }
+
+    /// The JIT compiled legacy code or nullptr if the code has not been compiled.
+    [[nodiscard]] const JitCode* jit_code() const noexcept { return m_jit_code.get(); }
+
+    /// Sets the JIT compiled legacy code.
+    void set_jit_code(std::shared_ptr<const JitCode> jit_code) noexcept
+    {
+        m_jit_code = std::move(jit_code);
+    }
+
     /// Reference to the EOF header.
     [[nodiscard]] const EOF1Header& eof_header() const noexcept { return m_eof_header; }
 
@@ -102,6 +186,33 @@ public:
     }
 };
 
+/// The storage layout of the legacy code analysis.
+///
+/// The storage is a single buffer with the code padded with zeros followed by
+/// the JUMPDEST bitset aligned to the bitset word size.
+struct LegacyAnalysisLayout
+{
+    size_t bitset_offset = 0;  ///< The offset of the bitset, i.e. the aligned padded code size.
+    size_t bitset_words = 0;   ///< The number of the bitset words.
+
+    /// Returns the total size of the storage.
+    [[nodiscard]] size_t total_size() const noexcept
+    {
+        return bitset_offset + bitset_words * sizeof(BitsetSpan::word_type);
+    }
+};
+
+/// Computes the storage layout of the legacy code analysis for the given code size.
+LegacyAnalysisLayout get_legacy_analysis_layout(size_t code_size) noexcept;
+
+/// Builds the legacy code analysis in the given storage.
+///
+/// @param code     The legacy EVM code.
+/// @param storage  The storage of the get_legacy_analysis_layout(code.size()).total_size() bytes
+///                 aligned to the bitset word. It will contain the padded code and the bitset.
+/// @return         The JUMPDEST bitset placed in the storage.
+BitsetSpan build_legacy_analysis(bytes_view code, uint8_t* storage) noexcept;
+
 /// Analyze the EVM code in preparation for execution.
 ///
 /// For legacy code this builds the map of valid JUMPDESTs.
@@ -111,6 +222,29 @@ public:
 /// @param eof_enabled  Should the EOF code prefix be recognized as EOF code?
 EVMC_EXPORT CodeAnalysis analyze(bytes_view code, bool eof_enabled);
 
+/// Fuses common instruction sequences of the legacy code into superinstructions.
+///
+/// The executable code of the analysis is replaced with the copy where each fused sequence
+/// starts with a pseudo-opcode executing the whole sequence with a single requirements check.
+/// The original code is still available as the raw_code(). EOF code is not modified.
+EVMC_EXPORT void fuse_instructions(CodeAnalysis& analysis);
+
+/// Analyzes the basic blocks of the legacy code for the block execution mode.
+///
+/// The block requirements (the total base gas cost and the stack height bounds) are checked once
+/// at the block entry, the instructions of the block are executed without individual checks.
+/// Blocks contain only instructions with constant base gas cost. A block ends at JUMPDEST, after
+/// a jump and after an instruction using the gas left value (so the value is exact).
+/// EOF code and code with superinstructions are not analyzed.
+EVMC_EXPORT void analyze_blocks(CodeAnalysis& analysis);
+
+/// Compiles the legacy code to machine code with the template JIT (see JitCode).
+///
+/// The analysis is not modified if the JIT is not supported by the platform. EOF code is not
+/// compiled. The compiled code is executed instead of interpreting the code unless tracing
+/// is enabled.
+EVMC_EXPORT void compile_jit(CodeAnalysis& analysis);
+
 /// Executes in Baseline interpreter using EVMC-compatible parameters.
 evmc_result execute(evmc_vm* vm, const evmc_host_interface* host, evmc_host_context* ctx,
     evmc_revision rev, const evmc_message* msg, const uint8_t* code, size_t code_size) noexcept;
@@ -35,28 +35,9 @@ void analyze_jumpdests(BitsetSpan map, bytes_view code) noexcept
 
 CodeAnalysis analyze_legacy(bytes_view code)
 {
-    // We need at most 33 bytes of code padding: 32 for possible missing all data bytes of
-    // the PUSH32 at the code end; and one more byte for STOP to guarantee there is a terminating
-    // instruction at the code end.
-    static constexpr auto PADDING = 32 + 1;
-
-    static constexpr auto BITSET_ALIGNMENT = alignof(BitsetSpan::word_type);
-
-    const auto padded_code_size = code.size() + PADDING;
-    const auto aligned_code_size =
-        (padded_code_size + (BITSET_ALIGNMENT - 1)) / BITSET_ALIGNMENT * BITSET_ALIGNMENT;
-    const auto bitset_words = (code.size() + (BitsetSpan::WORD_BITS)) / BitsetSpan::WORD_BITS;
-    const auto total_size = aligned_code_size + bitset_words * sizeof(BitsetSpan::word_type);
-
-    auto storage = std::make_unique_for_overwrite<uint8_t[]>(total_size);
-    std::ranges::copy(code, storage.get());                           // Copy code.
-    std::fill_n(&storage[code.size()], total_size - code.size(), 0);  // Pad code and init bitset.
-
-    const auto bitset_storage =
-        new (&storage[aligned_code_size]) BitsetSpan::word_type[bitset_words];
-    const BitsetSpan jumpdest_bitset{bitset_storage};
-    analyze_jumpdests(jumpdest_bitset, code);
-
+    const auto layout = get_legacy_analysis_layout(code.size());
+    auto storage = std::make_unique_for_overwrite<uint8_t[]>(layout.total_size());
+    const auto jumpdest_bitset = build_legacy_analysis(code, storage.get());
     return {std::move(storage), code.size(), jumpdest_bitset};
 }
 
@@ -76,6 +57,36 @@ CodeAnalysis analyze_eof1(bytes_view container)
 }
 }  // namespace
 
+LegacyAnalysisLayout get_legacy_analysis_layout(size_t code_size) noexcept
+{
+    // We need at most 33 bytes of code padding: 32 for possible missing all data bytes of
+    // the PUSH32 at the code end; and one more byte for STOP to guarantee there is a terminating
+    // instruction at the code end.
+    static constexpr auto PADDING = 32 + 1;
+
+    static constexpr auto BITSET_ALIGNMENT = alignof(BitsetSpan::word_type);
+
+    const auto padded_code_size = code_size + PADDING;
+    const auto aligned_code_size =
+        (padded_code_size + (BITSET_ALIGNMENT - 1)) / BITSET_ALIGNMENT * BITSET_ALIGNMENT;
+    const auto bitset_words = (code_size + (BitsetSpan::WORD_BITS)) / BitsetSpan::WORD_BITS;
+    return {aligned_code_size, bitset_words};
+}
+
+BitsetSpan build_legacy_analysis(bytes_view code, uint8_t* storage) noexcept
+{
+    const auto layout = get_legacy_analysis_layout(code.size());
+    const auto total_size = layout.total_size();
+    std::ranges::copy(code, storage);                                 // Copy code.
+    std::fill_n(&storage[code.size()], total_size - code.size(), 0);  // Pad code and init bitset.
+
+    const auto bitset_storage =
+        new (&storage[layout.bitset_offset]) BitsetSpan::word_type[layout.bitset_words];
+    const BitsetSpan jumpdest_bitset{bitset_storage};
+    analyze_jumpdests(jumpdest_bitset, code);
+    return jumpdest_bitset;
+}
+
 CodeAnalysis analyze(bytes_view code, bool eof_enabled)
 {
     if (eof_enabled && is_eof_container(code))
@@ -0,0 +1,98 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "baseline_blocks.hpp"
+#include "baseline.hpp"
+#include <algorithm>
+#include <limits>
+#include <optional>
+#include <vector>
+
+namespace evmone::baseline
+{
+namespace
+{
+/// The basic block being analyzed.
+struct BlockAnalysis
+{
+    uint32_t begin = 0;
+    uint32_t last = 0;
+    int64_t gas_cost = 0;
+    int stack_req = 0;
+    int stack_max_growth = 0;
+    int stack_change = 0;
+
+    explicit BlockAnalysis(uint32_t offset) noexcept : begin{offset}, last{offset} {}
+
+    /// Close the block ending at the given offset.
+    [[nodiscard]] BlockInfo close(uint32_t end) const noexcept
+    {
+        // The values exceeding the BlockInfo limits make the block requirements unsatisfiable:
+        // the block is then always executed with the individual instruction checks.
+        static constexpr auto gas_max = std::numeric_limits<decltype(BlockInfo{}.gas_cost)>::max();
+        static constexpr auto stack_max =
+            std::numeric_limits<decltype(BlockInfo{}.stack_req)>::max();
+        if (gas_cost > gas_max || stack_req > stack_max || stack_max_growth > stack_max)
+            return {begin, last, end, 0, stack_max, 0};
+
+        return {begin, last, end, static_cast<uint32_t>(gas_cost), static_cast<int16_t>(stack_req),
+            static_cast<int16_t>(stack_max_growth)};
+    }
+};
+}  // namespace
+
+void analyze_blocks(CodeAnalysis& analysis)
+{
+    if (analysis.eof_header().version != 0 || analysis.is_fused() || !analysis.blocks().empty())
+        return;
+
+    const auto code = analysis.raw_code();
+    std::vector<BlockInfo> blocks;
+    std::optional<BlockAnalysis> block;
+
+    size_t i = 0;
+    while (i < code.size())
+    {
+        const auto op = code[i];
+        const auto offset = static_cast<uint32_t>(i);
+        const auto role = block_roles[op];
+        i += instr::legacy_instruction_size(op);
+
+        // The jump destination always starts a new block.
+        if (block.has_value() && (role == BlockRole::none || op == OP_JUMPDEST))
+        {
+            blocks.emplace_back(block->close(offset));
+            block.reset();
+        }
+
+        if (role == BlockRole::none)
+            continue;
+
+        if (!block.has_value())
+            block.emplace(offset);
+
+        const auto& tr = instr::traits[op];
+        block->last = offset;
+        block->gas_cost += instr::gas_costs[EVMC_FRONTIER][op];
+        block->stack_req =
+            std::max(block->stack_req, tr.stack_height_required - block->stack_change);
+        block->stack_change += tr.stack_height_change;
+        block->stack_max_growth = std::max(block->stack_max_growth, block->stack_change);
+
+        if (role == BlockRole::terminator)
+        {
+            blocks.emplace_back(block->close(static_cast<uint32_t>(i)));
+            block.reset();
+        }
+    }
+    if (block.has_value())
+        blocks.emplace_back(block->close(static_cast<uint32_t>(i)));
+
+    // The sentinel block which is never reached.
+    static constexpr auto sentinel_offset = std::numeric_limits<uint32_t>::max();
+    blocks.push_back({sentinel_offset, sentinel_offset, sentinel_offset, 0, 0, 0});
+
+    analysis.set_blocks(std::move(blocks));
+}
+}  // namespace evmone::baseline
@@ -0,0 +1,61 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "instructions.hpp"
+#include <array>
+#include <type_traits>
+
+namespace evmone::baseline
+{
+/// The role of the instruction in the basic blocks of the block execution mode.
+enum class BlockRole : uint8_t
+{
+    /// Not included in blocks: executed with the individual requirements check.
+    /// These are instructions with the base gas cost depending on the EVM revision
+    /// and the instructions undefined in some revisions.
+    none,
+
+    /// Can be placed anywhere in a block.
+    inner,
+
+    /// Ends the block: changes the control flow or uses the gas left value.
+    terminator,
+};
+
+/// Checks if the instruction implementation takes the gas left value.
+template <typename R, typename... Args>
+constexpr bool uses_gas_left(R (*)(Args...) noexcept) noexcept
+{
+    return (std::is_same_v<Args, int64_t> || ...);
+}
+
+/// The table of the instruction roles in the basic blocks.
+constexpr inline auto block_roles = []() noexcept {
+    std::array<BlockRole, 256> table{};
+#define ON_OPCODE(OPCODE)                                                          \
+    if constexpr (instr::has_const_gas_cost(OPCODE) &&                             \
+                  instr::gas_costs[EVMC_FRONTIER][OPCODE] != instr::undefined &&   \
+                  instr::traits[OPCODE].since == EVMC_FRONTIER)                    \
+    {                                                                              \
+        table[OPCODE] = (OPCODE == OP_JUMP || OPCODE == OP_JUMPI ||                \
+                            uses_gas_left(instr::core::impl<OPCODE>)) ?            \
+                            BlockRole::terminator :                                \
+                            BlockRole::inner;                                      \
+    }
+    MAP_OPCODES
+#undef ON_OPCODE
+    return table;
+}();
+
+static_assert(block_roles[OP_ADD] == BlockRole::inner);
+static_assert(block_roles[OP_PUSH1] == BlockRole::inner);
+static_assert(block_roles[OP_JUMPDEST] == BlockRole::inner);
+static_assert(block_roles[OP_JUMPI] == BlockRole::terminator);
+static_assert(block_roles[OP_GAS] == BlockRole::terminator);
+static_assert(block_roles[OP_MSTORE] == BlockRole::terminator);
+static_assert(block_roles[OP_STOP] == BlockRole::terminator);
+static_assert(block_roles[OP_SLOAD] == BlockRole::none);
+static_assert(block_roles[OP_PUSH0] == BlockRole::none);
+}  // namespace evmone::baseline
@@ -3,11 +3,17 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "baseline.hpp"
+#include "baseline_blocks.hpp"
+#include "baseline_fusion.hpp"
 #include "baseline_instruction_table.hpp"
+#include "baseline_jit.hpp"
 #include "eof.hpp"
 #include "execution_state.hpp"
 #include "instructions.hpp"
 #include "vm.hpp"
+#include <evmone_precompiles/keccak.hpp>
+#include <algorithm>
+#include <bit>
 #include <memory>
 
 #ifdef NDEBUG
@@ -185,6 +191,63 @@ template <Opcode Op>
     return {new_pos, new_stack_top};
 }
 
+/// A helper to invoke the superinstruction fusing the instruction sequence Ops.
+///
+/// If the precomputed requirements of the whole sequence are fulfilled, the instructions
+/// are executed without individual checks. Otherwise, the instructions are executed one by one
+/// with the regular checks to fail exactly as the unfused code.
+template <Opcode... Ops>
+[[release_inline]] inline Position invoke_fused(const CostTable& cost_table,
+    const uint256* stack_bottom, Position pos, int64_t& gas, ExecutionState& state) noexcept
+{
+    using Traits = FusedTraits<Ops...>;
+    const auto stack_height = pos.stack_end - stack_bottom;
+    if (stack_height >= Traits::stack_required &&
+        stack_height <= StackSpace::limit - Traits::stack_max_growth && gas >= Traits::gas_cost)
+        [[likely]]
+    {
+        gas -= Traits::gas_cost;
+        ((pos = {invoke(instr::core::impl<Ops>, pos, gas, state),
+              pos.stack_end + instr::traits[Ops].stack_height_change},
+             pos.code_it != nullptr) &&
+            ...);
+        return pos;
+    }
+
+    ((pos = invoke<Ops>(cost_table, stack_bottom, pos, gas, state), pos.code_it != nullptr) &&
+        ...);
+    return pos;
+}
+
+/// Executes the single instruction at the given position.
+///
+/// @tparam Checked  If false, the instruction is executed without the requirements check.
+///                  This is only allowed for instructions of the basic block
+///                  which requirements have been already checked (see analyze_blocks()).
+template <bool Checked>
+[[release_inline]] inline Position execute_instruction(const CostTable& cost_table,
+    const uint256* stack_bottom, Position pos, int64_t& gas, ExecutionState& state) noexcept
+{
+    switch (*pos.code_it)
+    {
+#define ON_OPCODE(OPCODE)                                                                   \
+    case OPCODE:                                                                            \
+        ASM_COMMENT(OPCODE);                                                                \
+        if constexpr (Checked || block_roles[OPCODE] == BlockRole::none)                    \
+            return invoke<OPCODE>(cost_table, stack_bottom, pos, gas, state);               \
+        else                                                                                \
+            return {invoke(instr::core::impl<OPCODE>, pos, gas, state),                     \
+                pos.stack_end + instr::traits[OPCODE].stack_height_change};
+
+        MAP_OPCODES
+#undef ON_OPCODE
+
+    default:
+        state.status = EVMC_UNDEFINED_INSTRUCTION;
+        return {nullptr, pos.stack_end};
+    }
+}
+
 
 template <bool TracingEnabled>
 int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas,
@@ -192,6 +255,11 @@ int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas
 {
     const auto stack_bottom = state.stack_space.bottom();
 
+    // With tracing enabled, the instructions are dispatched by the unfused code so that all
+    // instructions are reported individually. The code offsets are the same in both variants.
+    const auto unfused_code =
+        TracingEnabled ? state.analysis.baseline->unfused_code().data() : code;
+
     // Code iterator and stack top pointer for interpreter loop.
     Position position{code, stack_bottom};
 
@@ -208,7 +276,7 @@ int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas
             }
         }
 
-        const auto op = *position.code_it;
+        const auto op = TracingEnabled ? unfused_code[position.code_it - code] : *position.code_it;
         switch (op)
         {
 #define ON_OPCODE(OPCODE)                                                                     \
@@ -230,6 +298,24 @@ int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas
             MAP_OPCODES
 #undef ON_OPCODE
 
+#define ON_FUSED_OPCODE(FUSED_OPCODE, ...)                                                      \
+    case FUSED_OPCODE:                                                                          \
+        ASM_COMMENT(FUSED_OPCODE);                                                              \
+        if (const auto next =                                                                   \
+                invoke_fused<__VA_ARGS__>(cost_table, stack_bottom, position, gas, state);      \
+            next.code_it == nullptr)                                                            \
+        {                                                                                       \
+            return gas;                                                                         \
+        }                                                                                       \
+        else                                                                                    \
+        {                                                                                       \
+            position = next;                                                                    \
+        }                                                                                       \
+        break;
+
+            MAP_FUSED_OPCODES
+#undef ON_FUSED_OPCODE
+
         default:
             state.status = EVMC_UNDEFINED_INSTRUCTION;
             return gas;
@@ -238,16 +324,155 @@ int64_t dispatch(const CostTable& cost_table, ExecutionState& state, int64_t gas
     intx::unreachable();
 }
 
+/// The interpreter loop of the block execution mode (see analyze_blocks()).
+///
+/// The requirements of a basic block are checked once at the block entry. If the check fails,
+/// the block is executed with the individual instruction checks to fail at the exact instruction
+/// with the same status code as in the other modes.
+int64_t dispatch_blocks(const CostTable& cost_table, ExecutionState& state, int64_t gas,
+    const uint8_t* code, std::span<const BlockInfo> blocks) noexcept
+{
+    const auto stack_bottom = state.stack_space.bottom();
+
+    // Code iterator and stack top pointer for interpreter loop.
+    Position position{code, stack_bottom};
+
+    // The next block in the code order. The sentinel block guarantees one always exists.
+    auto block = blocks.begin();
+
+    while (true)  // Guaranteed to terminate because padded code ends with STOP.
+    {
+        if (static_cast<uint32_t>(position.code_it - code) != block->begin)
+        {
+            // The instruction outside of blocks. It never jumps.
+            position = execute_instruction<true>(cost_table, stack_bottom, position, gas, state);
+            if (position.code_it == nullptr)
+                return gas;
+            continue;
+        }
+
+        // Only the last instruction of the block can jump or fail.
+        const auto last = code + block->last;
+        const auto stack_height = position.stack_end - stack_bottom;
+        if (stack_height >= block->stack_req &&
+            stack_height <= StackSpace::limit - block->stack_max_growth &&
+            gas >= block->gas_cost) [[likely]]
+        {
+            gas -= block->gas_cost;
+            while (position.code_it != last)
+            {
+                position =
+                    execute_instruction<false>(cost_table, stack_bottom, position, gas, state);
+            }
+            position = execute_instruction<false>(cost_table, stack_bottom, position, gas, state);
+        }
+        else
+        {
+            while (position.code_it != last)
+            {
+                position =
+                    execute_instruction<true>(cost_table, stack_bottom, position, gas, state);
+                if (position.code_it == nullptr)
+                    return gas;
+            }
+            position = execute_instruction<true>(cost_table, stack_bottom, position, gas, state);
+        }
+        if (position.code_it == nullptr)
+            return gas;
+
+        if (const auto offset = static_cast<uint32_t>(position.code_it - code);
+            offset == block->end) [[likely]]
+            ++block;
+        else
+            block = std::ranges::lower_bound(blocks, offset, {}, &BlockInfo::begin);
+    }
+    intx::unreachable();
+}
+
+}  // namespace
+
+/// The execution context of the JIT compiled code.
+struct JitContext
+{
+    const CostTable& cost_table;
+    const uint256* const stack_bottom;
+    const uint8_t* const code;
+    const JitCode& jit_code;
+    ExecutionState& state;
+    Position position;
+    int64_t gas;
+};
+
+namespace
+{
+/// The JIT helper executing the instruction Op at the current position (see JitCode).
+template <Opcode Op>
+const uint8_t* jit_execute(JitContext& ctx) noexcept
+{
+    const auto next =
+        invoke<Op>(ctx.cost_table, ctx.stack_bottom, ctx.position, ctx.gas, ctx.state);
+    if (next.code_it == nullptr)
+        return ctx.jit_code.exit();
+
+    const auto jumped =
+        (Op == OP_JUMP || Op == OP_JUMPI) && next.code_it != ctx.position.code_it + 1;
+    ctx.position = next;
+    if (jumped)  // The destination has been validated by the instruction.
+        return ctx.jit_code.find_jumpdest(static_cast<size_t>(next.code_it - ctx.code));
+    return nullptr;
+}
+
+/// The JIT helper of undefined instructions.
+const uint8_t* jit_undefined(JitContext& ctx) noexcept
+{
+    ctx.state.status = EVMC_UNDEFINED_INSTRUCTION;
+    return ctx.jit_code.exit();
+}
+
+/// The table of the JIT helpers.
+constexpr auto jit_helpers = []() noexcept {
+    std::array<JitHelper, 256> table{};
+    table.fill(jit_undefined);
+#define ON_OPCODE(OPCODE) table[OPCODE] = jit_execute<OPCODE>;
+    MAP_OPCODES
+#undef ON_OPCODE
+    return table;
+}();
+
+/// Executes the JIT compiled code.
+int64_t dispatch_jit(const CostTable& cost_table, ExecutionState& state, int64_t gas,
+    const uint8_t* code, const JitCode& jit_code) noexcept
+{
+    const auto stack_bottom = state.stack_space.bottom();
+    JitContext ctx{cost_table, stack_bottom, code, jit_code, state, {code, stack_bottom}, gas};
+    jit_code.run(ctx);
+    return ctx.gas;
+}
+
 #if EVMONE_CGOTO_SUPPORTED
+/// Returns the index of the superinstruction in the fused cgoto table.
+constexpr size_t fused_index(uint8_t op) noexcept
+{
+    return is_fused(op) ? size_t{op} - FUSED_FIRST : 0;
+}
+
 int64_t dispatch_cgoto(
     const CostTable& cost_table, ExecutionState& state, int64_t gas, const uint8_t* code) noexcept
 {
 #pragma GCC diagnostic ignored "-Wpedantic"
 
+    static constexpr void* fused_cgoto_table[] = {
+#define ON_FUSED_OPCODE(FUSED_OPCODE, ...) &&TARGET_##FUSED_OPCODE,
+        MAP_FUSED_OPCODES
+#undef ON_FUSED_OPCODE
+    };
+
+    // The superinstruction pseudo-opcodes occupy some of the undefined opcodes slots.
     static constexpr void* cgoto_table[] = {
 #define ON_OPCODE(OPCODE) &&TARGET_##OPCODE,
 #undef ON_OPCODE_UNDEFINED
-#define ON_OPCODE_UNDEFINED(_) &&TARGET_OP_UNDEFINED,
+#define ON_OPCODE_UNDEFINED(OPCODE) \
+    (is_fused(OPCODE) ? fused_cgoto_table[fused_index(OPCODE)] : &&TARGET_OP_UNDEFINED),
         MAP_OPCODES
 #undef ON_OPCODE
 #undef ON_OPCODE_UNDEFINED
@@ -280,13 +505,97 @@ int64_t dispatch_cgoto(
     MAP_OPCODES
 #undef ON_OPCODE
 
+#define ON_FUSED_OPCODE(FUSED_OPCODE, ...)                                                  \
+    TARGET_##FUSED_OPCODE : ASM_COMMENT(FUSED_OPCODE);                                      \
+    if (const auto next =                                                                   \
+            invoke_fused<__VA_ARGS__>(cost_table, stack_bottom, position, gas, state);      \
+        next.code_it == nullptr)                                                            \
+    {                                                                                       \
+        return gas;                                                                         \
+    }                                                                                       \
+    else                                                                                    \
+    {                                                                                       \
+        position = next;                                                                    \
+    }                                                                                       \
+    goto* cgoto_table[*position.code_it];
+
+    MAP_FUSED_OPCODES
+#undef ON_FUSED_OPCODE
+
 TARGET_OP_UNDEFINED:
     state.status = EVMC_UNDEFINED_INSTRUCTION;
     return gas;
 }
 #endif
+
+/// Validates the EOF container using the VM's code cache if available.
+EOFValidationError validate_eof(
+    VM& vm, evmc_revision rev, ContainerKind kind, bytes_view container) noexcept
+{
+    auto* const code_cache = vm.get_code_cache();
+    if (code_cache == nullptr)
+        return evmone::validate_eof(rev, kind, container);
+
+    const auto container_hash =
+        std::bit_cast<evmc::bytes32>(ethash::keccak256(container.data(), container.size()));
+    if (const auto cached = code_cache->eof_validations.get(container_hash);
+        cached.has_value() && cached->rev == rev && cached->kind == kind)
+        return cached->error;
+
+    const auto error = evmone::validate_eof(rev, kind, container);
+    code_cache->eof_validations.put(container_hash, {rev, kind, error});
+    return error;
+}
+
+/// Applies the legacy code transformations enabled in the VM to the code analysis.
+/// The JIT takes precedence over the block execution mode and the superinstructions.
+/// The compilation (including the executable memory mapping) costs more than it saves
+/// in a single short execution, so only the cached analyses (the cached flag) and the code
+/// of at least VM::jit_min_code_size are compiled.
+void prepare_legacy_analysis(const VM& vm, CodeAnalysis& analysis, bool cached)
+{
+    if (vm.jit && (cached || analysis.raw_code().size() >= vm.jit_min_code_size))
+        compile_jit(analysis);
+    else if (vm.block_check)
+        analyze_blocks(analysis);
+    else if (vm.fusion)
+        fuse_instructions(analysis);
+}
+
+/// Gets the legacy code analysis from the VM's code cache or analysis store.
+/// If not found, analyzes the code. The result is put in the code cache.
+std::shared_ptr<const CodeAnalysis> get_legacy_analysis(
+    VM& vm, const evmc::bytes32& code_hash, bytes_view code)
+{
+    auto* const code_cache = vm.get_code_cache();
+    if (code_cache != nullptr)
+    {
+        if (auto cached = code_cache->baseline_analyses.get(code_hash);
+            cached.has_value() && (*cached)->raw_code().size() == code.size())
+            return std::move(*cached);
+    }
+
+    std::optional<CodeAnalysis> analysis;
+    if (const auto* const store = vm.get_analysis_store(); store != nullptr)
+        analysis = store->find(code_hash, code);
+    if (!analysis.has_value())
+        analysis = analyze(code, false);  // The code is known not to be EOF.
+    prepare_legacy_analysis(vm, *analysis, code_cache != nullptr);
+
+    auto shared_analysis = std::make_shared<const CodeAnalysis>(std::move(*analysis));
+    if (code_cache != nullptr)
+        code_cache->baseline_analyses.put(code_hash, shared_analysis);
+    return shared_analysis;
+}
 }  // namespace
 
+void compile_jit(CodeAnalysis& analysis)
+{
+    if (analysis.eof_header().version != 0 || analysis.jit_code() != nullptr)
+        return;
+    analysis.set_jit_code(JitCode::compile(analysis.unfused_code(), jit_helpers));
+}
+
 evmc_result execute(VM& vm, const evmc_host_interface& host, evmc_host_context* ctx,
     evmc_revision rev, const evmc_message& msg, const CodeAnalysis& analysis) noexcept
 {
@@ -304,9 +613,17 @@ evmc_result execute(VM& vm, const evmc_host_interface& host, evmc_host_context*
     auto* tracer = vm.get_tracer();
     if (INTX_UNLIKELY(tracer != nullptr))
     {
-        tracer->notify_execution_start(state.rev, *state.msg, code);
+        tracer->notify_execution_start(state.rev, *state.msg, analysis.unfused_code());
         gas = dispatch<true>(cost_table, state, gas, code_begin, tracer);
     }
+    else if (const auto* const jit_code = analysis.jit_code(); jit_code != nullptr)
+    {
+        gas = dispatch_jit(cost_table, state, gas, code_begin, *jit_code);
+    }
+    else if (const auto blocks = analysis.blocks(); !blocks.empty())
+    {
+        gas = dispatch_blocks(cost_table, state, gas, code_begin, blocks);
+    }
     else
     {
 #if EVMONE_CGOTO_SUPPORTED
@@ -321,11 +638,13 @@ evmc_result execute(VM& vm, const evmc_host_interface& host, evmc_host_context*
     const auto gas_refund = (state.status == EVMC_SUCCESS) ? state.gas_refund : 0;
 
     assert(state.output_size != 0 || state.output_offset == 0);
+    // The output is copied to the reused output buffer. The buffer is passed with the result
+    // and taken over by the caller without copying (see ExecutionState::set_return_data()).
     const auto result =
         (state.deploy_container.has_value() ?
-                evmc::make_result(state.status, gas_left, gas_refund,
+                state.output_buffer.make_result(state.status, gas_left, gas_refund,
                     state.deploy_container->data(), state.deploy_container->size()) :
-                evmc::make_result(state.status, gas_left, gas_refund,
+                state.output_buffer.make_result(state.status, gas_left, gas_refund,
                     state.output_size != 0 ? &state.memory[state.output_offset] : nullptr,
                     state.output_size));
 
@@ -349,11 +668,40 @@ evmc_result execute(evmc_vm* c_vm, const evmc_host_interface* host, evmc_host_co
     {
         const auto container_kind =
             (msg->kind == EVMC_EOFCREATE ? ContainerKind::initcode : ContainerKind::runtime);
-        if (validate_eof(rev, container_kind, container) != EOFValidationError::success)
+        if (validate_eof(*vm, rev, container_kind, container) != EOFValidationError::success)
             return evmc_make_result(EVMC_CONTRACT_VALIDATION_FAILURE, 0, 0, nullptr, 0);
     }
 
-    const auto code_analysis = analyze(container, eof_enabled);
+    // The legacy code analysis owns the padded copy of the code (or references the persistent
+    // analysis store), so it can be cached and reused by later executions of the same code.
+    // The cache, the store and the tiering are keyed by the code hash provided by the Host,
+    // which is only defined for code of existing accounts (not initcode).
+    // EOF code is not cached because the Host reports the same sentinel hash for all EOF code.
+    auto* const tiering = vm->get_tracer() == nullptr ? vm->get_tiering() : nullptr;
+    if ((vm->get_code_cache() != nullptr || vm->get_analysis_store() != nullptr ||
+            tiering != nullptr) &&
+        (msg->kind == EVMC_CALL || msg->kind == EVMC_DELEGATECALL ||
+            msg->kind == EVMC_CALLCODE) &&
+        !is_eof_container(container))
+    {
+        const evmc::bytes32 code_hash = host->get_code_hash(ctx, &msg->code_address);
+        if (code_hash != evmc::bytes32{})
+        {
+            // The hot code is executed in the Advanced interpreter (it doesn't support tracing).
+            if (tiering != nullptr)
+            {
+                if (const auto promoted = tiering->record_execution(code_hash, rev, container))
+                    return tiering->execute(*host, ctx, rev, *msg, container, *promoted);
+            }
+
+            // Keep the shared ownership for the whole execution: nested calls may evict the entry.
+            const auto code_analysis = get_legacy_analysis(*vm, code_hash, container);
+            return execute(*vm, *host, ctx, rev, *msg, *code_analysis);
+        }
+    }
+
+    auto code_analysis = analyze(container, eof_enabled);
+    prepare_legacy_analysis(*vm, code_analysis, false);
     return execute(*vm, *host, ctx, rev, *msg, code_analysis);
 }
 }  // namespace evmone::baseline
@@ -0,0 +1,85 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "baseline_fusion.hpp"
+#include "baseline.hpp"
+#include <memory>
+#include <span>
+
+namespace evmone::baseline
+{
+namespace
+{
+/// The superinstruction pattern: the pseudo-opcode and the fused instructions.
+struct Pattern
+{
+    uint8_t fused_opcode;
+    std::span<const Opcode> ops;
+};
+
+constexpr Pattern patterns[] = {
+#define ON_FUSED_OPCODE(FUSED_OPCODE, ...) {FUSED_OPCODE, FusedTraits<__VA_ARGS__>::ops},
+    MAP_FUSED_OPCODES
+#undef ON_FUSED_OPCODE
+};
+
+/// Checks if the instruction sequence at the given code position matches the pattern.
+/// All the instructions must start inside the code, the push data of the last one
+/// may extend into the code padding.
+bool matches(bytes_view code, size_t pos, std::span<const Opcode> ops) noexcept
+{
+    for (const auto op : ops)
+    {
+        if (pos >= code.size() || code[pos] != op)
+            return false;
+        pos += instr::legacy_instruction_size(op);
+    }
+    return true;
+}
+}  // namespace
+
+void fuse_instructions(CodeAnalysis& analysis)
+{
+    if (analysis.eof_header().version != 0 || analysis.is_fused())
+        return;
+
+    // The fused code is the copy of the padded code with the first opcodes of the fused sequences
+    // replaced by the pseudo-opcodes. The remaining bytes are unchanged so that the code offsets
+    // (jump destinations, PC) are the same as in the original code.
+    const auto code = analysis.raw_code();
+    const auto padded_size = get_legacy_analysis_layout(code.size()).bitset_offset;
+    auto fused_code = std::make_unique_for_overwrite<uint8_t[]>(padded_size);
+    std::copy_n(code.data(), padded_size, fused_code.get());
+
+    for (size_t i = 0; i < code.size();)
+    {
+        const auto op = code[i];
+
+        if (is_fused(op))
+        {
+            fused_code[i] = FUSED_UNDEFINED;
+            ++i;
+            continue;
+        }
+
+        bool fused = false;
+        for (const auto& [fused_opcode, ops] : patterns)
+        {
+            if (matches(code, i, ops))
+            {
+                fused_code[i] = fused_opcode;
+                for (const auto fused_op : ops)
+                    i += instr::legacy_instruction_size(fused_op);
+                fused = true;
+                break;
+            }
+        }
+
+        if (!fused)
+            i += instr::legacy_instruction_size(op);
+    }
+
+    analysis.set_fused_code(std::move(fused_code));
+}
+}  // namespace evmone::baseline
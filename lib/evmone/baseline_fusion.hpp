@@ -0,0 +1,107 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "instructions_traits.hpp"
+#include <algorithm>
+#include <array>
+
+namespace evmone::baseline
+{
+/// The "X Macro" for the superinstructions: the sequences of legacy instructions fused into
+/// single pseudo-opcodes by fuse_instructions().
+///
+/// The ON_FUSED_OPCODE(FUSED_OPCODE, OPCODES...) macro must be defined.
+/// The sequences are common patterns of the Solidity compiler output. The selection can be
+/// re-evaluated with the n-gram report of the histogram tracer (see create_histogram_tracer()).
+#define MAP_FUSED_OPCODES                                                             \
+    ON_FUSED_OPCODE(FUSED_PUSH1_JUMP, OP_PUSH1, OP_JUMP)                              \
+    ON_FUSED_OPCODE(FUSED_PUSH1_JUMPI, OP_PUSH1, OP_JUMPI)                            \
+    ON_FUSED_OPCODE(FUSED_PUSH2_JUMP, OP_PUSH2, OP_JUMP)                              \
+    ON_FUSED_OPCODE(FUSED_PUSH2_JUMPI, OP_PUSH2, OP_JUMPI)                            \
+    ON_FUSED_OPCODE(FUSED_ISZERO_PUSH2_JUMPI, OP_ISZERO, OP_PUSH2, OP_JUMPI)          \
+    ON_FUSED_OPCODE(FUSED_SWAP1_POP, OP_SWAP1, OP_POP)                                \
+    ON_FUSED_OPCODE(FUSED_PUSH1_MLOAD, OP_PUSH1, OP_MLOAD)                            \
+    ON_FUSED_OPCODE(FUSED_DUP1_PUSH4_EQ_PUSH2_JUMPI, OP_DUP1, OP_PUSH4, OP_EQ, OP_PUSH2, \
+        OP_JUMPI)
+
+/// The pseudo-opcodes of the superinstructions.
+///
+/// The values are taken from the range of opcodes undefined in all legacy EVM revisions.
+/// The fused code never contains these values as regular instructions: original instructions
+/// with these values are replaced with FUSED_UNDEFINED.
+enum FusedOpcode : uint8_t
+{
+    /// The replacement of undefined instructions colliding with the pseudo-opcodes.
+    FUSED_UNDEFINED = 0x0c,
+
+    FUSED_FIRST = 0x21,
+    FUSED_PUSH1_JUMP = FUSED_FIRST,
+    FUSED_PUSH1_JUMPI,
+    FUSED_PUSH2_JUMP,
+    FUSED_PUSH2_JUMPI,
+    FUSED_ISZERO_PUSH2_JUMPI,
+    FUSED_SWAP1_POP,
+    FUSED_PUSH1_MLOAD,
+    FUSED_DUP1_PUSH4_EQ_PUSH2_JUMPI,
+    FUSED_END,
+};
+
+static_assert(FUSED_END <= OP_ADDRESS, "pseudo-opcodes must be in the 0x21-0x2f range");
+
+/// Checks if the opcode is a superinstruction pseudo-opcode.
+constexpr bool is_fused(uint8_t op) noexcept
+{
+    return op >= FUSED_FIRST && op < FUSED_END;
+}
+
+/// The traits of the sequence of instructions fused into a superinstruction.
+///
+/// The requirements of the whole sequence are precomputed so that they can be checked once
+/// before executing all the instructions.
+template <Opcode... Ops>
+struct FusedTraits
+{
+    static constexpr std::array<Opcode, sizeof...(Ops)> ops{Ops...};
+
+    /// The sum of the instructions' base gas costs.
+    static constexpr int64_t gas_cost = (int64_t{instr::gas_costs[EVMC_FRONTIER][Ops]} + ...);
+
+    /// The stack height required by the whole sequence.
+    static constexpr int stack_required = [] {
+        int height = 0;
+        int required = 0;
+        for (const auto op : ops)
+        {
+            required = std::max(required, instr::traits[op].stack_height_required - height);
+            height += instr::traits[op].stack_height_change;
+        }
+        return required;
+    }();
+
+    /// The maximum stack height growth during the sequence execution.
+    static constexpr int stack_max_growth = [] {
+        int height = 0;
+        int max_growth = 0;
+        for (const auto op : ops)
+        {
+            height += instr::traits[op].stack_height_change;
+            max_growth = std::max(max_growth, height);
+        }
+        return max_growth;
+    }();
+
+    /// Checks if the instructions of the sequence are fusable: they must be defined in all legacy
+    /// EVM revisions with the constant base gas cost and cannot be a jump destination.
+    static constexpr bool valid =
+        ((instr::has_const_gas_cost(Ops) &&
+             instr::gas_costs[EVMC_FRONTIER][Ops] != instr::undefined && Ops != OP_JUMPDEST) &&
+            ...);
+};
+
+#define ON_FUSED_OPCODE(FUSED_OPCODE, ...) \
+    static_assert(FusedTraits<__VA_ARGS__>::valid, #FUSED_OPCODE " is not fusable");
+MAP_FUSED_OPCODES
+#undef ON_FUSED_OPCODE
+}  // namespace evmone::baseline
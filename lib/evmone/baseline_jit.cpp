@@ -0,0 +1,171 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "baseline_jit.hpp"
+#include "instructions_traits.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if EVMONE_JIT_SUPPORTED
+#include <sys/mman.h>
+#endif
+
+namespace evmone::baseline
+{
+#if EVMONE_JIT_SUPPORTED
+namespace
+{
+/// The x86-64 machine code of the compiled code prologue. The JitContext pointer
+/// (the first argument) is kept in the callee-saved RBX register.
+/// Pushing RBX also aligns the stack to 16 bytes as required for calls.
+constexpr uint8_t PROLOGUE[] = {
+    0x53,              // push rbx
+    0x48, 0x89, 0xfb,  // mov rbx, rdi
+};
+
+/// The x86-64 machine code of the compiled code exit.
+constexpr uint8_t EPILOGUE[] = {
+    0x5b,  // pop rbx
+    0xc3,  // ret
+};
+
+/// The x86-64 machine code stub of an instruction calling the helper with the direct
+/// near call. The 32-bit displacement of the helper is patched in.
+constexpr uint8_t CALL_STUB[] = {
+    0x48, 0x89, 0xdf,              // mov rdi, rbx
+    0xe8, 0x00, 0x00, 0x00, 0x00,  // call <helper>
+    0x48, 0x85, 0xc0,              // test rax, rax
+    0x74, 0x02,                    // je <next stub>
+    0xff, 0xe0,                    // jmp rax
+};
+constexpr size_t HELPER_DISPLACEMENT_OFFSET = 4;
+constexpr size_t HELPER_DISPLACEMENT_END = 8;
+
+/// The x86-64 machine code stub of an instruction calling the helper indirectly.
+/// Used when the helper is out of the direct call range. The helper address is patched in.
+constexpr uint8_t FAR_CALL_STUB[] = {
+    0x48, 0x89, 0xdf,                                            // mov rdi, rbx
+    0x48, 0xb8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,  // movabs rax, <helper>
+    0xff, 0xd0,                                                  // call rax
+    0x48, 0x85, 0xc0,                                            // test rax, rax
+    0x74, 0x02,                                                  // je <next stub>
+    0xff, 0xe0,                                                  // jmp rax
+};
+constexpr size_t HELPER_ADDRESS_OFFSET = 5;
+
+/// Returns the address hint for the compiled code mapping so that the helpers
+/// (in the text segment of the library) are in the range of the direct calls.
+/// The kernel uses the hint only if the address range is free.
+void* get_mapping_hint(JitHelper helper) noexcept
+{
+    static constexpr uintptr_t DISTANCE = uintptr_t{1} << 29;  // 512 MiB.
+    static constexpr uintptr_t PAGE_MASK = ~uintptr_t{0xfff};
+    const auto helper_address = reinterpret_cast<uintptr_t>(helper);
+    return reinterpret_cast<void*>(
+        (helper_address > DISTANCE ? helper_address - DISTANCE : helper_address + DISTANCE) &
+        PAGE_MASK);
+}
+}  // namespace
+
+JitCode::~JitCode() noexcept
+{
+    if (m_code != nullptr)
+        ::munmap(m_code, m_size);
+}
+
+std::unique_ptr<const JitCode> JitCode::compile(
+    bytes_view code, std::span<const JitHelper, 256> helpers)
+{
+    // Count the instructions to compute the compiled code size.
+    // The additional STOP terminates the code (like the STOP in the interpreter's code padding).
+    size_t num_instructions = 1;
+    size_t num_jumpdests = 0;
+    for (size_t i = 0; i < code.size(); i += instr::legacy_instruction_size(code[i]))
+    {
+        ++num_instructions;
+        num_jumpdests += (code[i] == OP_JUMPDEST);
+    }
+
+    std::unique_ptr<JitCode> jit_code{new JitCode};
+    jit_code->m_jumpdest_offsets.reserve(num_jumpdests);
+    jit_code->m_jumpdest_targets.reserve(num_jumpdests);
+
+    jit_code->m_size =
+        sizeof(PROLOGUE) + num_instructions * sizeof(FAR_CALL_STUB) + sizeof(EPILOGUE);
+    const auto memory = ::mmap(get_mapping_hint(helpers[OP_STOP]), jit_code->m_size,
+        PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (memory == MAP_FAILED)
+        return nullptr;
+    jit_code->m_code = static_cast<uint8_t*>(memory);
+
+    auto out = std::copy_n(PROLOGUE, sizeof(PROLOGUE), jit_code->m_code);
+    const auto emit_instruction = [&out](JitHelper helper) noexcept {
+        const auto helper_address = reinterpret_cast<uintptr_t>(helper);
+        const auto displacement = static_cast<int64_t>(
+            helper_address - reinterpret_cast<uintptr_t>(&out[HELPER_DISPLACEMENT_END]));
+        if (displacement == static_cast<int32_t>(displacement))
+        {
+            const auto displacement32 = static_cast<int32_t>(displacement);
+            std::memcpy(out, CALL_STUB, sizeof(CALL_STUB));
+            std::memcpy(&out[HELPER_DISPLACEMENT_OFFSET], &displacement32, sizeof(displacement32));
+            out += sizeof(CALL_STUB);
+        }
+        else
+        {
+            std::memcpy(out, FAR_CALL_STUB, sizeof(FAR_CALL_STUB));
+            std::memcpy(&out[HELPER_ADDRESS_OFFSET], &helper_address, sizeof(helper_address));
+            out += sizeof(FAR_CALL_STUB);
+        }
+    };
+
+    for (size_t i = 0; i < code.size(); i += instr::legacy_instruction_size(code[i]))
+    {
+        if (code[i] == OP_JUMPDEST)
+        {
+            jit_code->m_jumpdest_offsets.push_back(static_cast<uint32_t>(i));
+            jit_code->m_jumpdest_targets.push_back(static_cast<uint32_t>(out - jit_code->m_code));
+        }
+        emit_instruction(helpers[code[i]]);
+    }
+    emit_instruction(helpers[OP_STOP]);
+
+    jit_code->m_exit_offset = static_cast<size_t>(out - jit_code->m_code);
+    std::copy_n(EPILOGUE, sizeof(EPILOGUE), out);
+
+    if (::mprotect(jit_code->m_code, jit_code->m_size, PROT_READ | PROT_EXEC) != 0)
+        return nullptr;
+
+    return jit_code;
+}
+
+void JitCode::run(JitContext& ctx) const noexcept
+{
+    using EntryFn = void (*)(JitContext*) noexcept;
+    reinterpret_cast<EntryFn>(m_code)(&ctx);
+}
+
+const uint8_t* JitCode::find_jumpdest(size_t offset) const noexcept
+{
+    const auto it = std::ranges::lower_bound(m_jumpdest_offsets, offset);
+    if (it == m_jumpdest_offsets.end() || *it != offset)
+        return nullptr;
+    return &m_code[m_jumpdest_targets[static_cast<size_t>(it - m_jumpdest_offsets.begin())]];
+}
+#else
+JitCode::~JitCode() noexcept = default;
+
+std::unique_ptr<const JitCode> JitCode::compile(
+    bytes_view /*code*/, std::span<const JitHelper, 256> /*helpers*/)
+{
+    return nullptr;
+}
+
+void JitCode::run(JitContext& /*ctx*/) const noexcept {}
+
+const uint8_t* JitCode::find_jumpdest(size_t /*offset*/) const noexcept
+{
+    return nullptr;
+}
+#endif
+}  // namespace evmone::baseline
@@ -0,0 +1,84 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <evmc/bytes.hpp>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <vector>
+
+#if defined(__x86_64__) && !defined(_WIN32)
+#define EVMONE_JIT_SUPPORTED 1
+#else
+#define EVMONE_JIT_SUPPORTED 0
+#endif
+
+namespace evmone::baseline
+{
+using evmc::bytes_view;
+
+/// The execution context of the JIT compiled code. Defined by the interpreter.
+struct JitContext;
+
+/// The JIT helper executing the single instruction at the current position of the context.
+///
+/// @return  nullptr to continue with the next instruction in the code order or
+///          the address in the compiled code to continue at (jump destination or exit).
+using JitHelper = const uint8_t* (*)(JitContext& ctx) noexcept;
+
+/// The legacy code compiled to x86-64 call-threaded code.
+///
+/// The compiled code is the sequence of the call stubs, one for each instruction in the code
+/// order. The stub calls the helper of the instruction (the interpreter's implementation with
+/// the requirements check) and continues with the next stub or jumps to the address returned
+/// by the helper. Every instruction is still executed by the full helper: only the opcode
+/// table lookup and the indirect branch of the interpreter loop are replaced by the direct
+/// near call (the executable memory is mapped close to the helpers if possible, otherwise
+/// the stub falls back to the indirect call). The EVM stack, gas and the code position
+/// are kept in the JitContext, so the compiled code is independent of the execution.
+class JitCode
+{
+    /// The executable memory with the compiled code.
+    uint8_t* m_code = nullptr;
+
+    /// The size of the executable memory.
+    size_t m_size = 0;
+
+    /// The offset of the exit sequence in the compiled code.
+    size_t m_exit_offset = 0;
+
+    /// The sorted code offsets of JUMPDEST instructions.
+    std::vector<uint32_t> m_jumpdest_offsets;
+
+    /// The offsets of the compiled stubs matching the m_jumpdest_offsets.
+    std::vector<uint32_t> m_jumpdest_targets;
+
+    JitCode() noexcept = default;
+
+public:
+    JitCode(const JitCode&) = delete;
+    JitCode& operator=(const JitCode&) = delete;
+    ~JitCode() noexcept;
+
+    /// Compiles the legacy code.
+    ///
+    /// @param code     The legacy code (without superinstructions).
+    /// @param helpers  The instruction helpers for all opcodes.
+    /// @return         The compiled code or nullptr if the JIT is not supported by the platform
+    ///                 or the executable memory cannot be allocated.
+    static std::unique_ptr<const JitCode> compile(
+        bytes_view code, std::span<const JitHelper, 256> helpers);
+
+    /// Executes the compiled code with the given context.
+    void run(JitContext& ctx) const noexcept;
+
+    /// Returns the compiled code address of the JUMPDEST at the given code offset
+    /// or nullptr if there is no JUMPDEST at the offset.
+    [[nodiscard]] const uint8_t* find_jumpdest(size_t offset) const noexcept;
+
+    /// Returns the address of the compiled code exit.
+    [[nodiscard]] const uint8_t* exit() const noexcept { return &m_code[m_exit_offset]; }
+};
+}  // namespace evmone::baseline
@@ -0,0 +1,54 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "baseline.hpp"
+#include "eof.hpp"
+#include "lru_cache.hpp"
+#include <evmc/evmc.hpp>
+#include <memory>
+
+namespace evmone
+{
+/// The cached result of the EOF container validation.
+struct EOFValidationResult
+{
+    /// The EVM revision the container has been validated against.
+    evmc_revision rev = {};
+
+    /// The kind of the validated container.
+    ContainerKind kind = ContainerKind::runtime;
+
+    /// The validation result.
+    EOFValidationError error = EOFValidationError::success;
+};
+
+/// The thread-safe cache of code analyses and EOF validation results.
+///
+/// A single instance can be shared by multiple VM instances (e.g. one VM per thread).
+class CodeCache
+{
+public:
+    /// The baseline code analyses keyed by the code hash.
+    ///
+    /// The entries are shared pointers so that an analysis evicted from the cache
+    /// is kept alive until all executions using it end.
+    ConcurrentLRUCache<evmc::bytes32, std::shared_ptr<const baseline::CodeAnalysis>>
+        baseline_analyses;
+
+    /// The EOF validation results keyed by the Keccak-256 hash of the container.
+    ConcurrentLRUCache<evmc::bytes32, EOFValidationResult> eof_validations;
+
+    /// Creates the code cache.
+    ///
+    /// @param capacity  The capacity of each of the caches. It must not be 0.
+    explicit CodeCache(size_t capacity) : baseline_analyses{capacity}, eof_validations{capacity} {}
+
+    /// Returns the process-wide shared code cache.
+    ///
+    /// The shared cache is created with the given capacity on first use and lives as long as
+    /// any of its users. The capacity argument is ignored if the shared cache already exists.
+    static std::shared_ptr<CodeCache> get_shared(size_t capacity);
+};
+}  // namespace evmone
@@ -0,0 +1,167 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "execution_state.hpp"
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#elif defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#define EVMONE_MMAP_SUPPORTED 1
+#endif
+
+namespace evmone
+{
+namespace
+{
+/// The granularity of committing the virtual memory pages.
+/// This is a multiple of the OS page sizes in use (4k, 16k, 64k).
+constexpr size_t commit_granularity = 64 * 1024;
+
+constexpr size_t round_up(size_t size, size_t alignment) noexcept
+{
+    return (size + (alignment - 1)) / alignment * alignment;
+}
+
+#ifdef _WIN32
+uint8_t* reserve_range(size_t size) noexcept
+{
+    return static_cast<uint8_t*>(VirtualAlloc(nullptr, size, MEM_RESERVE, PAGE_NOACCESS));
+}
+
+bool commit_range(uint8_t* p, size_t size) noexcept
+{
+    return VirtualAlloc(p, size, MEM_COMMIT, PAGE_READWRITE) != nullptr;
+}
+
+void release_range(uint8_t* p, size_t /*size*/) noexcept
+{
+    VirtualFree(p, 0, MEM_RELEASE);
+}
+#elif EVMONE_MMAP_SUPPORTED
+uint8_t* reserve_range(size_t size) noexcept
+{
+    const auto p =
+        mmap(nullptr, size, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    return p != MAP_FAILED ? static_cast<uint8_t*>(p) : nullptr;
+}
+
+bool commit_range(uint8_t* p, size_t size) noexcept
+{
+    return mprotect(p, size, PROT_READ | PROT_WRITE) == 0;
+}
+
+void release_range(uint8_t* p, size_t size) noexcept
+{
+    munmap(p, size);
+}
+#else
+uint8_t* reserve_range(size_t /*size*/) noexcept
+{
+    return nullptr;
+}
+
+bool commit_range(uint8_t* /*p*/, size_t /*size*/) noexcept
+{
+    return false;
+}
+
+void release_range(uint8_t* /*p*/, size_t /*size*/) noexcept {}
+#endif
+}  // namespace
+
+bool Memory::virtual_supported() noexcept
+{
+#if defined(_WIN32) || EVMONE_MMAP_SUPPORTED
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Memory::release_virtual(uint8_t* p, size_t reserved_size) noexcept
+{
+    release_range(p, reserved_size);
+}
+
+void Memory::commit_virtual(size_t new_size) noexcept
+{
+    const auto reserved_size = m_data.get_deleter().reserved_size;
+    auto new_capacity = std::max(m_capacity * 2, round_up(new_size, commit_granularity));
+    if (new_capacity > reserved_size && new_size <= reserved_size)
+        new_capacity = reserved_size;  // Do not exceed the reservation only because of doubling.
+
+    if (new_capacity > reserved_size)
+    {
+        // Reserve the new virtual address range. This only happens for the first growth
+        // or when the initial reservation is exceeded: then the used part is copied.
+        const auto new_reserved_size =
+            std::max({virtual_reservation_size, reserved_size * 2, new_capacity});
+        const auto p = reserve_range(new_reserved_size);
+        if (p == nullptr || !commit_range(p, new_capacity)) [[unlikely]]
+            handle_out_of_memory();
+
+        if (m_size != 0)
+            std::memcpy(p, m_data.get(), m_size);
+        m_data.reset(p);
+        m_data.get_deleter().reserved_size = new_reserved_size;
+        m_max_size = m_size;
+    }
+    else if (!commit_range(&m_data[m_capacity], new_capacity - m_capacity)) [[unlikely]]
+        handle_out_of_memory();
+
+    m_capacity = new_capacity;
+}
+
+void OutputBuffer::reallocate(size_t capacity) noexcept
+{
+    free_data(std::exchange(m_data, nullptr));
+    const auto p = static_cast<uint8_t*>(std::malloc(header_size + capacity));
+    if (p == nullptr) [[unlikely]]
+        std::terminate();
+    std::memcpy(p, &capacity, sizeof(capacity));
+    m_data = p + header_size;
+}
+
+void OutputBuffer::free_data(uint8_t* data) noexcept
+{
+    if (data != nullptr)
+        std::free(data - header_size);
+}
+
+void OutputBuffer::release_result(const evmc_result* result) noexcept
+{
+    free_data(const_cast<uint8_t*>(result->output_data));
+}
+
+std::optional<OutputBuffer> OutputBuffer::take(evmc::Result& result) noexcept
+{
+    auto raw = result.release_raw();
+    if (raw.release != release_result)
+    {
+        result = evmc::Result{raw};  // Give the ownership back.
+        return std::nullopt;
+    }
+    // The output data stays valid in the result until the taken buffer is destroyed.
+    return OutputBuffer{const_cast<uint8_t*>(raw.output_data), raw.output_size};
+}
+
+evmc_result OutputBuffer::make_result(evmc_status_code status_code, int64_t gas_left,
+    int64_t gas_refund, const uint8_t* output_data, size_t output_size) noexcept
+{
+    evmc_result result{};
+    result.status_code = status_code;
+    result.gas_left = gas_left;
+    result.gas_refund = gas_refund;
+    if (output_size != 0)
+    {
+        assign(output_data, output_size);
+        result.output_data = std::exchange(m_data, nullptr);
+        result.output_size = std::exchange(m_size, 0);
+        result.release = release_result;
+    }
+    return result;
+}
+}  // namespace evmone
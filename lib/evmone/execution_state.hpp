@@ -5,9 +5,14 @@
 
 #include <evmc/evmc.hpp>
 #include <intx/intx.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <exception>
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace evmone
@@ -27,20 +32,17 @@ using intx::uint256;
 
 
 /// Provides memory for EVM stack.
+///
+/// The stack space is either allocated and owned by the object or provided externally,
+/// e.g. by the ExecutionStatePool arena.
 class StackSpace
 {
-    static uint256* allocate() noexcept
-    {
-        static constexpr auto alignment = sizeof(uint256);
-        static constexpr auto size = limit * sizeof(uint256);
-#ifdef _MSC_VER
-        // MSVC doesn't support aligned_alloc() but _aligned_malloc() can be used instead.
-        const auto p = _aligned_malloc(size, alignment);
-#else
-        const auto p = std::aligned_alloc(alignment, size);
-#endif
-        return static_cast<uint256*>(p);
-    }
+public:
+    /// The maximum number of EVM stack items.
+    static constexpr auto limit = 1024;
+
+    /// The size of a single stack space in bytes.
+    static constexpr auto size = limit * sizeof(uint256);
 
     struct Deleter
     {
@@ -56,43 +58,87 @@ class StackSpace
         }
     };
 
-    /// The storage allocated for maximum possible number of items.
+    /// Allocates the storage for the given number of consecutive stack spaces.
     /// Items are aligned to 256 bits for better packing in cache lines.
+    static std::unique_ptr<uint256, Deleter> allocate(size_t count = 1) noexcept
+    {
+        static constexpr auto alignment = sizeof(uint256);
+#ifdef _MSC_VER
+        // MSVC doesn't support aligned_alloc() but _aligned_malloc() can be used instead.
+        const auto p = _aligned_malloc(count * size, alignment);
+#else
+        const auto p = std::aligned_alloc(alignment, count * size);
+#endif
+        return std::unique_ptr<uint256, Deleter>{static_cast<uint256*>(p)};
+    }
+
+private:
+    /// The owned storage allocated for maximum possible number of items.
+    /// Empty if the storage is provided externally.
     std::unique_ptr<uint256, Deleter> m_stack_space;
 
+    /// The pointer to the stack space storage.
+    uint256* m_bottom = nullptr;
+
 public:
-    /// The maximum number of EVM stack items.
-    static constexpr auto limit = 1024;
+    StackSpace() noexcept : m_stack_space{allocate()}, m_bottom{m_stack_space.get()} {}
 
-    StackSpace() noexcept : m_stack_space{allocate()} {}
+    /// Uses the externally provided storage of the StackSpace::size bytes (not owned).
+    explicit StackSpace(uint256* storage) noexcept : m_bottom{storage} {}
 
     /// Returns the pointer to the "bottom", i.e. below the stack space.
-    [[nodiscard]] uint256* bottom() noexcept { return m_stack_space.get(); }
+    [[nodiscard]] uint256* bottom() noexcept { return m_bottom; }
 };
 
 
 /// The EVM memory.
 ///
-/// The implementations uses initial allocation of 4k and then grows capacity with 2x factor.
-/// Some benchmarks have been done to confirm 4k is ok-ish value.
+/// The memory buffer is acquired lazily on the first growth: executions not using the EVM memory
+/// do not allocate it. The implementation uses initial allocation of 4k and then grows capacity
+/// with 2x factor. Some benchmarks have been done to confirm 4k is ok-ish value.
+///
+/// Optionally (see set_virtual()) the buffer is a reserved range of the virtual address space
+/// with the pages committed on demand: the growth never copies the memory contents
+/// and the fresh pages come zero-filled from the OS.
 class Memory
 {
     /// The size of allocation "page".
     static constexpr size_t page_size = 4 * 1024;
 
-    struct FreeDeleter
+    /// The initial size of the reserved virtual address range.
+    static constexpr size_t virtual_reservation_size = 64 * 1024 * 1024;
+
+    struct Deleter
     {
-        void operator()(uint8_t* p) const noexcept { std::free(p); }
+        /// The size of the reserved virtual address range. 0 if the buffer is heap-allocated.
+        /// No default member initializer: it would make the nested struct not default
+        /// constructible inside Memory. The unique_ptr value-initializes the deleter.
+        size_t reserved_size;
+
+        void operator()(uint8_t* p) const noexcept
+        {
+            if (reserved_size != 0)
+                release_virtual(p, reserved_size);
+            else
+                std::free(p);
+        }
     };
 
     /// Owned pointer to allocated memory.
-    std::unique_ptr<uint8_t[], FreeDeleter> m_data;
+    std::unique_ptr<uint8_t[], Deleter> m_data;
 
     /// The "virtual" size of the memory.
     size_t m_size = 0;
 
-    /// The size of allocated memory. The initialization value is the initial capacity.
-    size_t m_capacity = page_size;
+    /// The size of allocated memory.
+    size_t m_capacity = 0;
+
+    /// The maximum memory size since the virtual buffer acquisition.
+    /// The virtual buffer contents beyond it are known to be zeros.
+    size_t m_max_size = 0;
+
+    /// Use the virtual memory buffer.
+    bool m_virtual = false;
 
     [[noreturn, gnu::cold]] static void handle_out_of_memory() noexcept { std::terminate(); }
 
@@ -103,15 +149,29 @@ class Memory
             handle_out_of_memory();
     }
 
+    /// Commits the pages of the virtual buffer to fit the given size.
+    /// Reserves the (new) virtual address range if needed.
+    [[gnu::cold]] void commit_virtual(size_t new_size) noexcept;
+
+    /// Releases the reserved virtual address range.
+    static void release_virtual(uint8_t* p, size_t reserved_size) noexcept;
+
 public:
-    /// Creates Memory object with initial capacity allocation.
-    Memory() noexcept { allocate_capacity(); }
+    /// Checks if the virtual memory buffers are supported on this platform.
+    static bool virtual_supported() noexcept;
 
     uint8_t& operator[](size_t index) noexcept { return m_data[index]; }
 
     [[nodiscard]] const uint8_t* data() const noexcept { return m_data.get(); }
     [[nodiscard]] size_t size() const noexcept { return m_size; }
 
+    /// The size of the allocated memory buffer, i.e. the high-water mark of the memory size
+    /// rounded up to the allocation granularity.
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+    /// Checks if the memory uses the virtual memory buffer.
+    [[nodiscard]] bool is_virtual() const noexcept { return m_virtual; }
+
     /// Grows the memory to the given size. The extent is filled with zeros.
     ///
     /// @param new_size  New memory size. Must be larger than the current size and multiple of 32.
@@ -123,9 +183,22 @@ public:
         // Allow only growing memory. Include hint for optimizing compiler.
         INTX_REQUIRE(new_size > m_size);
 
+        if (m_virtual)
+        {
+            if (new_size > m_capacity)
+                commit_virtual(new_size);
+
+            // Only the previously used part may contain non-zero bytes.
+            if (const auto dirty_end = std::min(new_size, m_max_size); dirty_end > m_size)
+                std::memset(&m_data[m_size], 0, dirty_end - m_size);
+            m_max_size = std::max(m_max_size, new_size);
+            m_size = new_size;
+            return;
+        }
+
         if (new_size > m_capacity)
         {
-            m_capacity *= 2;  // Double the capacity.
+            m_capacity *= 2;  // Double the capacity (stays 0 if not allocated yet).
 
             if (m_capacity < new_size)  // If not enough.
             {
@@ -141,6 +214,107 @@ public:
 
     /// Virtually clears the memory by setting its size to 0. The capacity stays unchanged.
     void clear() noexcept { m_size = 0; }
+
+    /// Clears the memory and releases the memory buffer.
+    void release() noexcept
+    {
+        m_data.reset();
+        m_data.get_deleter().reserved_size = 0;
+        m_size = 0;
+        m_capacity = 0;
+        m_max_size = 0;
+    }
+
+    /// Selects the kind of the memory buffer. The current buffer is released.
+    /// The virtual buffer is only used if supported (see virtual_supported()).
+    void set_virtual(bool use_virtual) noexcept
+    {
+        release();
+        m_virtual = use_virtual && virtual_supported();
+    }
+};
+
+/// The buffer of the execution output (the return data).
+///
+/// The buffer is allocated together with the header storing its capacity, so the ownership
+/// can be passed to the evmc_result (see make_result()) and then taken over by the calling frame
+/// without copying (see ExecutionState::set_return_data()). The capacity is kept by clear()
+/// so the buffer can be reused by later executions.
+class OutputBuffer
+{
+    /// The size of the header preceding the data. Keeps the data aligned as by malloc().
+    static constexpr size_t header_size = alignof(std::max_align_t);
+
+    /// Owned pointer to the data (after the header). Null if the buffer is not allocated.
+    uint8_t* m_data = nullptr;
+
+    /// The size of the data.
+    size_t m_size = 0;
+
+    OutputBuffer(uint8_t* data, size_t size) noexcept : m_data{data}, m_size{size} {}
+
+    /// Replaces the buffer with a new one of the given capacity. The data is not preserved.
+    [[gnu::cold]] void reallocate(size_t capacity) noexcept;
+
+    /// Frees the buffer given by the data pointer.
+    static void free_data(uint8_t* data) noexcept;
+
+    /// The evmc_result release function of the results created by make_result().
+    static void release_result(const evmc_result* result) noexcept;
+
+public:
+    OutputBuffer() noexcept = default;
+    OutputBuffer(OutputBuffer&& other) noexcept
+      : m_data{std::exchange(other.m_data, nullptr)}, m_size{std::exchange(other.m_size, 0)}
+    {}
+    OutputBuffer& operator=(OutputBuffer&& other) noexcept
+    {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+        return *this;
+    }
+    ~OutputBuffer() noexcept { free_data(m_data); }
+
+    /// Takes over the output buffer of the result if it has been created by make_result().
+    ///
+    /// @return  The buffer of the result output or std::nullopt if the output is not owned
+    ///          by an OutputBuffer (the result is left unchanged).
+    static std::optional<OutputBuffer> take(evmc::Result& result) noexcept;
+
+    [[nodiscard]] const uint8_t* data() const noexcept { return m_data; }
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    const uint8_t& operator[](size_t index) const noexcept { return m_data[index]; }
+    operator bytes_view() const noexcept { return {m_data, m_size}; }
+
+    /// The size of the allocated buffer.
+    [[nodiscard]] size_t capacity() const noexcept
+    {
+        size_t capacity = 0;
+        if (m_data != nullptr)
+            std::memcpy(&capacity, m_data - header_size, sizeof(capacity));
+        return capacity;
+    }
+
+    /// Clears the data. The capacity stays unchanged.
+    void clear() noexcept { m_size = 0; }
+
+    /// Replaces the data with the copy of the given bytes.
+    void assign(const uint8_t* data, size_t size) noexcept
+    {
+        if (size > capacity())
+            reallocate(size);
+        if (size != 0)
+            std::memcpy(m_data, data, size);
+        m_size = size;
+    }
+
+    /// Creates the execution result with the copy of the output data in this buffer.
+    ///
+    /// The buffer ownership is passed to the result (this becomes empty).
+    /// The result without output does not take the buffer.
+    [[nodiscard]] evmc_result make_result(evmc_status_code status_code, int64_t gas_left,
+        int64_t gas_refund, const uint8_t* output_data, size_t output_size) noexcept;
 };
 
 /// Initcode read from Initcode Transaction (EIP-7873).
@@ -163,7 +337,7 @@ public:
     const evmc_message* msg = nullptr;
     evmc::HostContext host;
     evmc_revision rev = {};
-    bytes return_data;
+    OutputBuffer return_data;
 
     /// Reference to original EVM code container.
     /// For legacy code this is a reference to entire original code.
@@ -192,6 +366,13 @@ public:
 
     std::vector<const uint8_t*> call_stack;
 
+    /// The buffer for the output of this execution, reused by the execution result.
+    OutputBuffer output_buffer;
+
+    /// The state used for the executions of the calls made by this state (the next call depth)
+    /// or null if unknown. Set by the ExecutionStatePool.
+    ExecutionState* callee_state = nullptr;
+
     /// Stack space allocation.
     ///
     /// This is the last field to make other fields' offsets of reasonable values.
@@ -199,6 +380,9 @@ public:
 
     ExecutionState() noexcept = default;
 
+    /// Creates the state using the provided stack space.
+    explicit ExecutionState(StackSpace stack) noexcept : stack_space{std::move(stack)} {}
+
     ExecutionState(const evmc_message& message, evmc_revision revision,
         const evmc_host_interface& host_interface, evmc_host_context* host_ctx,
         bytes_view _code) noexcept
@@ -223,11 +407,31 @@ public:
         deploy_container = {};
         m_tx = {};
         m_initcodes.reset();
-        call_stack = {};
+        call_stack.clear();  // Keep the capacity for the next executions.
     }
 
     [[nodiscard]] bool in_static_mode() const { return (msg->flags & EVMC_STATIC) != 0; }
 
+    /// Sets the return data to the output of the call result.
+    ///
+    /// The output buffer of the callee executed by evmone is taken over without copying
+    /// and the previous return data buffer is passed to the callee state for reuse.
+    /// The result output data stays valid until the next call.
+    void set_return_data(evmc::Result& result) noexcept
+    {
+        auto output = OutputBuffer::take(result);
+        if (!output.has_value())
+        {
+            return_data.assign(result.output_data, result.output_size);
+            return;
+        }
+
+        if (callee_state != nullptr &&
+            return_data.capacity() > callee_state->output_buffer.capacity())
+            std::swap(return_data, callee_state->output_buffer);
+        return_data = std::move(*output);
+    }
+
     const evmc_tx_context& get_tx_context() noexcept
     {
         if (INTX_UNLIKELY(m_tx.block_timestamp == 0))
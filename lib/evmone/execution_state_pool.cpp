@@ -0,0 +1,76 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "execution_state_pool.hpp"
+#include <algorithm>
+#include <cassert>
+
+namespace evmone
+{
+ExecutionStatePool::ExecutionStatePool() noexcept
+{
+    // The vectors already have the capacity for all possible depths,
+    // so reallocation never happens (therefore: noexcept).
+    m_states.reserve(max_depth + 1);
+    m_stack_chunks.reserve((max_depth + stacks_per_chunk) / stacks_per_chunk);
+}
+
+ExecutionState& ExecutionStatePool::grow(size_t depth) noexcept
+{
+    assert(depth <= max_depth);
+    for (auto i = m_states.size(); i <= depth; ++i)
+    {
+        const auto chunk_index = i / stacks_per_chunk;
+        if (chunk_index == m_stack_chunks.size())
+        {
+            auto chunk = StackSpace::allocate(stacks_per_chunk);
+            if (!chunk) [[unlikely]]
+                std::terminate();
+            m_stack_chunks.emplace_back(std::move(chunk));
+        }
+        const auto stack_storage =
+            m_stack_chunks[chunk_index].get() + (i % stacks_per_chunk) * StackSpace::limit;
+        auto& state = m_states.emplace_back(StackSpace{stack_storage});
+        state.memory.set_virtual(m_virtual_memory);
+        if (i != 0)
+            m_states[i - 1].callee_state = &state;
+    }
+    return m_states[depth];
+}
+
+ExecutionStatePool::Stats ExecutionStatePool::stats() const noexcept
+{
+    Stats stats;
+    stats.num_states = m_states.size();
+    stats.stack_arena_size = m_stack_chunks.size() * stacks_per_chunk * StackSpace::size;
+    for (const auto& state : m_states)
+    {
+        stats.memory_capacity += state.memory.capacity();
+        stats.max_memory_capacity = std::max(stats.max_memory_capacity, state.memory.capacity());
+        stats.max_call_stack_capacity =
+            std::max(stats.max_call_stack_capacity, state.call_stack.capacity());
+    }
+    return stats;
+}
+
+void ExecutionStatePool::trim(size_t max_memory_capacity) noexcept
+{
+    for (auto& state : m_states)
+    {
+        if (state.memory.capacity() > max_memory_capacity)
+            state.memory.release();
+        if (state.output_buffer.capacity() > max_memory_capacity)
+            state.output_buffer = {};
+        if (state.return_data.capacity() > max_memory_capacity)
+            state.return_data = {};
+    }
+}
+
+void ExecutionStatePool::set_virtual_memory(bool use_virtual) noexcept
+{
+    m_virtual_memory = use_virtual;
+    for (auto& state : m_states)
+        state.memory.set_virtual(use_virtual);
+}
+}  // namespace evmone
@@ -0,0 +1,89 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "execution_state.hpp"
+#include <memory>
+#include <vector>
+
+namespace evmone
+{
+/// The pool of the execution states, one per call depth.
+///
+/// The states are created lazily when the call depth is reached for the first time.
+/// Their stack spaces are carved from the arena allocated in chunks of consecutive stack spaces
+/// (large allocations are lazily backed by physical pages so only the used parts are resident).
+/// The EVM memory buffers are acquired by the states on first use.
+/// After the warm-up the execution at already reached depths does not allocate.
+///
+/// The instance is owned by a single VM and is not thread-safe.
+class ExecutionStatePool
+{
+public:
+    /// The maximum number of the execution states: the call depth limit + 1.
+    static constexpr size_t max_depth = 1024;
+
+    /// The number of stack spaces in a single arena chunk.
+    static constexpr size_t stacks_per_chunk = 16;
+
+    /// The high-water statistics of the pool useful for sizing the resources.
+    struct Stats
+    {
+        /// The number of created execution states, i.e. the maximum call depth reached + 1.
+        size_t num_states = 0;
+
+        /// The total size of the stack arena in bytes.
+        size_t stack_arena_size = 0;
+
+        /// The total capacity of the EVM memory buffers in bytes.
+        size_t memory_capacity = 0;
+
+        /// The maximum capacity of a single EVM memory buffer in bytes.
+        size_t max_memory_capacity = 0;
+
+        /// The maximum capacity of a single call stack (the number of the return addresses).
+        size_t max_call_stack_capacity = 0;
+    };
+
+private:
+    /// The execution states indexed by the call depth.
+    std::vector<ExecutionState> m_states;
+
+    /// The chunks of the stack arena.
+    std::vector<std::unique_ptr<uint256, StackSpace::Deleter>> m_stack_chunks;
+
+    /// Use the virtual memory buffers for the EVM memory (see Memory::set_virtual()).
+    bool m_virtual_memory = false;
+
+public:
+    ExecutionStatePool() noexcept;
+
+    /// Returns the execution state for the given call depth.
+    ///
+    /// The state must be reset before use.
+    [[nodiscard]] ExecutionState& get(size_t depth) noexcept
+    {
+        if (depth < m_states.size()) [[likely]]
+            return m_states[depth];
+        return grow(depth);
+    }
+
+    /// Returns the high-water statistics.
+    [[nodiscard]] Stats stats() const noexcept;
+
+    /// Releases the EVM memory and the output buffers larger than the given capacity.
+    ///
+    /// This is intended to be called between transactions to bound the resident memory
+    /// after an execution with exceptional memory usage. Must not be called during execution.
+    void trim(size_t max_memory_capacity) noexcept;
+
+    /// Selects the kind of the EVM memory buffers of all the states.
+    /// The current buffers are released. Must not be called during execution.
+    void set_virtual_memory(bool use_virtual) noexcept;
+
+private:
+    /// Creates the execution states up to the given depth.
+    [[gnu::noinline]] ExecutionState& grow(size_t depth) noexcept;
+};
+}  // namespace evmone
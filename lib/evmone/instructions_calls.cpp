@@ -170,8 +170,8 @@ Result call_impl(StackTop stack, int64_t gas_left, ExecutionState& state) noexce
     if (has_value && intx::be::load<uint256>(state.host.get_balance(state.msg->recipient)) < value)
         return {EVMC_SUCCESS, gas_left};  // "Light" failure.
 
-    const auto result = state.host.call(msg);
-    state.return_data.assign(result.output_data, result.output_size);
+    auto result = state.host.call(msg);
+    state.set_return_data(result);
     stack.top() = result.status_code == EVMC_SUCCESS;
 
     if (const auto copy_size = std::min(output_size, result.output_size); copy_size > 0)
@@ -290,8 +290,8 @@ Result extcall_impl(StackTop stack, int64_t gas_left, ExecutionState& state) noe
         }
     }
 
-    const auto result = state.host.call(msg);
-    state.return_data.assign(result.output_data, result.output_size);
+    auto result = state.host.call(msg);
+    state.set_return_data(result);
     if (result.status_code == EVMC_SUCCESS)
         stack.top() = EXTCALL_SUCCESS;
     else if (result.status_code == EVMC_REVERT)
@@ -372,11 +372,11 @@ Result create_impl(StackTop stack, int64_t gas_left, ExecutionState& state) noex
     msg.create2_salt = intx::be::store<evmc::bytes32>(salt);
     msg.value = intx::be::store<evmc::uint256be>(endowment);
 
-    const auto result = state.host.call(msg);
+    auto result = state.host.call(msg);
     gas_left -= msg.gas - result.gas_left;
     state.gas_refund += result.gas_refund;
 
-    state.return_data.assign(result.output_data, result.output_size);
+    state.set_return_data(result);
     if (result.status_code == EVMC_SUCCESS)
         stack.top() = intx::be::load<uint256>(result.create_address);
 
@@ -462,11 +462,11 @@ Result create_eof_impl(
     msg.code = initcontainer.data();
     msg.code_size = initcontainer.size();
 
-    const auto result = state.host.call(msg);
+    auto result = state.host.call(msg);
     gas_left -= msg.gas - result.gas_left;
     state.gas_refund += result.gas_refund;
 
-    state.return_data.assign(result.output_data, result.output_size);
+    state.set_return_data(result);
     if (result.status_code == EVMC_SUCCESS)
         stack.top() = intx::be::load<uint256>(result.create_address);
 
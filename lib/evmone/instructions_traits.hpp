@@ -249,6 +249,14 @@ consteval bool has_const_gas_cost(Opcode op) noexcept
     return true;
 }
 
+/// Returns the size of the legacy instruction including the push data.
+/// The Traits::immediate_size cannot be used for legacy code: it includes the immediates
+/// of EOF instructions which are undefined (and have no immediates) in legacy code.
+constexpr size_t legacy_instruction_size(uint8_t op) noexcept
+{
+    return (op >= OP_PUSH1 && op <= OP_PUSH32) ? op - size_t{OP_PUSH1 - 2} : 1;
+}
+
 
 /// The global, EVM revision independent, table of traits of all known EVM instructions.
 constexpr inline std::array<Traits, 256> traits = []() noexcept {
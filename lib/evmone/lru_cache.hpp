@@ -4,9 +4,13 @@
 #pragma once
 
 #include <cassert>
+#include <functional>
 #include <list>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <unordered_map>
+#include <vector>
 
 namespace evmone
 {
@@ -159,4 +163,86 @@ public:
     }
 };
 
+/// Thread-safe Least Recently Used (LRU) cache.
+///
+/// The entries are distributed over a fixed number of shards by the key hash.
+/// Each shard is an independent LRUCache protected by its own mutex (lock striping),
+/// so concurrent accesses to different shards don't contend.
+/// The LRU order (and therefore eviction) is maintained per shard.
+///
+/// The values are returned by copy, so for shared ownership of the cached objects
+/// (e.g. to keep an evicted entry alive while it is still used) use std::shared_ptr as the Value.
+template <typename Key, typename Value>
+class ConcurrentLRUCache
+{
+    /// The cache shard. Aligned to the cache line size to avoid false sharing of the mutexes.
+    struct alignas(64) Shard
+    {
+        std::mutex mutex;
+        LRUCache<Key, Value> cache;
+
+        explicit Shard(size_t capacity) : cache{capacity} {}
+    };
+
+    /// The shards. The Shard is not movable so these must be allocated individually.
+    std::vector<std::unique_ptr<Shard>> shards_;
+
+    /// Selects the shard for the given key.
+    Shard& get_shard(const Key& key) noexcept
+    {
+        return *shards_[std::hash<Key>{}(key) % shards_.size()];
+    }
+
+public:
+    /// The default number of shards.
+    static constexpr size_t default_num_shards = 16;
+
+    /// Constructs the concurrent LRU cache.
+    ///
+    /// @param capacity    The total capacity of the cache. It must not be 0.
+    ///                    It is evenly divided between shards (rounding up), so each shard
+    ///                    holds at least one entry.
+    /// @param num_shards  The number of shards. It must not be 0.
+    explicit ConcurrentLRUCache(size_t capacity, size_t num_shards = default_num_shards)
+    {
+        assert(capacity != 0);
+        assert(num_shards != 0);
+
+        const auto shard_capacity = (capacity + num_shards - 1) / num_shards;
+        shards_.reserve(num_shards);
+        for (size_t i = 0; i < num_shards; ++i)
+            shards_.emplace_back(std::make_unique<Shard>(shard_capacity));
+    }
+
+    /// Clears the cache by deleting all the entries.
+    void clear()
+    {
+        for (const auto& shard : shards_)
+        {
+            const std::lock_guard lock{shard->mutex};
+            shard->cache.clear();
+        }
+    }
+
+    /// Retrieves the copy of the value associated with the specified key.
+    ///
+    /// @see LRUCache::get().
+    std::optional<Value> get(const Key& key)
+    {
+        auto& shard = get_shard(key);
+        const std::lock_guard lock{shard.mutex};
+        return shard.cache.get(key);
+    }
+
+    /// Inserts or updates the value associated with the specified key.
+    ///
+    /// @see LRUCache::put().
+    void put(Key key, Value value)
+    {
+        auto& shard = get_shard(key);
+        const std::lock_guard lock{shard.mutex};
+        shard.cache.put(std::move(key), std::move(value));
+    }
+};
+
 }  // namespace evmone
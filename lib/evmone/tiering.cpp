@@ -0,0 +1,75 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "tiering.hpp"
+#include "advanced_analysis.hpp"
+#include "advanced_execution.hpp"
+#include <cassert>
+
+namespace evmone
+{
+Tiering::Tiering(uint64_t threshold, size_t capacity) : m_threshold{threshold}, m_profiles{capacity}
+{
+    assert(m_threshold != 0);
+    m_states.reserve(1025);
+}
+
+Tiering::~Tiering() noexcept = default;
+
+uint64_t Tiering::get_execution_count(const evmc::bytes32& code_hash) noexcept
+{
+    const auto profile = m_profiles.get(code_hash);
+    return profile.has_value() ? (*profile)->count : 0;
+}
+
+std::shared_ptr<const advanced::AdvancedCodeAnalysis> Tiering::record_execution(
+    const evmc::bytes32& code_hash, evmc_revision rev, bytes_view code)
+{
+    auto profile = m_profiles.get(code_hash).value_or(nullptr);
+    if (profile == nullptr || profile->code_size != code.size())
+    {
+        profile = std::make_shared<CodeProfile>();
+        profile->code_size = code.size();
+        m_profiles.put(code_hash, profile);
+    }
+
+    const auto count = profile->count++;
+    if (count < m_threshold)
+    {
+        ++m_stats.baseline_executions;
+        return nullptr;
+    }
+
+    // The Advanced analysis depends on the EVM revision.
+    if (profile->analysis == nullptr || profile->rev != rev)
+    {
+        profile->analysis =
+            std::make_shared<const advanced::AdvancedCodeAnalysis>(advanced::analyze(rev, code));
+        profile->rev = rev;
+        ++m_stats.promotions;
+        if (m_promotion_handler)
+            m_promotion_handler(code_hash, rev, count + 1);
+    }
+
+    ++m_stats.advanced_executions;
+    return profile->analysis;
+}
+
+evmc_result Tiering::execute(const evmc_host_interface& host, evmc_host_context* ctx,
+    evmc_revision rev, const evmc_message& msg, bytes_view code,
+    const advanced::AdvancedCodeAnalysis& analysis) noexcept
+{
+    // Vector already has the capacity for all possible depths, so reallocation never happens.
+    // The execution states are lazily created because they pre-allocate EVM memory and stack.
+    const auto depth = static_cast<size_t>(msg.depth);
+    if (m_states.size() <= depth)
+        m_states.resize(depth + 1);
+    auto& state = m_states[depth];
+    if (state == nullptr)
+        state = std::make_unique<advanced::AdvancedExecutionState>();
+
+    state->reset(msg, rev, host, ctx, code);
+    return advanced::execute(*state, analysis);
+}
+}  // namespace evmone
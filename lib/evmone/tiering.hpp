@@ -0,0 +1,119 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "lru_cache.hpp"
+#include <evmc/evmc.hpp>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace evmone
+{
+using evmc::bytes_view;
+
+namespace advanced
+{
+struct AdvancedCodeAnalysis;
+struct AdvancedExecutionState;
+}  // namespace advanced
+
+/// The tiered execution policy.
+///
+/// Counts the executions of legacy code by the code hash. The code executed in the Baseline
+/// interpreter the threshold number of times is promoted to the Advanced interpreter:
+/// the more expensive Advanced analysis is performed once and cached for the next executions.
+/// The cold code keeps running in the Baseline interpreter.
+///
+/// The instance is owned by a single VM and is not thread-safe.
+class Tiering
+{
+public:
+    /// The tiering statistics.
+    struct Stats
+    {
+        uint64_t baseline_executions = 0;  ///< The number of recorded Baseline executions.
+        uint64_t advanced_executions = 0;  ///< The number of promoted code executions.
+        uint64_t promotions = 0;           ///< The number of code promotions.
+    };
+
+    /// The handler of the promotion events.
+    ///
+    /// It is called with the code hash, the EVM revision of the Advanced analysis
+    /// and the number of the code executions so far.
+    using PromotionHandler =
+        std::function<void(const evmc::bytes32& code_hash, evmc_revision rev, uint64_t count)>;
+
+    /// The default capacity of the code profiles.
+    static constexpr size_t default_capacity = 4096;
+
+private:
+    /// The execution profile of the code.
+    struct CodeProfile
+    {
+        /// The number of the code executions.
+        uint64_t count = 0;
+
+        /// The code size, to detect code hash collisions.
+        size_t code_size = 0;
+
+        /// The EVM revision of the Advanced analysis.
+        evmc_revision rev = {};
+
+        /// The Advanced analysis of the promoted code or nullptr.
+        std::shared_ptr<const advanced::AdvancedCodeAnalysis> analysis;
+    };
+
+    /// The number of executions after which the code is promoted.
+    const uint64_t m_threshold;
+
+    /// The code profiles by the code hash. The least recently executed code is evicted
+    /// together with its counter and the Advanced analysis.
+    LRUCache<evmc::bytes32, std::shared_ptr<CodeProfile>> m_profiles;
+
+    Stats m_stats;
+
+    PromotionHandler m_promotion_handler;
+
+    /// The reusable Advanced execution states, lazily created for each call depth.
+    std::vector<std::unique_ptr<advanced::AdvancedExecutionState>> m_states;
+
+public:
+    /// Creates the tiering policy.
+    ///
+    /// @param threshold  The number of Baseline executions after which the code is promoted.
+    ///                   It must not be 0.
+    /// @param capacity   The maximum number of profiled codes. It must not be 0.
+    explicit Tiering(uint64_t threshold, size_t capacity = default_capacity);
+
+    ~Tiering() noexcept;
+
+    /// The number of Baseline executions after which the code is promoted.
+    [[nodiscard]] uint64_t threshold() const noexcept { return m_threshold; }
+
+    /// Returns the tiering statistics.
+    [[nodiscard]] const Stats& stats() const noexcept { return m_stats; }
+
+    /// Returns the number of recorded executions of the code (0 if the code is not profiled).
+    [[nodiscard]] uint64_t get_execution_count(const evmc::bytes32& code_hash) noexcept;
+
+    /// Sets the handler called when a code is promoted.
+    void set_promotion_handler(PromotionHandler handler) noexcept
+    {
+        m_promotion_handler = std::move(handler);
+    }
+
+    /// Records the execution of the legacy code.
+    ///
+    /// @return  The Advanced analysis if the code is promoted and should be executed
+    ///          in the Advanced interpreter, nullptr otherwise.
+    [[nodiscard]] std::shared_ptr<const advanced::AdvancedCodeAnalysis> record_execution(
+        const evmc::bytes32& code_hash, evmc_revision rev, bytes_view code);
+
+    /// Executes the promoted code in the Advanced interpreter.
+    [[nodiscard]] evmc_result execute(const evmc_host_interface& host, evmc_host_context* ctx,
+        evmc_revision rev, const evmc_message& msg, bytes_view code,
+        const advanced::AdvancedCodeAnalysis& analysis) noexcept;
+};
+}  // namespace evmone
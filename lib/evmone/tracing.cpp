@@ -6,7 +6,11 @@
 #include "execution_state.hpp"
 #include "instructions_traits.hpp"
 #include <evmc/hex.hpp>
+#include <algorithm>
+#include <cassert>
+#include <map>
 #include <stack>
+#include <vector>
 
 namespace evmone
 {
@@ -19,6 +23,30 @@ std::string get_name(uint8_t opcode)
     return (name != nullptr) ? name : "0x" + evmc::hex(opcode);
 }
 
+/// Checks if the instruction will transfer control to a non-sequential position,
+/// i.e. it is a taken jump. The stack is inspected before the instruction is executed.
+bool is_jump_taken(
+    const uint8_t* code, uint32_t pc, const intx::uint256* stack_top, int stack_height) noexcept
+{
+    switch (code[pc])
+    {
+    case OP_JUMP:
+    case OP_RJUMP:
+    case OP_CALLF:
+    case OP_RETF:
+    case OP_JUMPF:
+        return true;
+    case OP_JUMPI:
+        return stack_height >= 2 && stack_top[-1] != 0;
+    case OP_RJUMPI:
+        return stack_height >= 1 && stack_top[0] != 0;
+    case OP_RJUMPV:  // The jump is taken if the index is in the range of the jump table.
+        return stack_height >= 1 && stack_top[0] <= code[pc + 1];
+    default:
+        return false;
+    }
+}
+
 /// @see create_histogram_tracer()
 class HistogramTracer : public Tracer
 {
@@ -28,11 +56,27 @@ class HistogramTracer : public Tracer
         const uint8_t* const code;
         uint32_t counts[256]{};
 
+        /// The counts of n-grams of sequentially executed instructions.
+        /// The key is the n-gram length in the high 32 bits and the packed opcodes in the low ones.
+        std::map<uint64_t, uint32_t> ngram_counts;
+
+        /// The packed opcodes of the last sequentially executed instructions.
+        uint32_t last_opcodes = 0;
+
+        /// The number of the last sequentially executed instructions (limited to the n-gram length).
+        size_t num_last_opcodes = 0;
+
+        /// Whether the previous instruction was a taken jump.
+        bool jump_taken = false;
+
         Context(int32_t _depth, const uint8_t* _code) noexcept : depth{_depth}, code{_code} {}
     };
 
+    static_assert(max_histogram_ngram_length == sizeof(Context::last_opcodes));
+
     std::stack<Context> m_contexts;
     std::ostream& m_out;
+    const size_t m_ngram_length;
 
     void on_execution_start(
         evmc_revision /*rev*/, const evmc_message& msg, bytes_view code) noexcept override
@@ -40,11 +84,31 @@ class HistogramTracer : public Tracer
         m_contexts.emplace(msg.depth, code.data());
     }
 
-    void on_instruction_start(uint32_t pc, const intx::uint256* /*stack_top*/, int /*stack_height*/,
+    void on_instruction_start(uint32_t pc, const intx::uint256* stack_top, int stack_height,
         int64_t /*gas*/, const ExecutionState& /*state*/) noexcept override
     {
         auto& ctx = m_contexts.top();
-        ++ctx.counts[ctx.code[pc]];
+        const auto opcode = ctx.code[pc];
+        ++ctx.counts[opcode];
+
+        if (m_ngram_length > 1)
+        {
+            // Only the sequentially executed instructions form n-grams, a taken jump breaks
+            // the sequence (also the jump to the next instruction).
+            if (ctx.jump_taken)
+                ctx.num_last_opcodes = 0;
+            ctx.jump_taken = is_jump_taken(ctx.code, pc, stack_top, stack_height);
+
+            ctx.last_opcodes = (ctx.last_opcodes << 8) | opcode;
+            ctx.num_last_opcodes = std::min(ctx.num_last_opcodes + 1, m_ngram_length);
+            for (size_t n = 2; n <= ctx.num_last_opcodes; ++n)
+            {
+                const auto mask = (n == sizeof(ctx.last_opcodes)) ? ~uint32_t{0} :
+                                                                    (uint32_t{1} << (n * 8)) - 1;
+                const auto packed = ctx.last_opcodes & mask;
+                ++ctx.ngram_counts[(uint64_t{n} << 32) | packed];
+            }
+        }
     }
 
     void on_execution_end(const evmc_result& /*result*/) noexcept override
@@ -58,11 +122,34 @@ class HistogramTracer : public Tracer
                 m_out << get_name(static_cast<uint8_t>(i)) << ',' << ctx.counts[i] << '\n';
         }
 
+        if (m_ngram_length > 1)
+        {
+            // Report the n-grams from the most frequent.
+            std::vector<std::pair<uint64_t, uint32_t>> ngrams{
+                ctx.ngram_counts.begin(), ctx.ngram_counts.end()};
+            std::ranges::stable_sort(
+                ngrams, std::ranges::greater{}, &std::pair<uint64_t, uint32_t>::second);
+
+            m_out << "--- # NGRAMS depth=" << ctx.depth << "\nngram,count\n";
+            for (const auto& [key, count] : ngrams)
+            {
+                const auto n = static_cast<size_t>(key >> 32);
+                for (size_t i = n; i > 0; --i)
+                {
+                    m_out << get_name(static_cast<uint8_t>(key >> ((i - 1) * 8)));
+                    m_out << (i != 1 ? ' ' : ',');
+                }
+                m_out << count << '\n';
+            }
+        }
+
         m_contexts.pop();
     }
 
 public:
-    explicit HistogramTracer(std::ostream& out) noexcept : m_out{out} {}
+    HistogramTracer(std::ostream& out, size_t ngram_length) noexcept
+      : m_out{out}, m_ngram_length{ngram_length}
+    {}
 };
 
 
@@ -137,9 +224,10 @@ public:
 };
 }  // namespace
 
-std::unique_ptr<Tracer> create_histogram_tracer(std::ostream& out)
+std::unique_ptr<Tracer> create_histogram_tracer(std::ostream& out, size_t ngram_length)
 {
-    return std::make_unique<HistogramTracer>(out);
+    assert(ngram_length >= 1 && ngram_length <= max_histogram_ngram_length);
+    return std::make_unique<HistogramTracer>(out, ngram_length);
 }
 
 std::unique_ptr<Tracer> create_instruction_tracer(std::ostream& out)
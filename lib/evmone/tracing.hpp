@@ -56,12 +56,22 @@ private:
     virtual void on_execution_end(const evmc_result& result) noexcept = 0;
 };
 
+/// The maximum n-gram length supported by the histogram tracer.
+constexpr size_t max_histogram_ngram_length = 4;
+
 /// Creates the "histogram" tracer which counts occurrences of individual opcodes during execution
 /// and reports this data in CSV format.
 ///
-/// @param out  Report output stream.
-/// @return     Histogram tracer object.
-EVMC_EXPORT std::unique_ptr<Tracer> create_histogram_tracer(std::ostream& out);
+/// Optionally, it also counts the n-grams (of length from 2 up to ngram_length) of sequentially
+/// executed instructions. These are the candidates for superinstructions
+/// (see baseline::fuse_instructions()).
+///
+/// @param out           Report output stream.
+/// @param ngram_length  The maximum length of reported n-grams, 1 disables n-grams reporting.
+///                      Must be in range [1, max_histogram_ngram_length].
+/// @return              Histogram tracer object.
+EVMC_EXPORT std::unique_ptr<Tracer> create_histogram_tracer(
+    std::ostream& out, size_t ngram_length = 1);
 
 EVMC_EXPORT std::unique_ptr<Tracer> create_instruction_tracer(std::ostream& out);
 
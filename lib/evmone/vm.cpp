@@ -8,9 +8,13 @@
 #include "vm.hpp"
 #include "advanced_execution.hpp"
 #include "baseline.hpp"
+#include "baseline_jit.hpp"
 #include <evmone/evmone.h>
+#include <evmone_precompiles/parallel.hpp>
 #include <cassert>
+#include <charconv>
 #include <iostream>
+#include <mutex>
 
 namespace evmone
 {
@@ -58,7 +62,16 @@ evmc_set_option_result set_option(evmc_vm* c_vm, char const* c_name, char const*
     }
     else if (name == "histogram")
     {
-        vm.add_tracer(create_histogram_tracer(std::clog));
+        size_t ngram_length = 1;
+        if (!value.empty())
+        {
+            const auto [end, ec] =
+                std::from_chars(value.data(), value.data() + value.size(), ngram_length);
+            if (ec != std::errc{} || end != value.data() + value.size() || ngram_length == 0 ||
+                ngram_length > max_histogram_ngram_length)
+                return EVMC_SET_OPTION_INVALID_VALUE;
+        }
+        vm.add_tracer(create_histogram_tracer(std::clog, ngram_length));
         return EVMC_SET_OPTION_SUCCESS;
     }
     else if (name == "validate_eof")
@@ -66,6 +79,88 @@ evmc_set_option_result set_option(evmc_vm* c_vm, char const* c_name, char const*
         vm.validate_eof = true;
         return EVMC_SET_OPTION_SUCCESS;
     }
+    else if (name == "fusion")
+    {
+        vm.fusion = true;
+        return EVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "block_check")
+    {
+        vm.block_check = true;
+        return EVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "analysis_cache" || name == "shared_analysis_cache")
+    {
+        size_t capacity = 0;
+        const auto [end, ec] = std::from_chars(value.data(), value.data() + value.size(), capacity);
+        if (value.empty() || ec != std::errc{} || end != value.data() + value.size())
+            return EVMC_SET_OPTION_INVALID_VALUE;
+        if (capacity == 0)
+            vm.set_code_cache(nullptr);
+        else if (name == "shared_analysis_cache")
+            vm.set_code_cache(CodeCache::get_shared(capacity));
+        else
+            vm.set_code_cache(std::make_shared<CodeCache>(capacity));
+        return EVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "jit")
+    {
+#if EVMONE_JIT_SUPPORTED
+        auto min_code_size = std::numeric_limits<size_t>::max();
+        if (!value.empty())
+        {
+            const auto [end, ec] =
+                std::from_chars(value.data(), value.data() + value.size(), min_code_size);
+            if (ec != std::errc{} || end != value.data() + value.size())
+                return EVMC_SET_OPTION_INVALID_VALUE;
+        }
+        vm.jit = true;
+        vm.jit_min_code_size = min_code_size;
+        return EVMC_SET_OPTION_SUCCESS;
+#else
+        return EVMC_SET_OPTION_INVALID_NAME;
+#endif
+    }
+    else if (name == "virtual_memory")
+    {
+        if (!Memory::virtual_supported())
+            return EVMC_SET_OPTION_INVALID_NAME;
+        vm.get_execution_state_pool().set_virtual_memory(true);
+        return EVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "tiering")
+    {
+        uint64_t threshold = 0;
+        const auto [end, ec] =
+            std::from_chars(value.data(), value.data() + value.size(), threshold);
+        if (value.empty() || ec != std::errc{} || end != value.data() + value.size())
+            return EVMC_SET_OPTION_INVALID_VALUE;
+        vm.set_tiering(threshold != 0 ? std::make_unique<Tiering>(threshold) : nullptr);
+        return EVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "analysis_store")
+    {
+        if (value.empty())
+        {
+            vm.set_analysis_store(nullptr);
+            return EVMC_SET_OPTION_SUCCESS;
+        }
+        auto store = baseline::AnalysisStore::load(std::string{value}.c_str());
+        if (!store)
+            return EVMC_SET_OPTION_INVALID_VALUE;
+        vm.set_analysis_store(std::move(store));
+        return EVMC_SET_OPTION_SUCCESS;
+    }
+    else if (name == "parallel_pairing")
+    {
+        unsigned num_threads = 0;
+        const auto [end, ec] =
+            std::from_chars(value.data(), value.data() + value.size(), num_threads);
+        if (value.empty() || ec != std::errc{} || end != value.data() + value.size())
+            return EVMC_SET_OPTION_INVALID_VALUE;
+        crypto::set_parallel_pairing(num_threads);
+        return EVMC_SET_OPTION_SUCCESS;
+    }
     return EVMC_SET_OPTION_INVALID_NAME;
 }
 
@@ -82,19 +177,21 @@ VM::VM() noexcept
         evmone::get_capabilities,
         evmone::set_option,
     }
-{
-    m_execution_states.reserve(1025);
-}
+{}
 
-ExecutionState& VM::get_execution_state(size_t depth) noexcept
+std::shared_ptr<CodeCache> CodeCache::get_shared(size_t capacity)
 {
-    // Vector already has the capacity for all possible depths,
-    // so reallocation never happens (therefore: noexcept).
-    // The ExecutionStates are lazily created because they pre-allocate EVM memory and stack.
-    assert(depth < m_execution_states.capacity());
-    if (m_execution_states.size() <= depth)
-        m_execution_states.resize(depth + 1);
-    return m_execution_states[depth];
+    static std::mutex shared_mutex;
+    static std::weak_ptr<CodeCache> shared_cache;
+
+    const std::lock_guard lock{shared_mutex};
+    auto cache = shared_cache.lock();
+    if (!cache)
+    {
+        cache = std::make_shared<CodeCache>(capacity);
+        shared_cache = cache;
+    }
+    return cache;
 }
 
 }  // namespace evmone
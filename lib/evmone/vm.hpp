@@ -3,10 +3,14 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
-#include "execution_state.hpp"
+#include "analysis_store.hpp"
+#include "code_cache.hpp"
+#include "execution_state_pool.hpp"
+#include "tiering.hpp"
 #include "tracing.hpp"
 #include <evmc/evmc.h>
-#include <vector>
+#include <limits>
+#include <memory>
 
 #if defined(_MSC_VER) && !defined(__clang__)
 #define EVMONE_CGOTO_SUPPORTED 0
@@ -22,15 +26,62 @@ class VM : public evmc_vm
 public:
     bool cgoto = EVMONE_CGOTO_SUPPORTED;
     bool validate_eof = false;
+    bool fusion = false;
+    bool block_check = false;
+    bool jit = false;
+
+    /// The minimal size of the code compiled by the JIT when its analysis is not cached.
+    /// By default, only the cached analyses (reused by later executions) are compiled.
+    size_t jit_min_code_size = std::numeric_limits<size_t>::max();
 
 private:
-    std::vector<ExecutionState> m_execution_states;
+    ExecutionStatePool m_execution_states;
     std::unique_ptr<Tracer> m_first_tracer;
+    std::shared_ptr<CodeCache> m_code_cache;
+    std::shared_ptr<const baseline::AnalysisStore> m_analysis_store;
+    std::unique_ptr<Tiering> m_tiering;
 
 public:
     VM() noexcept;
 
-    [[nodiscard]] ExecutionState& get_execution_state(size_t depth) noexcept;
+    [[nodiscard]] ExecutionState& get_execution_state(size_t depth) noexcept
+    {
+        return m_execution_states.get(depth);
+    }
+
+    /// Returns the pool of the execution states, e.g. to inspect its high-water statistics.
+    [[nodiscard]] ExecutionStatePool& get_execution_state_pool() noexcept
+    {
+        return m_execution_states;
+    }
+
+    /// Attaches the code cache, possibly shared with other VM instances.
+    /// The nullptr disables the cache.
+    void set_code_cache(std::shared_ptr<CodeCache> code_cache) noexcept
+    {
+        m_code_cache = std::move(code_cache);
+    }
+
+    /// Returns the code cache or nullptr if the cache is disabled.
+    [[nodiscard]] CodeCache* get_code_cache() const noexcept { return m_code_cache.get(); }
+
+    /// Attaches the persistent code analysis store. The nullptr detaches the store.
+    void set_analysis_store(std::shared_ptr<const baseline::AnalysisStore> store) noexcept
+    {
+        m_analysis_store = std::move(store);
+    }
+
+    /// Returns the code analysis store or nullptr if not attached.
+    [[nodiscard]] const baseline::AnalysisStore* get_analysis_store() const noexcept
+    {
+        return m_analysis_store.get();
+    }
+
+    /// Enables the tiered execution with the given policy. The nullptr disables the tiering.
+    void set_tiering(std::unique_ptr<Tiering> tiering) noexcept { m_tiering = std::move(tiering); }
+
+    /// Returns the tiered execution policy or nullptr if the tiering is disabled.
+    [[nodiscard]] Tiering* get_tiering() const noexcept { return m_tiering.get(); }
 
     void add_tracer(std::unique_ptr<Tracer> tracer) noexcept
     {
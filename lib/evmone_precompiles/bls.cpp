@@ -1,4 +1,5 @@
 #include "bls.hpp"
+#include "parallel.hpp"
 #include <blst.h>
 #include <memory>
 #include <optional>
@@ -89,6 +90,68 @@ void store(uint8_t _rx[128], const blst_fp2& _x) noexcept
     store(&_rx[64], _x.fp[1]);
 }
 
+/// The sizes of the encoded field elements and points of the pairing check input.
+constexpr auto FP_SIZE = 64;
+constexpr auto FP2_SIZE = 2 * FP_SIZE;
+constexpr auto P1_SIZE = 2 * FP_SIZE;
+constexpr auto P2_SIZE = 2 * FP2_SIZE;
+constexpr auto PAIR_SIZE = P1_SIZE + P2_SIZE;
+
+/// Validates the pairs and computes the product of their Miller loops.
+/// Returns std::nullopt if any of the pairs is invalid.
+[[nodiscard]] std::optional<blst_fp12> miller_loop_product(
+    const uint8_t* _pairs, size_t num_pairs) noexcept
+{
+    auto acc = *blst_fp12_one();
+    const auto pairs_end = _pairs + num_pairs * PAIR_SIZE;
+    for (auto ptr = _pairs; ptr != pairs_end; ptr += PAIR_SIZE)
+    {
+        const auto P_affine = validate_p1(ptr, &ptr[FP_SIZE]);
+        if (!P_affine.has_value())
+            return std::nullopt;
+
+        const auto Q_affine = validate_p2(&ptr[P1_SIZE], &ptr[P1_SIZE + FP2_SIZE]);
+        if (!Q_affine.has_value())
+            return std::nullopt;
+
+        if (!blst_p1_affine_in_g1(&*P_affine))
+            return std::nullopt;
+
+        if (!blst_p2_affine_in_g2(&*Q_affine))
+            return std::nullopt;
+
+        // Skip a pair containing any point at infinity.
+        if (blst_p1_affine_is_inf(&*P_affine) || blst_p2_affine_is_inf(&*Q_affine))
+            continue;
+
+        blst_fp12 ml_res;
+        blst_miller_loop(&ml_res, &*Q_affine, &*P_affine);
+        blst_fp12_mul(&acc, &acc, &ml_res);
+    }
+    return acc;
+}
+
+/// Computes the product of the Miller loops of the pairs split into num_tasks chunks
+/// processed in parallel. Returns std::nullopt if any of the pairs is invalid.
+[[nodiscard]] std::optional<blst_fp12> parallel_miller_loop_product(
+    const ParallelPairing& parallel, const uint8_t* _pairs, size_t num_pairs, size_t num_tasks)
+{
+    std::vector<std::optional<blst_fp12>> products(num_tasks);
+    parallel.run(num_tasks, [&](size_t i) {
+        const auto begin = i * num_pairs / num_tasks;
+        const auto end = (i + 1) * num_pairs / num_tasks;
+        products[i] = miller_loop_product(&_pairs[begin * PAIR_SIZE], end - begin);
+    });
+
+    auto acc = *blst_fp12_one();
+    for (const auto& product : products)
+    {
+        if (!product.has_value())
+            return std::nullopt;
+        blst_fp12_mul(&acc, &acc, &*product);
+    }
+    return acc;
+}
 }  // namespace
 
 [[nodiscard]] bool g1_add(uint8_t _rx[64], uint8_t _ry[64], const uint8_t _x0[64],
@@ -352,40 +415,19 @@ void store(uint8_t _rx[128], const blst_fp2& _x) noexcept
 
 [[nodiscard]] bool pairing_check(uint8_t _r[32], const uint8_t* _pairs, size_t size) noexcept
 {
-    static constexpr auto FP_SIZE = 64;
-    static constexpr auto FP2_SIZE = 2 * FP_SIZE;
-    static constexpr auto P1_SIZE = 2 * FP_SIZE;
-    static constexpr auto P2_SIZE = 2 * FP2_SIZE;
-    static constexpr auto PAIR_SIZE = P1_SIZE + P2_SIZE;
     assert(size % PAIR_SIZE == 0);
+    const auto num_pairs = size / PAIR_SIZE;
+
+    // The pairs are split into chunks processed in parallel if enabled.
+    const ParallelPairing parallel;
+    const auto num_tasks = parallel.num_tasks(num_pairs);
+    auto product =
+        num_tasks == 1 ? miller_loop_product(_pairs, num_pairs) :
+                         parallel_miller_loop_product(parallel, _pairs, num_pairs, num_tasks);
+    if (!product.has_value())
+        return false;
 
-    auto acc = *blst_fp12_one();
-    const auto pairs_end = _pairs + size;
-    for (auto ptr = _pairs; ptr != pairs_end; ptr += PAIR_SIZE)
-    {
-        const auto P_affine = validate_p1(ptr, &ptr[FP_SIZE]);
-        if (!P_affine.has_value())
-            return false;
-
-        const auto Q_affine = validate_p2(&ptr[P1_SIZE], &ptr[P1_SIZE + FP2_SIZE]);
-        if (!Q_affine.has_value())
-            return false;
-
-        if (!blst_p1_affine_in_g1(&*P_affine))
-            return false;
-
-        if (!blst_p2_affine_in_g2(&*Q_affine))
-            return false;
-
-        // Skip a pair containing any point at infinity.
-        if (blst_p1_affine_is_inf(&*P_affine) || blst_p2_affine_is_inf(&*Q_affine))
-            continue;
-
-        blst_fp12 ml_res;
-        blst_miller_loop(&ml_res, &*Q_affine, &*P_affine);
-        blst_fp12_mul(&acc, &acc, &ml_res);
-    }
-
+    auto& acc = *product;
     blst_final_exp(&acc, &acc);
     const auto result = blst_fp12_is_one(&acc);
     std::memset(_r, 0, 31);
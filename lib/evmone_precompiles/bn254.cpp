@@ -11,6 +11,19 @@ namespace
 constexpr ModArith Fp{FieldPrime};
 constexpr auto B = Fp.to_mont(3);
 constexpr auto B3 = Fp.to_mont(3 * 3);
+
+/// The GLV endomorphism of the curve: φ(x, y) = (βx, y) = [λ](x, y)
+/// for λ = 0x30644e72e131a029048b6e193fd84104cc37a73fec2bc5e9b8ca0b2d36636f23.
+constexpr ecc::GLVParams<uint256> GLV{
+    .order = Order,
+    .beta = Fp.to_mont(0x30644e72e131a0295e6dd9e7e0acccb0c28f069fbb966e3de4bd44e5607cfd48_u256),
+    .a1 = 0x6f4d8248eeb859fc8211bbeb7d4f1128_u256,
+    .b1 = 0 - 0x89d3256894d213e3_u256,
+    .a2 = 0x89d3256894d213e3_u256,
+    .b2 = 0x6f4d8248eeb859fd0be4e1541221250b_u256,
+    .g1 = 0x24ccef014a773d2d25398fd0300ff6565_u256,
+    .g2 = 0x2d91d232ec7e0b3d7_u256,
+};
 }  // namespace
 
 bool validate(const Point& pt) noexcept
@@ -20,8 +33,8 @@ bool validate(const Point& pt) noexcept
 
     const auto xm = Fp.to_mont(pt.x);
     const auto ym = Fp.to_mont(pt.y);
-    const auto y2 = Fp.mul(ym, ym);
-    const auto x2 = Fp.mul(xm, xm);
+    const auto y2 = Fp.sqr(ym);
+    const auto x2 = Fp.sqr(xm);
     const auto x3 = Fp.mul(x2, xm);
     const auto x3_3 = Fp.add(x3, B);
     return y2 == x3_3;
@@ -41,7 +54,7 @@ Point mul(const Point& pt, const uint256& c) noexcept
         return {};
 
     const Point p_mont{Fp.to_mont(pt.x), Fp.to_mont(pt.y)};
-    const auto pr = ecc::mul(Fp, p_mont, c, B3);
+    const auto pr = ecc::mul(Fp, p_mont, c % Order, B3, GLV);
 
     return ecc::to_affine(Fp, pr);
 }
@@ -16,6 +16,10 @@ using namespace intx;
 inline constexpr auto FieldPrime =
     0x30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47_u256;
 
+/// The bn254 curve group order (N).
+inline constexpr auto Order =
+    0x30644e72e131a029b85045b68181585d2833e84879b9709143e1f593f0000001_u256;
+
 using Point = ecc::Point<uint256>;
 /// Note that real part of G2 value goes first and imaginary part is the second. i.e (a + b*i)
 /// The pairing check precompile EVM ABI presumes that imaginary part goes first.
@@ -44,4 +48,22 @@ Point mul(const Point& pt, const uint256& c) noexcept;
 ///               std::nullopt on error.
 std::optional<bool> pairing_check(std::span<const std::pair<Point, ExtPoint>> pairs) noexcept;
 
+/// The statistics of the G2 precomputation cache of pairing_check().
+struct G2CacheStats
+{
+    uint64_t hits = 0;    ///< The number of G2 points found in the cache.
+    uint64_t misses = 0;  ///< The number of G2 points validated and precomputed.
+};
+
+/// Returns the statistics of the G2 precomputation cache.
+///
+/// The pairing_check() caches the Miller loop line coefficients of the valid G2 points
+/// (keyed by the point coordinates) because the same G2 points (e.g. from verifying keys
+/// of zk proofs) are used repeatedly. The cache hit skips the G2 point validation
+/// (including the subgroup check) and all the G2 arithmetic of the Miller loop.
+G2CacheStats get_g2_cache_stats() noexcept;
+
+/// Clears the G2 precomputation cache and resets its statistics.
+void clear_g2_cache() noexcept;
+
 }  // namespace evmmax::bn254
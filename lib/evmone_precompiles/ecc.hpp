@@ -4,6 +4,9 @@
 #pragma once
 
 #include <evmmax/evmmax.hpp>
+#include <algorithm>
+#include <array>
+#include <span>
 
 namespace evmmax::ecc
 {
@@ -72,6 +75,37 @@ struct JacPoint
 template <typename IntT>
 using InvFn = IntT (*)(const ModArith<IntT>&, const IntT& x) noexcept;
 
+/// Computes the modular inversions of multiple values in Montgomery form.
+///
+/// Uses the Montgomery's trick: a single inversion and 3(n-1) multiplications.
+/// All the values must be invertible.
+///
+/// @param values   The values to be replaced with their inversions.
+/// @param scratch  The scratch space of at least the values' size.
+template <typename IntT>
+inline void batch_inv(
+    const ModArith<IntT>& m, std::span<IntT> values, std::span<IntT> scratch) noexcept
+{
+    assert(scratch.size() >= values.size());
+    if (values.empty())
+        return;
+
+    // Compute the prefix products.
+    scratch[0] = values[0];
+    for (size_t i = 1; i < values.size(); ++i)
+        scratch[i] = m.mul(scratch[i - 1], values[i]);
+
+    // Invert the product of all values and then peel off the values one by one.
+    auto inv = m.inv(scratch[values.size() - 1]);
+    for (size_t i = values.size() - 1; i != 0; --i)
+    {
+        const auto value_inv = m.mul(inv, scratch[i - 1]);
+        inv = m.mul(inv, values[i]);
+        values[i] = value_inv;
+    }
+    values[0] = inv;
+}
+
 /// Converts an affine point to a projected point with coordinates in Montgomery form.
 template <typename IntT>
 inline ProjPoint<IntT> to_proj(const ModArith<IntT>& s, const Point<IntT>& p) noexcept
@@ -117,13 +151,13 @@ Point<IntT> add(const ModArith<IntT>& m, const Point<IntT>& p, const Point<IntT>
             return {};  // return the point at infinity.
 
         // For coincident points find the slope of the tangent line.
-        const auto xx = m.mul(x1, x1);
+        const auto xx = m.sqr(x1);
         dy = m.add(m.add(xx, xx), xx);
         dx = m.add(y1, y1);
     }
     const auto slope = m.mul(dy, m.inv(dx));
 
-    const auto xr = m.sub(m.sub(m.mul(slope, slope), x1), x2);
+    const auto xr = m.sub(m.sub(m.sqr(slope), x1), x2);
     const auto yr = m.sub(m.mul(m.sub(x1, xr), slope), y1);
     return {m.from_mont(xr), m.from_mont(yr)};
 }
@@ -271,12 +305,12 @@ ProjPoint<IntT> dbl(
     IntT t1;
     IntT t2;
 
-    t0 = s.mul(y, y);    // 1
+    t0 = s.sqr(y);       // 1
     z3 = s.add(t0, t0);  // 2
     z3 = s.add(z3, z3);  // 3
     z3 = s.add(z3, z3);  // 4
     t1 = s.mul(y, z);    // 5
-    t2 = s.mul(z, z);    // 6
+    t2 = s.sqr(z);       // 6
     t2 = s.mul(b3, t2);  // 7
     x3 = s.mul(t2, z3);  // 8
     y3 = s.add(t0, t2);  // 9
@@ -293,18 +327,228 @@ ProjPoint<IntT> dbl(
     return {x3, y3, z3};
 }
 
+/// Negates the point with coordinates in Montgomery form.
 template <typename IntT>
-ProjPoint<IntT> mul(
-    const ModArith<IntT>& m, const Point<IntT>& p, const IntT& c, const IntT& b3) noexcept
+inline Point<IntT> negate(const ModArith<IntT>& m, const Point<IntT>& p) noexcept
+{
+    return {p.x, m.sub(0, p.y)};
+}
+
+/// Negates the projected point with coordinates in Montgomery form.
+template <typename IntT>
+inline ProjPoint<IntT> negate(const ModArith<IntT>& m, const ProjPoint<IntT>& p) noexcept
+{
+    return {p.x, m.sub(0, p.y), p.z};
+}
+
+/// The default width of the wNAF representation of scalars.
+inline constexpr unsigned WNAF_WIDTH = 5;
+
+/// The number of the odd multiples [1]P, [3]P, ..., [2^(w-1) - 1]P used with the wNAF of width w.
+constexpr size_t wnaf_table_size(unsigned w) noexcept
+{
+    return size_t{1} << (w - 2);
+}
+
+/// Computes the width-W non-adjacent form (wNAF) of the scalar.
+///
+/// The scalar is represented as c = Σ d_i·2^i where the non-zero digits d_i are odd,
+/// |d_i| < 2^(W-1) and at most one of any W consecutive digits is non-zero.
+///
+/// @param naf  The output digits, the least significant first. Must fit the bit width of c
+///             plus one digits.
+/// @param c    The scalar.
+/// @param neg  If true, the digits of -c are computed instead.
+/// @return     The number of digits.
+template <unsigned W, typename IntT>
+inline size_t wnaf(std::span<int8_t> naf, IntT c, bool neg = false) noexcept
+{
+    static_assert(W >= 2 && W <= 8, "the wNAF digits must fit int8_t");
+    constexpr int WINDOW_MASK = (1 << W) - 1;
+    constexpr int WINDOW_HALF = 1 << (W - 1);
+
+    size_t len = 0;
+    while (c != 0)
+    {
+        int d = 0;
+        bool overflow = false;
+        if ((static_cast<uint64_t>(c) & 1) != 0)
+        {
+            d = static_cast<int>(static_cast<uint64_t>(c) & WINDOW_MASK);
+            if (d >= WINDOW_HALF)
+            {
+                // The negative digit: add the complement to clear the window bits. The addition
+                // may carry out of the most significant bit of the scalar type.
+                d -= 1 << W;
+                const auto sum = c + static_cast<uint64_t>(-d);
+                overflow = sum < c;
+                c = sum;
+            }
+            else
+                c -= static_cast<uint64_t>(d);
+        }
+        assert(len < naf.size());
+        naf[len++] = static_cast<int8_t>(neg ? -d : d);
+        c >>= 1;
+        if (overflow)
+            c |= IntT{1} << (IntT::num_bits - 1);
+    }
+    return len;
+}
+
+/// Computes the odd multiples [1]P, [3]P, [5]P, ... of the point filling the whole table.
+template <typename IntT>
+inline void odd_multiples(const ModArith<IntT>& m, const ProjPoint<IntT>& p,
+    std::span<ProjPoint<IntT>> table, const IntT& b3) noexcept
+{
+    const auto p2 = ecc::dbl(m, p, b3);
+    table[0] = p;
+    for (size_t i = 1; i < table.size(); ++i)
+        table[i] = ecc::add(m, table[i - 1], p2, b3);
+}
+
+/// Computes the sum of the scalar multiplications [c_1]P_1 + ... + [c_N]P_N
+/// with the interleaved wNAF method: the doublings are shared by all the multiplications
+/// and every non-zero wNAF digit d of c_i adds the precomputed [d]P_i.
+///
+/// @param tables  The tables of the odd multiples of the points (see odd_multiples()),
+///                large enough for the widths of the wNAFs.
+/// @param nafs    The wNAF digits of the scalars (see wnaf()).
+template <typename IntT, typename PointT, size_t N>
+ProjPoint<IntT> mul_wnaf(const ModArith<IntT>& m,
+    const std::array<std::span<const PointT>, N>& tables,
+    const std::array<std::span<const int8_t>, N>& nafs, const IntT& b3) noexcept
 {
+    size_t len = 0;
+    for (const auto& naf : nafs)
+        len = std::max(len, naf.size());
+
     ProjPoint<IntT> r;
-    const auto bit_width = sizeof(IntT) * 8 - intx::clz(c);
-    for (auto i = bit_width; i != 0; --i)
+    for (auto i = len; i != 0; --i)
     {
         r = ecc::dbl(m, r, b3);
-        if ((c & (IntT{1} << (i - 1))) != 0)  // if the i-th bit in the scalar is set
-            r = ecc::add(m, r, p, b3);
+        for (size_t j = 0; j < N; ++j)
+        {
+            if (i > nafs[j].size())
+                continue;
+            if (const auto d = nafs[j][i - 1]; d > 0)
+                r = ecc::add(m, r, tables[j][static_cast<size_t>(d / 2)], b3);
+            else if (d < 0)
+                r = ecc::add(m, r, negate(m, tables[j][static_cast<size_t>(-d / 2)]), b3);
+        }
     }
     return r;
 }
+
+/// Computes the scalar multiplication [c]P of the point with coordinates in Montgomery form
+/// using the wNAF of width WNAF_WIDTH.
+template <typename IntT>
+ProjPoint<IntT> mul(
+    const ModArith<IntT>& m, const Point<IntT>& p, const IntT& c, const IntT& b3) noexcept
+{
+    std::array<ProjPoint<IntT>, wnaf_table_size(WNAF_WIDTH)> table;
+    odd_multiples(m, {p.x, p.y, m.to_mont(1)}, std::span<ProjPoint<IntT>>{table}, b3);
+
+    std::array<int8_t, IntT::num_bits + 1> naf;
+    const auto len = wnaf<WNAF_WIDTH>(naf, c);
+
+    return mul_wnaf<IntT, ProjPoint<IntT>, 1>(m, {std::span<const ProjPoint<IntT>>{table}},
+        {std::span<const int8_t>{naf}.first(len)}, b3);
+}
+
+/// The parameters of the GLV endomorphism φ(x, y) = (βx, y) of the curve of the prime order n.
+/// The endomorphism acts as the scalar multiplication by λ: φ(P) = [λ]P.
+///
+/// R. Gallant, R. Lambert, S. Vanstone,
+/// "Faster Point Multiplication on Elliptic Curves with Efficient Endomorphisms", CRYPTO 2001.
+template <typename IntT>
+struct GLVParams
+{
+    /// The group order n.
+    IntT order;
+
+    /// The non-trivial cube root of unity β in the base field in Montgomery form.
+    IntT beta;
+
+    /// The short basis {(a1, b1), (a2, b2)} of the lattice of the decompositions of zero:
+    /// a + b·λ ≡ 0 (mod n). Negative values are in two's complement.
+    IntT a1;
+    IntT b1;
+    IntT a2;
+    IntT b2;
+
+    /// The rounded fractions g1 = round(2^N·b2 / n) and g2 = round(-2^N·b1 / n)
+    /// where N is the bit width of IntT.
+    IntT g1;
+    IntT g2;
+};
+
+/// The scalar of the GLV decomposition: the absolute value and the sign.
+template <typename IntT>
+struct GLVScalar
+{
+    IntT value;
+    bool neg = false;
+};
+
+/// The maximum bit width of the GLV decomposition scalars.
+/// The decomposition scalars are bounded by the norms of the lattice basis vectors
+/// which are around √n.
+template <typename IntT>
+inline constexpr unsigned glv_max_bits = IntT::num_bits / 2 + 2;
+
+/// Splits the scalar k < n into k1 + k2·λ ≡ k (mod n) where k1 and k2 are of about half
+/// of the bit width of n.
+template <typename IntT>
+constexpr std::array<GLVScalar<IntT>, 2> glv_decompose(
+    const GLVParams<IntT>& glv, const IntT& k) noexcept
+{
+    assert(k < glv.order);
+    constexpr auto N = IntT::num_bits;
+
+    // Computes round(k·g / 2^N).
+    const auto round_mul = [&k](const IntT& g) noexcept {
+        const auto q = intx::umul(k, g) >> (N - 1);
+        return static_cast<IntT>((q + 1) >> 1);
+    };
+    const auto c1 = round_mul(glv.g1);
+    const auto c2 = round_mul(glv.g2);
+
+    // The computations are modulo 2^N but the results are small signed numbers.
+    const auto to_scalar = [](const IntT& x) noexcept {
+        const auto neg = (x >> (N - 1)) != 0;
+        return GLVScalar<IntT>{neg ? -x : x, neg};
+    };
+    const auto k1 = k - c1 * glv.a1 - c2 * glv.a2;
+    const auto k2 = IntT{0} - c1 * glv.b1 - c2 * glv.b2;
+    return {to_scalar(k1), to_scalar(k2)};
+}
+
+/// Computes the scalar multiplication [c]P of the point with coordinates in Montgomery form
+/// using the GLV endomorphism: [c]P = [k1]P + [k2]φ(P) with the half-width scalars k1 and k2.
+/// The scalar must be less than the group order.
+template <typename IntT>
+ProjPoint<IntT> mul(const ModArith<IntT>& m, const Point<IntT>& p, const IntT& c,
+    const IntT& b3, const GLVParams<IntT>& glv) noexcept
+{
+    constexpr auto TABLE_SIZE = wnaf_table_size(WNAF_WIDTH);
+    std::array<ProjPoint<IntT>, TABLE_SIZE> table;
+    odd_multiples(m, {p.x, p.y, m.to_mont(1)}, std::span<ProjPoint<IntT>>{table}, b3);
+
+    // φ(X:Y:Z) = (βX:Y:Z).
+    std::array<ProjPoint<IntT>, TABLE_SIZE> endo_table;
+    for (size_t i = 0; i < TABLE_SIZE; ++i)
+        endo_table[i] = {m.mul(glv.beta, table[i].x), table[i].y, table[i].z};
+
+    const auto [k1, k2] = glv_decompose(glv, c);
+    std::array<int8_t, glv_max_bits<IntT> + 1> naf1;
+    std::array<int8_t, glv_max_bits<IntT> + 1> naf2;
+    const auto len1 = wnaf<WNAF_WIDTH>(naf1, k1.value, k1.neg);
+    const auto len2 = wnaf<WNAF_WIDTH>(naf2, k2.value, k2.neg);
+
+    return mul_wnaf<IntT, ProjPoint<IntT>, 2>(m,
+        {std::span<const ProjPoint<IntT>>{table}, std::span<const ProjPoint<IntT>>{endo_table}},
+        {std::span<const int8_t>{naf1}.first(len1), std::span<const int8_t>{naf2}.first(len2)},
+        b3);
+}
 }  // namespace evmmax::ecc
@@ -295,6 +295,85 @@ static void keccakf1600_generic(uint64_t state[25])
 /// selected during runtime initialization.
 static void (*keccakf1600_best)(uint64_t[25]) = keccakf1600_generic;
 
+#if defined(__GNUC__)
+/// The number of independent Keccak-f[1600] states processed together by the multi-buffer
+/// implementation.
+#define KECCAK_LANES 4
+
+/// The vector of the same 64-bit word of KECCAK_LANES independent Keccak states.
+typedef uint64_t keccak_lanes __attribute__((vector_size(KECCAK_LANES * sizeof(uint64_t))));
+
+/// The rotation offsets of the rho step, indexed by the word position.
+static const unsigned rho_offsets[25] = {
+    0, 1, 62, 28, 27, 36, 44, 6, 55, 20, 3, 10, 43, 25, 39, 41, 45, 15, 21, 8, 18, 2, 61, 56, 14};
+
+/// The destination word positions of the pi step, indexed by the word position.
+static const unsigned pi_positions[25] = {
+    0, 10, 20, 5, 15, 16, 1, 11, 21, 6, 7, 17, 2, 12, 22, 23, 8, 18, 3, 13, 14, 24, 9, 19, 4};
+
+/// Rotates the bits of all lanes of X left by S.
+/// This is a macro because passing wide vectors by value depends on the instruction set.
+#define rol_lanes(X, S) (((X) << (S)) | ((X) >> (64 - (S))))
+
+/// The multi-buffer Keccak-f[1600] function.
+///
+/// Performs the Keccak-f[1600] permutation of KECCAK_LANES independent states at once.
+/// The states are interleaved: state[i] contains the i-th words of all the states.
+/// The implementation uses the compiler vector extensions so it is vectorized
+/// with the instruction set selected for the enclosing function.
+static inline ALWAYS_INLINE void keccakf1600x_implementation(keccak_lanes state[25])
+{
+    keccak_lanes B[25];
+    keccak_lanes C[5];
+    keccak_lanes D;
+
+    for (size_t n = 0; n < 24; ++n)
+    {
+        // The inner loops must be unrolled to have the word positions and rotations constant.
+
+        // Theta.
+#pragma GCC unroll 5
+        for (size_t x = 0; x < 5; ++x)
+            C[x] = state[x] ^ state[x + 5] ^ state[x + 10] ^ state[x + 15] ^ state[x + 20];
+#pragma GCC unroll 5
+        for (size_t x = 0; x < 5; ++x)
+        {
+            D = C[(x + 4) % 5] ^ rol_lanes(C[(x + 1) % 5], 1);
+#pragma GCC unroll 5
+            for (size_t y = 0; y < 25; y += 5)
+                state[y + x] ^= D;
+        }
+
+        // Rho and pi.
+        B[0] = state[0];
+#pragma GCC unroll 24
+        for (size_t i = 1; i < 25; ++i)
+            B[pi_positions[i]] = rol_lanes(state[i], rho_offsets[i]);
+
+        // Chi.
+#pragma GCC unroll 5
+        for (size_t y = 0; y < 25; y += 5)
+        {
+#pragma GCC unroll 5
+            for (size_t x = 0; x < 5; ++x)
+                state[y + x] = B[y + x] ^ (~B[y + (x + 1) % 5] & B[y + (x + 2) % 5]);
+        }
+
+        // Iota.
+        state[0] ^= round_constants[n];
+    }
+}
+
+static void keccakf1600x_generic(keccak_lanes state[25])
+{
+    keccakf1600x_implementation(state);
+}
+
+/// The pointer to the best multi-buffer Keccak-f[1600] function implementation,
+/// selected during runtime initialization.
+static void (*keccakf1600x_best)(keccak_lanes[25]) = keccakf1600x_generic;
+#endif
+
 
 #if !defined(_MSC_VER) && defined(__x86_64__) && __has_attribute(target)
 __attribute__((target("bmi,bmi2"))) static void keccakf1600_bmi(uint64_t state[25])
@@ -302,6 +381,17 @@ __attribute__((target("bmi,bmi2"))) static void keccakf1600_bmi(uint64_t state[2
     keccakf1600_implementation(state);
 }
 
+__attribute__((target("avx2"))) static void keccakf1600x_avx2(keccak_lanes state[25])
+{
+    keccakf1600x_implementation(state);
+}
+
+__attribute__((target("avx512f,avx512vl"))) static void keccakf1600x_avx512(
+    keccak_lanes state[25])
+{
+    keccakf1600x_implementation(state);
+}
+
 __attribute__((constructor)) static void select_keccakf1600_implementation(void)
 {
     // Init CPU information.
@@ -312,6 +402,12 @@ __attribute__((constructor)) static void select_keccakf1600_implementation(void)
     // report BMI2 but not BMI being available.
     if (__builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2"))
         keccakf1600_best = keccakf1600_bmi;
+
+    // AVX-512 is used for the native vector rotations and the 32 vector registers.
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512vl"))
+        keccakf1600x_best = keccakf1600x_avx512;
+    else if (__builtin_cpu_supports("avx2"))
+        keccakf1600x_best = keccakf1600x_avx2;
 }
 #endif
 
@@ -384,3 +480,89 @@ union ethash_hash256 ethash_keccak256_32(const uint8_t data[32])
     keccak(hash.word64s, 256, data, 32);
     return hash;
 }
+
+#if defined(__GNUC__)
+/// Computes Keccak-256 hashes of up to KECCAK_LANES inputs with the multi-buffer Keccak-f[1600].
+///
+/// The inputs may have different sizes: the states of the inputs having fewer blocks
+/// are still permuted, but their hashes are taken right after absorbing their last blocks.
+static void keccak256_lanes(
+    union ethash_hash256* out, const uint8_t* const* data, const size_t* sizes, size_t n)
+{
+    static const size_t word_size = sizeof(uint64_t);
+    static const size_t hash_size = 256 / 8;
+    static const size_t block_size = (1600 - 256 * 2) / 8;
+
+    size_t i;
+    size_t lane;
+    size_t b;
+    size_t num_blocks[KECCAK_LANES];
+    size_t max_num_blocks = 0;
+
+    keccak_lanes state[25];
+    __builtin_memset(state, 0, sizeof(state));
+
+    for (lane = 0; lane < n; ++lane)
+    {
+        // The last block contains at least the padding.
+        num_blocks[lane] = sizes[lane] / block_size + 1;
+        if (num_blocks[lane] > max_num_blocks)
+            max_num_blocks = num_blocks[lane];
+    }
+
+    for (b = 0; b < max_num_blocks; ++b)
+    {
+        for (lane = 0; lane < n; ++lane)
+        {
+            if (b + 1 < num_blocks[lane])
+            {
+                const uint8_t* block = data[lane] + b * block_size;
+                for (i = 0; i < (block_size / word_size); ++i)
+                    state[i][lane] ^= load_le(&block[i * word_size]);
+            }
+            else if (b + 1 == num_blocks[lane])
+            {
+                uint8_t last_block[(1600 - 256 * 2) / 8] = {0};
+                const size_t size = sizes[lane] - b * block_size;
+                if (size != 0)
+                    __builtin_memcpy(last_block, data[lane] + b * block_size, size);
+                last_block[size] = 0x01;
+                last_block[block_size - 1] |= 0x80;
+
+                for (i = 0; i < (block_size / word_size); ++i)
+                    state[i][lane] ^= load_le(&last_block[i * word_size]);
+            }
+        }
+
+        keccakf1600x_best(state);
+
+        for (lane = 0; lane < n; ++lane)
+        {
+            if (b + 1 == num_blocks[lane])
+            {
+                for (i = 0; i < (hash_size / word_size); ++i)
+                    out[lane].word64s[i] = to_le64(state[i][lane]);
+            }
+        }
+    }
+}
+#endif
+
+void ethash_keccak256_batch(union ethash_hash256 out[], const uint8_t* const data[],
+    const size_t sizes[], size_t n)
+{
+#if defined(__GNUC__)
+    while (n >= 2)
+    {
+        const size_t num_lanes = n < KECCAK_LANES ? n : KECCAK_LANES;
+        keccak256_lanes(out, data, sizes, num_lanes);
+        out += num_lanes;
+        data += num_lanes;
+        sizes += num_lanes;
+        n -= num_lanes;
+    }
+#endif
+
+    for (; n > 0; --n)
+        *out++ = ethash_keccak256(*data++, *sizes++);
+}
@@ -19,6 +19,13 @@ extern "C" {
 union ethash_hash256 ethash_keccak256(const uint8_t* data, size_t size) noexcept;
 union ethash_hash256 ethash_keccak256_32(const uint8_t data[32]) noexcept;
 
+/// Computes the Keccak-256 hashes of n independent inputs: out[i] = keccak256(data[i], sizes[i]).
+///
+/// The inputs are hashed together with the multi-buffer Keccak-f[1600] implementation
+/// so this is faster than hashing the inputs one by one.
+void ethash_keccak256_batch(union ethash_hash256 out[], const uint8_t* const data[],
+    const size_t sizes[], size_t n) noexcept;
+
 #ifdef __cplusplus
 }
 #endif
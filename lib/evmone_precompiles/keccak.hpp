@@ -20,4 +20,6 @@ inline hash256 keccak256(const hash256& input) noexcept
 
 static constexpr auto keccak256_32 = ethash_keccak256_32;
 
+static constexpr auto keccak256_batch = ethash_keccak256_batch;
+
 }  // namespace ethash
@@ -5,6 +5,7 @@
 #include "modexp.hpp"
 #include <evmmax/evmmax.hpp>
 #include <bit>
+#include <vector>
 
 using namespace intx;
 
@@ -34,22 +35,78 @@ constexpr unsigned ctz(const intx::uint<N>& x) noexcept
     return tz;
 }
 
+/// Selects the sliding window size for the exponent of the given bit width.
+///
+/// The thresholds minimize the number of multiplications: the precomputed table has
+/// 2^(w-1) entries and each window of w bits requires a single multiplication.
+constexpr unsigned select_window_size(size_t exp_bit_width) noexcept
+{
+    if (exp_bit_width > 671)
+        return 6;
+    if (exp_bit_width > 239)
+        return 5;
+    if (exp_bit_width > 79)
+        return 4;
+    if (exp_bit_width > 23)
+        return 3;
+    return 1;
+}
+
 template <typename UIntT>
 UIntT modexp_odd(const UIntT& base, std::span<const uint8_t> exp, const UIntT& mod) noexcept
 {
     const evmmax::ModArith<UIntT> arith{mod};
     const auto base_mont = arith.to_mont(base);
 
+    // The exponent has the leading zero bytes stripped.
+    assert(exp.empty() || exp[0] != 0);
+    const auto exp_bit_width =
+        exp.empty() ? 0 : exp.size() * 8 - static_cast<size_t>(std::countl_zero(exp[0]));
+    const auto get_bit = [exp](size_t index) noexcept {
+        return (exp[exp.size() - 1 - index / 8] >> (index % 8)) & 1;
+    };
+
+    // Precompute the odd powers of the base: base^1, base^3, ..., base^(2^w - 1).
+    const auto window_size = select_window_size(exp_bit_width);
+    std::vector<UIntT> odd_powers(size_t{1} << (window_size - 1));
+    odd_powers[0] = base_mont;
+    if (odd_powers.size() > 1)
+    {
+        const auto base_sqr = arith.sqr(base_mont);
+        for (size_t i = 1; i < odd_powers.size(); ++i)
+            odd_powers[i] = arith.mul(odd_powers[i - 1], base_sqr);
+    }
+
+    // Left-to-right sliding window exponentiation. The windows start and end with 1 bit.
     auto ret = arith.to_mont(1);
-    for (const auto e : exp)
+    bool ret_is_one = true;
+    for (auto i = exp_bit_width; i != 0;)
     {
-        for (size_t i = 8; i != 0; --i)
+        const auto top = i - 1;
+        if (get_bit(top) == 0)
         {
-            ret = arith.mul(ret, ret);
-            const auto bit = (e >> (i - 1)) & 1;
-            if (bit != 0)
-                ret = arith.mul(ret, base_mont);
+            if (!ret_is_one)
+                ret = arith.sqr(ret);
+            i = top;
+            continue;
         }
+
+        auto bottom = top + 1 >= window_size ? top + 1 - window_size : 0;
+        while (get_bit(bottom) == 0)
+            ++bottom;
+
+        size_t window = 0;
+        for (auto j = top + 1; j != bottom; --j)
+        {
+            window = (window << 1) | get_bit(j - 1);
+            if (!ret_is_one)
+                ret = arith.sqr(ret);
+        }
+
+        const auto& power = odd_powers[window >> 1];
+        ret = ret_is_one ? power : arith.mul(ret, power);
+        ret_is_one = false;
+        i = bottom;
     }
 
     return arith.from_mont(ret);
@@ -59,15 +59,57 @@ struct Fq12Config
 };
 using Fq12 = ecc::ExtFieldElem<Fq12Config>;
 
-/// Multiplies two Fq^2 field elements
-constexpr Fq2 multiply(const Fq2& a, const Fq2& b)
+/// Computes the sum of products of Fq^2 field elements a[0]⋅b[0] + ... + a[N-1]⋅b[N-1].
+///
+/// Lazy reduction: each base field coefficient is reduced once. Both coefficients are
+/// computed as differences of two sums of N unreduced products: the imaginary part
+/// a₀⋅b₁ + a₁⋅b₀ as a₀⋅b₁ - (-a₁)⋅b₀. Each sum must be below p⋅R to be reduced,
+/// what holds for N ≤ 5 because 5⋅p < R for the 254-bit prime.
+template <size_t N>
+constexpr Fq2 sum_of_products(const std::array<Fq2, N>& a, const std::array<Fq2, N>& b)
 {
+    static_assert(N >= 1 && N <= 5);
+    constexpr auto& Fp = BaseFieldConfig::MOD_ARITH;
+
+    auto re_pos = Fp.mul_wide(a[0].coeffs[0].value(), b[0].coeffs[0].value());
+    auto re_neg = Fp.mul_wide(a[0].coeffs[1].value(), b[0].coeffs[1].value());
+    auto im_pos = Fp.mul_wide(a[0].coeffs[0].value(), b[0].coeffs[1].value());
+    auto im_neg = Fp.mul_wide((-a[0].coeffs[1]).value(), b[0].coeffs[0].value());
+    for (size_t i = 1; i < N; ++i)
+    {
+        const auto& x = a[i].coeffs;
+        const auto& y = b[i].coeffs;
+        re_pos = Fp.add_wide(re_pos, Fp.mul_wide(x[0].value(), y[0].value()));
+        re_neg = Fp.add_wide(re_neg, Fp.mul_wide(x[1].value(), y[1].value()));
+        im_pos = Fp.add_wide(im_pos, Fp.mul_wide(x[0].value(), y[1].value()));
+        im_neg = Fp.add_wide(im_neg, Fp.mul_wide((-x[1]).value(), y[0].value()));
+    }
     return Fq2({
-        a.coeffs[0] * b.coeffs[0] - a.coeffs[1] * b.coeffs[1],
-        a.coeffs[1] * b.coeffs[0] + a.coeffs[0] * b.coeffs[1],
+        Fq(Fp.reduce(Fp.sub_wide(re_pos, re_neg))),
+        Fq(Fp.reduce(Fp.sub_wide(im_pos, im_neg))),
     });
 }
 
+/// Multiplies two Fq^2 field elements
+constexpr Fq2 multiply(const Fq2& a, const Fq2& b)
+{
+    return sum_of_products<1>({a}, {b});
+}
+
+/// Multiplies the Fq^2 field element by ksi = 9 + u using only additions:
+/// (9 + u)⋅(a₀ + a₁⋅u) = (9⋅a₀ - a₁) + (a₀ + 9⋅a₁)⋅u.
+constexpr Fq2 multiply_by_ksi(const Fq2& a)
+{
+    const auto times_9 = [](const Fq& x) {
+        const auto x2 = x + x;
+        const auto x4 = x2 + x2;
+        return x4 + x4 + x;
+    };
+    const auto& a0 = a.coeffs[0];
+    const auto& a1 = a.coeffs[1];
+    return Fq2({times_9(a0) - a1, a0 + times_9(a1)});
+}
+
 /// Multiplies two Fq^6 field elements
 constexpr Fq6 multiply(const Fq6& a, const Fq6& b)
 {
@@ -78,17 +120,17 @@ constexpr Fq6 multiply(const Fq6& a, const Fq6& b)
     const auto& b1 = b.coeffs[1];
     const auto& b2 = b.coeffs[2];
 
-    const Fq2& ksi = Fq6Config::ksi;
+    // The schoolbook multiplication with v^3 = ksi. Each coefficient is the sum of three
+    // Fq^2 products reduced once, what is cheaper than the Karatsuba multiplication
+    // with every Fq^2 product reduced separately.
+    const auto ksi_a1 = multiply_by_ksi(a1);
+    const auto ksi_a2 = multiply_by_ksi(a2);
 
-    const auto t0 = a0 * b0;
-    const auto t1 = a1 * b1;
-    const auto t2 = a2 * b2;
-
-    const auto c0 = ((a1 + a2) * (b1 + b2) - t1 - t2) * ksi + t0;
-    const auto c1 = (a0 + a1) * (b0 + b1) - t0 - t1 + ksi * t2;
-    const auto c2 = (a0 + a2) * (b0 + b2) - t0 - t2 + t1;
-
-    return Fq6({c0, c1, c2});
+    return Fq6({
+        sum_of_products<3>({a0, ksi_a1, ksi_a2}, {b0, b2, b1}),
+        sum_of_products<3>({a0, a1, ksi_a2}, {b1, b0, b2}),
+        sum_of_products<3>({a0, a1, a2}, {b2, b1, b0}),
+    });
 }
 
 /// Multiplies two Fq^12 field elements
@@ -102,9 +144,8 @@ constexpr Fq12 multiply(const Fq12& a, const Fq12& b)
     const auto t0 = a0 * b0;
     const auto t1 = a1 * b1;
 
-    const Fq2& ksi = Fq6Config::ksi;
-
-    const auto c0 = t0 + Fq6({ksi * t1.coeffs[2], t1.coeffs[0], t1.coeffs[1]});  // gamma is sparse.
+    // gamma is sparse.
+    const auto c0 = t0 + Fq6({multiply_by_ksi(t1.coeffs[2]), t1.coeffs[0], t1.coeffs[1]});
     const auto c1 = (a0 + a1) * (b0 + b1) - t0 - t1;
 
     return Fq12({c0, c1});
@@ -121,11 +162,10 @@ inline Fq2 inverse(const Fq2& f)
 {
     const auto& a0 = f.coeffs[0];
     const auto& a1 = f.coeffs[1];
-    auto t0 = a0 * a0;
-    auto t1 = a1 * a1;
 
-    t0 = t0 + t1;
-    t1 = t0.inv();
+    constexpr auto& Fp = BaseFieldConfig::MOD_ARITH;
+    const auto t0 = Fq(Fp.reduce(Fp.add_wide(Fp.sqr_wide(a0.value()), Fp.sqr_wide(a1.value()))));
+    const auto t1 = t0.inv();
 
     const auto c0 = a0 * t1;
     const auto c1 = -(a1 * t1);
@@ -140,21 +180,14 @@ inline Fq6 inverse(const Fq6& f)
     const auto& a1 = f.coeffs[1];
     const auto& a2 = f.coeffs[2];
 
-    const Fq2& ksi = Fq6Config::ksi;
+    const auto ksi_a1 = multiply_by_ksi(a1);
+    const auto ksi_a2 = multiply_by_ksi(a2);
 
-    const auto t0 = a0 * a0;
-    const auto t1 = a1 * a1;
-    const auto t2 = a2 * a2;
+    const auto c0 = sum_of_products<2>({a0, -ksi_a2}, {a0, a1});
+    const auto c1 = sum_of_products<2>({ksi_a2, -a0}, {a2, a1});
+    const auto c2 = sum_of_products<2>({a1, -a0}, {a1, a2});
 
-    const auto t3 = a0 * a1;
-    const auto t4 = a0 * a2;
-    const auto t5 = a2 * a1;
-
-    const auto c0 = t0 - ksi * t5;
-    const auto c1 = ksi * t2 - t3;
-    const auto c2 = t1 - t4;
-
-    const auto t = a0 * c0 + (a2 * c1 + a1 * c2) * ksi;
+    const auto t = sum_of_products<3>({a0, ksi_a2, ksi_a1}, {c0, c1, c2});
     const auto t6 = t.inv();
 
     return Fq6({c0 * t6, c1 * t6, c2 * t6});
@@ -169,9 +202,7 @@ inline Fq12 inverse(const Fq12& f)
     auto t0 = a0 * a0;
     auto t1 = a1 * a1;
 
-    const Fq2& ksi = Fq6Config::ksi;
-
-    t0 = t0 - Fq6({ksi * t1.coeffs[2], t1.coeffs[0], t1.coeffs[1]});  // gamma is sparse.
+    t0 = t0 - Fq6({multiply_by_ksi(t1.coeffs[2]), t1.coeffs[0], t1.coeffs[1]});  // gamma is sparse.
     t1 = t0.inv();
 
     const auto c0 = a0 * t1;
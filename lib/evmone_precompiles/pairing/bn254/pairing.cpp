@@ -3,8 +3,13 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "../../bn254.hpp"
+#include "../../parallel.hpp"
 #include "fields.hpp"
 #include "utils.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <mutex>
 #include <vector>
 
 namespace evmmax::bn254
@@ -14,7 +19,7 @@ namespace
 /// Multiplies `fr` (Fq12) values by sparse `v` (Fq12) value of the form
 /// [[t[0] * y, 0, 0],[t[1] * x, t[0], 0]] where `v` coefficients are from Fq2
 constexpr void multiply_by_lin_func_value(
-    Fq12& fr, std::array<Fq2, 3> t, const Fq& x, const Fq& y) noexcept
+    Fq12& fr, const std::array<Fq2, 3>& t, const Fq& x, const Fq& y) noexcept
 {
     const Fq12 f = fr;
     const auto& ksi = Fq6Config::ksi;
@@ -44,32 +49,42 @@ constexpr void multiply_by_lin_func_value(
 inline constexpr auto ATE_LOOP_COUNT_NAF = 0x1120804220120081204008212022011_u128;
 inline constexpr int LOG_ATE_LOOP_COUNT = 63;
 
-/// Miller loop according to https://eprint.iacr.org/2010/354.pdf Algorithm 1.
-Fq12 miller_loop(const ecc::Point<Fq2>& Q, const ecc::Point<Fq>& P) noexcept
+/// The number of the line functions evaluated in the Miller loop: one per doubling step,
+/// one per non-zero NAF digit and two for the final additions.
+inline constexpr size_t NUM_LINES = [] {
+    size_t n = 2;
+    auto naf = ATE_LOOP_COUNT_NAF;
+    for (int i = 0; i <= LOG_ATE_LOOP_COUNT; ++i)
+    {
+        n += (naf & 3) != 0 ? 2 : 1;
+        naf >>= 2;
+    }
+    return n;
+}();
+
+/// The coefficients of all the line functions of the Miller loop for a G2 point.
+///
+/// The coefficients depend only on the G2 point (the lines are evaluated at the G1 point
+/// with multiply_by_lin_func_value()) so all the G2 arithmetic is done once per point.
+using LineCoeffs = std::array<std::array<Fq2, 3>, NUM_LINES>;
+
+/// Computes the line functions coefficients of the Miller loop for the G2 point Q
+/// according to https://eprint.iacr.org/2010/354.pdf Algorithm 1.
+void compute_line_coeffs(const ecc::Point<Fq2>& Q, LineCoeffs& lines) noexcept
 {
     auto T = ecc::JacPoint<Fq2>::from(Q);
     auto nQ = -Q;
-    auto f = Fq12::one();
-    std::array<Fq2, 3> t;
     auto naf = ATE_LOOP_COUNT_NAF;
-    const auto ny = -P.y;
+    auto line = lines.begin();
 
     for (int i = 0; i <= LOG_ATE_LOOP_COUNT; ++i)
     {
-        T = lin_func_and_dbl(T, t);
-        f = square(f);
-        multiply_by_lin_func_value(f, t, P.x, ny);
+        T = lin_func_and_dbl(T, *line++);
 
         if (naf & 1)
-        {
-            T = lin_func_and_add(T, Q, t);
-            multiply_by_lin_func_value(f, t, P.x, P.y);
-        }
+            T = lin_func_and_add(T, Q, *line++);
         else if (naf & 2)
-        {
-            T = lin_func_and_add(T, nQ, t);
-            multiply_by_lin_func_value(f, t, P.x, P.y);
-        }
+            T = lin_func_and_add(T, nQ, *line++);
         naf >>= 2;
     }
 
@@ -81,11 +96,130 @@ Fq12 miller_loop(const ecc::Point<Fq2>& Q, const ecc::Point<Fq>& P) noexcept
     // negation according to miller loop spec.
     const auto nQ2 = -endomorphism<2>(Q);
 
-    T = lin_func_and_add(T, Q1, t);
-    multiply_by_lin_func_value(f, t, P.x, P.y);
+    T = lin_func_and_add(T, Q1, *line++);
+    lin_func(T, nQ2, *line++);
+    assert(line == lines.end());
+}
+
+/// The G2 point coordinates (not in Montgomery form) as the key of the G2 precomputation cache.
+struct G2Key
+{
+    std::array<uint256, 4> coords;
+
+    friend bool operator==(const G2Key&, const G2Key&) = default;
+};
+
+/// The maximum number of G2 points in the cache. A cache entry takes around 17 KB.
+constexpr size_t G2_CACHE_CAPACITY = 64;
+
+/// The cache of the line coefficients of the valid G2 points.
+///
+/// The cache is small so the entries are searched linearly. When the cache is full,
+/// the least recently used entry is evicted. The lookup is negligible compared to
+/// the Miller loop of a single pair, so a single mutex protects the cache.
+class G2Cache
+{
+    struct Entry
+    {
+        G2Key key;
+        std::shared_ptr<const LineCoeffs> lines;
+        uint64_t last_use = 0;
+    };
+
+    std::mutex m_mutex;
+    std::vector<Entry> m_entries;
+
+    /// The counter of the cache accesses ordering the entries by the last use.
+    uint64_t m_clock = 0;
+
+    Entry* find(const G2Key& key) noexcept
+    {
+        const auto it = std::ranges::find(m_entries, key, &Entry::key);
+        return it != m_entries.end() ? &*it : nullptr;
+    }
+
+public:
+    std::atomic<uint64_t> hits = 0;
+    std::atomic<uint64_t> misses = 0;
+
+    /// Returns the line coefficients of the G2 point or nullptr if not cached.
+    std::shared_ptr<const LineCoeffs> get(const G2Key& key)
+    {
+        const std::lock_guard lock{m_mutex};
+        auto* const entry = find(key);
+        if (entry == nullptr)
+            return nullptr;
+        entry->last_use = ++m_clock;
+        return entry->lines;
+    }
+
+    /// Inserts the line coefficients of the G2 point.
+    void put(const G2Key& key, std::shared_ptr<const LineCoeffs> lines)
+    {
+        const std::lock_guard lock{m_mutex};
+        auto* entry = find(key);  // The entry may have been inserted by another thread.
+        if (entry == nullptr)
+        {
+            if (m_entries.size() < G2_CACHE_CAPACITY)
+                entry = &m_entries.emplace_back();
+            else
+                entry = &*std::ranges::min_element(m_entries, {}, &Entry::last_use);
+            entry->key = key;
+        }
+        entry->lines = std::move(lines);
+        entry->last_use = ++m_clock;
+    }
+
+    void clear()
+    {
+        const std::lock_guard lock{m_mutex};
+        m_entries.clear();
+        hits.store(0, std::memory_order_relaxed);
+        misses.store(0, std::memory_order_relaxed);
+    }
+};
+
+G2Cache& g2_cache() noexcept
+{
+    static G2Cache cache;
+    return cache;
+}
+
+/// Computes the product of the Miller loops of multiple pairs (multi-Miller loop).
+///
+/// The Miller loops of all the pairs are run simultaneously so the squaring of the accumulator
+/// in every iteration is shared by the pairs. The lines are evaluated from the coefficients
+/// precomputed for the G2 points by compute_line_coeffs().
+Fq12 multi_miller_loop(std::span<const std::shared_ptr<const LineCoeffs>> lines,
+    std::span<const ecc::Point<Fq>> Ps) noexcept
+{
+    assert(lines.size() == Ps.size());
 
-    lin_func(T, nQ2, t);
-    multiply_by_lin_func_value(f, t, P.x, P.y);
+    auto f = Fq12::one();
+    auto naf = ATE_LOOP_COUNT_NAF;
+    size_t line_idx = 0;
+
+    for (int i = 0; i <= LOG_ATE_LOOP_COUNT; ++i)
+    {
+        f = square(f);
+        for (size_t k = 0; k < Ps.size(); ++k)
+            multiply_by_lin_func_value(f, (*lines[k])[line_idx], Ps[k].x, -Ps[k].y);
+        ++line_idx;
+
+        if ((naf & 3) != 0)
+        {
+            for (size_t k = 0; k < Ps.size(); ++k)
+                multiply_by_lin_func_value(f, (*lines[k])[line_idx], Ps[k].x, Ps[k].y);
+            ++line_idx;
+        }
+        naf >>= 2;
+    }
+
+    for (; line_idx < NUM_LINES; ++line_idx)
+    {
+        for (size_t k = 0; k < Ps.size(); ++k)
+            multiply_by_lin_func_value(f, (*lines[k])[line_idx], Ps[k].x, Ps[k].y);
+    }
 
     return f;
 }
@@ -126,14 +260,17 @@ Fq12 final_exp(const Fq12& v) noexcept
     t0 = cyclotomic_square(t0);
     return t1 * t0;
 }
-}  // namespace
 
-std::optional<bool> pairing_check(std::span<const std::pair<Point, ExtPoint>> pairs) noexcept
+/// Validates the pairs and computes the product of their Miller loops.
+/// Returns std::nullopt if any of the pairs is invalid.
+std::optional<Fq12> miller_loop_product(
+    std::span<const std::pair<Point, ExtPoint>> pairs) noexcept
 {
-    if (pairs.empty())
-        return true;
-
-    auto f = Fq12::one();
+    auto& cache = g2_cache();
+    std::vector<ecc::Point<Fq>> Ps;
+    std::vector<std::shared_ptr<const LineCoeffs>> lines;
+    Ps.reserve(pairs.size());
+    lines.reserve(pairs.size());
 
     for (const auto& [p, q] : pairs)
     {
@@ -146,27 +283,102 @@ std::optional<bool> pairing_check(std::span<const std::pair<Point, ExtPoint>> pa
 
         // Converts points' coefficients in Montgomery form.
         const auto P_aff = ecc::Point<Fq>{Fq::from_int(p.x), Fq::from_int(p.y)};
-        const auto Q_aff = ecc::Point<Fq2>{Fq2({Fq::from_int(q.x.first), Fq::from_int(q.x.second)}),
-            Fq2({Fq::from_int(q.y.first), Fq::from_int(q.y.second)})};
 
         const bool g1_is_inf = is_infinity(P_aff);
-        const bool g2_is_inf = g2_is_infinity(Q_aff);
 
         // Verify that P in on curve. For this group it also means that P is in G1.
         if (!g1_is_inf && !is_on_curve(P_aff))
             return std::nullopt;
 
-        // Verify that Q in on curve and in proper subgroup. This subgroup is much smaller than
-        // group containing all the points from twisted curve over Fq2 field.
-        if (!g2_is_inf && (!is_on_twisted_curve(Q_aff) || !g2_subgroup_check(Q_aff)))
-            return std::nullopt;
+        // Only the valid G2 points are in the cache, so for the cached point
+        // the validation and the line coefficients computation are skipped.
+        const G2Key key{{q.x.first, q.x.second, q.y.first, q.y.second}};
+        auto q_lines = cache.get(key);
+        if (q_lines != nullptr)
+            cache.hits.fetch_add(1, std::memory_order_relaxed);
+        else
+        {
+            const auto Q_aff =
+                ecc::Point<Fq2>{Fq2({Fq::from_int(q.x.first), Fq::from_int(q.x.second)}),
+                    Fq2({Fq::from_int(q.y.first), Fq::from_int(q.y.second)})};
+
+            // The infinity is never cached: it contributes 1 to the pairing product.
+            if (g2_is_infinity(Q_aff))
+                continue;
 
-        // If any of the points is infinity it means that miller_loop returns 1. so we can skip it.
-        if (!g1_is_inf && !g2_is_inf)
-            f = f * miller_loop(Q_aff, P_aff);
+            // Verify that Q in on curve and in proper subgroup. This subgroup is much smaller
+            // than group containing all the points from twisted curve over Fq2 field.
+            if (!is_on_twisted_curve(Q_aff) || !g2_subgroup_check(Q_aff))
+                return std::nullopt;
+
+            auto new_lines = std::make_shared<LineCoeffs>();
+            compute_line_coeffs(Q_aff, *new_lines);
+            q_lines = new_lines;
+            cache.put(key, std::move(new_lines));
+            cache.misses.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // The pair with the point at infinity contributes 1 to the pairing product,
+        // so it is not included in the multi-Miller loop.
+        if (!g1_is_inf)
+        {
+            Ps.push_back(P_aff);
+            lines.push_back(std::move(q_lines));
+        }
     }
 
+    return multi_miller_loop(lines, Ps);
+}
+
+/// Computes the product of the Miller loops of the pairs split into num_tasks chunks
+/// processed in parallel. Returns std::nullopt if any of the pairs is invalid.
+std::optional<Fq12> parallel_miller_loop_product(const evmone::crypto::ParallelPairing& parallel,
+    std::span<const std::pair<Point, ExtPoint>> pairs, size_t num_tasks)
+{
+    std::vector<std::optional<Fq12>> products(num_tasks);
+    parallel.run(num_tasks, [&](size_t i) {
+        const auto begin = i * pairs.size() / num_tasks;
+        const auto end = (i + 1) * pairs.size() / num_tasks;
+        products[i] = miller_loop_product(pairs.subspan(begin, end - begin));
+    });
+
+    auto f = Fq12::one();
+    for (const auto& product : products)
+    {
+        if (!product.has_value())
+            return std::nullopt;
+        f = f * *product;
+    }
+    return f;
+}
+}  // namespace
+
+std::optional<bool> pairing_check(std::span<const std::pair<Point, ExtPoint>> pairs) noexcept
+{
+    if (pairs.empty())
+        return true;
+
+    // The pairs are split into chunks processed in parallel if enabled.
+    const evmone::crypto::ParallelPairing parallel;
+    const auto num_tasks = parallel.num_tasks(pairs.size());
+    const auto f = num_tasks == 1 ? miller_loop_product(pairs) :
+                                    parallel_miller_loop_product(parallel, pairs, num_tasks);
+    if (!f.has_value())
+        return std::nullopt;
+
     // final exp is calculated on accumulated value
-    return final_exp(f) == Fq12::one();
+    return final_exp(*f) == Fq12::one();
+}
+
+G2CacheStats get_g2_cache_stats() noexcept
+{
+    const auto& cache = g2_cache();
+    return {cache.hits.load(std::memory_order_relaxed),
+        cache.misses.load(std::memory_order_relaxed)};
+}
+
+void clear_g2_cache() noexcept
+{
+    g2_cache().clear();
 }
 }  // namespace evmmax::bn254
@@ -0,0 +1,188 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "parallel.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <latch>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace evmone::crypto
+{
+namespace
+{
+/// The fixed-size pool of worker threads executing the queued tasks.
+class ThreadPool
+{
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::function<void()>> m_queue;
+    bool m_stop = false;
+    std::vector<std::thread> m_workers;
+
+    void work()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+            {
+                std::unique_lock lock{m_mutex};
+                m_cv.wait(lock, [this] { return m_stop || !m_queue.empty(); });
+                if (m_queue.empty())
+                    return;  // Stopped and all tasks done.
+                task = std::move(m_queue.front());
+                m_queue.pop_front();
+            }
+            task();
+        }
+    }
+
+public:
+    explicit ThreadPool(unsigned num_workers)
+    {
+        m_workers.reserve(num_workers);
+        for (unsigned i = 0; i < num_workers; ++i)
+            m_workers.emplace_back([this] { work(); });
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool()
+    {
+        {
+            const std::lock_guard lock{m_mutex};
+            m_stop = true;
+        }
+        m_cv.notify_all();
+        for (auto& worker : m_workers)
+            worker.join();
+    }
+
+    void submit(std::function<void()> task)
+    {
+        {
+            const std::lock_guard lock{m_mutex};
+            m_queue.push_back(std::move(task));
+        }
+        m_cv.notify_one();
+    }
+};
+
+/// The process-wide parallel pairing configuration: the published snapshot and
+/// the spin lock guarding it. The critical sections only copy or swap the shared pointer,
+/// so they never allocate nor block for long.
+class GlobalConfig
+{
+    std::atomic_flag m_lock;
+    std::shared_ptr<const ParallelPairingConfig> m_snapshot;
+
+    void lock() noexcept
+    {
+        while (m_lock.test_and_set(std::memory_order_acquire))
+            m_lock.wait(true, std::memory_order_relaxed);
+    }
+
+    void unlock() noexcept
+    {
+        m_lock.clear(std::memory_order_release);
+        m_lock.notify_one();
+    }
+
+public:
+    /// Returns the current snapshot.
+    std::shared_ptr<const ParallelPairingConfig> load() noexcept
+    {
+        lock();
+        auto snapshot = m_snapshot;
+        unlock();
+        return snapshot;
+    }
+
+    /// Exchanges the current snapshot with the given one.
+    void exchange(std::shared_ptr<const ParallelPairingConfig>& snapshot) noexcept
+    {
+        lock();
+        m_snapshot.swap(snapshot);
+        unlock();
+    }
+};
+
+GlobalConfig& global_config() noexcept
+{
+    static GlobalConfig config;
+    return config;
+}
+}  // namespace
+
+/// The immutable parallel pairing configuration.
+struct ParallelPairingConfig
+{
+    /// The number of threads per pairing check, including the calling thread.
+    unsigned num_threads = 0;
+
+    /// The minimal number of pairs to use the parallel execution.
+    size_t min_pairs = DEFAULT_PARALLEL_PAIRING_MIN_PAIRS;
+
+    /// The thread pool with num_threads - 1 workers.
+    std::unique_ptr<ThreadPool> pool;
+};
+
+void set_parallel_pairing(unsigned num_threads, size_t min_pairs)
+{
+    std::shared_ptr<const ParallelPairingConfig> snapshot;
+    if (num_threads > 1)
+    {
+        snapshot = std::make_shared<const ParallelPairingConfig>(ParallelPairingConfig{
+            num_threads, std::max(min_pairs, size_t{2}),
+            std::make_unique<ThreadPool>(num_threads - 1)});
+    }
+    global_config().exchange(snapshot);
+    // The previous snapshot is released here. If pairing checks still hold it,
+    // the last of them destroys its thread pool.
+}
+
+ParallelPairing::ParallelPairing() noexcept : m_config{global_config().load()} {}
+
+size_t ParallelPairing::num_tasks(size_t num_pairs) const noexcept
+{
+    if (m_config == nullptr || num_pairs < m_config->min_pairs)
+        return 1;
+    return std::min(size_t{m_config->num_threads}, num_pairs);
+}
+
+void ParallelPairing::run(size_t num_tasks, const std::function<void(size_t)>& fn) const
+{
+    assert(num_tasks != 0);
+    assert(num_tasks == 1 || m_config != nullptr);
+
+    std::latch done{static_cast<std::ptrdiff_t>(num_tasks - 1)};
+    size_t i = 1;
+    try
+    {
+        for (; i < num_tasks; ++i)
+        {
+            m_config->pool->submit([&fn, &done, i] {
+                fn(i);
+                done.count_down();
+            });
+        }
+    }
+    catch (...)
+    {
+        // The submitted tasks refer to this frame: wait for them before rethrowing.
+        done.count_down(static_cast<std::ptrdiff_t>(num_tasks - i));
+        done.wait();
+        throw;
+    }
+    fn(0);
+    done.wait();
+}
+}  // namespace evmone::crypto
@@ -0,0 +1,55 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#pragma once
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace evmone::crypto
+{
+/// The default minimal number of pairs for which the pairing check is executed in parallel.
+inline constexpr size_t DEFAULT_PARALLEL_PAIRING_MIN_PAIRS = 8;
+
+/// Configures the parallel execution of the pairing checks (bn254 and BLS12-381).
+///
+/// The parallel execution is opt-in. When enabled, the Miller loops of the pairs of large
+/// pairing checks are split between the calling thread and the workers of the internal thread
+/// pool. The partial products are combined before the single final exponentiation.
+///
+/// The configuration is process-wide: it is shared by all VM instances and threads.
+/// It may be changed at any time. The pairing checks in progress finish with the configuration
+/// (and the thread pool) they have started with, see ParallelPairing.
+///
+/// @param num_threads  The number of threads working on a single pairing check, including
+///                     the calling thread. The value 0 or 1 disables the parallel execution.
+/// @param min_pairs    The minimal number of pairs to use the parallel execution.
+void set_parallel_pairing(
+    unsigned num_threads, size_t min_pairs = DEFAULT_PARALLEL_PAIRING_MIN_PAIRS);
+
+struct ParallelPairingConfig;
+
+/// The snapshot of the parallel pairing configuration taken for a single pairing check.
+///
+/// The snapshot is immutable and keeps the thread pool alive until it is destroyed.
+class ParallelPairing
+{
+    std::shared_ptr<const ParallelPairingConfig> m_config;
+
+public:
+    /// Takes the snapshot of the current configuration.
+    ParallelPairing() noexcept;
+
+    /// Returns the number of parallel tasks to split the pairing check of the given number
+    /// of pairs. Returns 1 if the pairing check should be executed sequentially.
+    [[nodiscard]] size_t num_tasks(size_t num_pairs) const noexcept;
+
+    /// Runs the tasks fn(0), ..., fn(num_tasks - 1) in the thread pool
+    /// and waits for all of them to finish. The task 0 is run by the calling thread.
+    ///
+    /// The number of tasks must not exceed the num_tasks() result.
+    /// Throws std::bad_alloc if the tasks cannot be queued.
+    void run(size_t num_tasks, const std::function<void(size_t)>& fn) const;
+};
+}  // namespace evmone::crypto
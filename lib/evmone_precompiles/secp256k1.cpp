@@ -3,6 +3,8 @@
 // SPDX-License-Identifier: Apache-2.0
 #include "secp256k1.hpp"
 #include "keccak.hpp"
+#include <algorithm>
+#include <array>
 
 namespace evmmax::secp256k1
 {
@@ -14,6 +16,239 @@ constexpr auto B3 = Fp.to_mont(7 * 3);
 
 constexpr Point G{0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798_u256,
     0x483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8_u256};
+
+/// The GLV endomorphism of the curve: φ(x, y) = (βx, y) = [λ](x, y)
+/// for λ = 0x5363ad4cc05c30e0a5261c028812645a122e22ea20816678df02967c1b23bd72.
+constexpr ecc::GLVParams<uint256> GLV{
+    .order = Order,
+    .beta = Fp.to_mont(0x7ae96a2b657c07106e64479eac3434e99cf0497512f58995c1396c28719501ee_u256),
+    .a1 = 0x3086d221a7d46bcde86c90e49284eb15_u256,
+    .b1 = 0 - 0xe4437ed6010e88286f547fa90abfe4c3_u256,
+    .a2 = 0x114ca50f7a8e2f3f657c1108d9d44cfd8_u256,
+    .b2 = 0x3086d221a7d46bcde86c90e49284eb15_u256,
+    .g1 = 0x3086d221a7d46bcde86c90e49284eb15_u256,
+    .g2 = 0xe4437ed6010e88286f547fa90abfe4c4_u256,
+};
+
+/// The wNAF width for the multiples of the generator point G.
+/// The tables are precomputed once so the wider window pays off.
+constexpr unsigned G_WNAF_WIDTH = 8;
+
+/// The precomputed odd multiples [1]P, [3]P, ..., [2^(W-1) - 1]P of a point
+/// in affine coordinates in Montgomery form.
+template <unsigned W>
+using MultiplesTable = std::array<Point, ecc::wnaf_table_size(W)>;
+
+/// The maximum number of the signatures recovered together.
+/// This limits the stack space used for the scratch data.
+constexpr size_t BATCH_CHUNK_SIZE = 16;
+
+/// Computes the tables of odd multiples of at most MaxPoints points given in Montgomery form.
+///
+/// The multiples are computed in projective coordinates and converted to affine coordinates
+/// with a single batch inversion for all the tables.
+template <unsigned W, size_t MaxPoints>
+void compute_multiples(
+    std::span<const Point> points, std::span<MultiplesTable<W>> tables) noexcept
+{
+    constexpr auto TABLE_SIZE = ecc::wnaf_table_size(W);
+    constexpr auto MAX_NUM_MULTIPLES = MaxPoints * TABLE_SIZE;
+    std::array<ecc::ProjPoint<uint256>, MAX_NUM_MULTIPLES> multiples;
+    std::array<uint256, MAX_NUM_MULTIPLES> z_invs;
+    std::array<uint256, MAX_NUM_MULTIPLES> scratch;
+    assert(points.size() <= MaxPoints);
+
+    const auto one = Fp.to_mont(1);
+    const auto num_multiples = points.size() * TABLE_SIZE;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        const auto& p = points[i];
+        ecc::odd_multiples(Fp, {p.x, p.y, one},
+            std::span{multiples}.subspan(i * TABLE_SIZE, TABLE_SIZE), B3);
+    }
+
+    // The multiples are not the point at infinity because the points have the prime order.
+    for (size_t j = 0; j < num_multiples; ++j)
+        z_invs[j] = multiples[j].z;
+    ecc::batch_inv(
+        Fp, std::span<uint256>{z_invs}.first(num_multiples), std::span<uint256>{scratch});
+
+    for (size_t j = 0; j < num_multiples; ++j)
+    {
+        tables[j / TABLE_SIZE][j % TABLE_SIZE] = {
+            Fp.mul(multiples[j].x, z_invs[j]), Fp.mul(multiples[j].y, z_invs[j])};
+    }
+}
+
+/// Applies the GLV endomorphism to the table of multiples: [k]φ(P) = φ([k]P).
+template <unsigned W>
+MultiplesTable<W> endomorphism(const MultiplesTable<W>& table) noexcept
+{
+    MultiplesTable<W> r;
+    for (size_t i = 0; i < table.size(); ++i)
+        r[i] = {Fp.mul(GLV.beta, table[i].x), table[i].y};
+    return r;
+}
+
+/// The precomputed tables of the odd multiples of the generator point G and of φ(G).
+struct GeneratorTables
+{
+    MultiplesTable<G_WNAF_WIDTH> g;
+    MultiplesTable<G_WNAF_WIDTH> endo_g;
+};
+
+/// Returns the precomputed tables of multiples of the generator point G.
+const GeneratorTables& generator_tables() noexcept
+{
+    static const auto tables = [] {
+        const Point g_mont{Fp.to_mont(G.x), Fp.to_mont(G.y)};
+        GeneratorTables t;
+        compute_multiples<G_WNAF_WIDTH, 1>({&g_mont, 1}, {&t.g, 1});
+        t.endo_g = endomorphism<G_WNAF_WIDTH>(t.g);
+        return t;
+    }();
+    return tables;
+}
+
+/// The wNAF digits of a GLV decomposition scalar.
+using GLVNaf = std::array<int8_t, ecc::glv_max_bits<uint256> + 1>;
+
+/// Computes the wNAFs of the GLV decomposition of the scalar.
+template <unsigned W>
+std::array<std::span<const int8_t>, 2> glv_wnaf(
+    const uint256& c, GLVNaf& naf1, GLVNaf& naf2) noexcept
+{
+    const auto [k1, k2] = ecc::glv_decompose(GLV, c);
+    const auto len1 = ecc::wnaf<W>(naf1, k1.value, k1.neg);
+    const auto len2 = ecc::wnaf<W>(naf2, k2.value, k2.neg);
+    return {std::span<const int8_t>{naf1}.first(len1), std::span<const int8_t>{naf2}.first(len2)};
+}
+
+/// Computes [u1]G + [u2]R with the Straus-Shamir method: both scalars are split with
+/// the GLV decomposition and the four half-width multiplications share the doublings.
+/// The odd multiples of the points are added for the non-zero wNAF digits of the scalars.
+ecc::ProjPoint<uint256> mul_add_generator(const uint256& u1,
+    const MultiplesTable<ecc::WNAF_WIDTH>& r_multiples, const uint256& u2) noexcept
+{
+    const auto& g_tables = generator_tables();
+    const auto endo_r_multiples = endomorphism<ecc::WNAF_WIDTH>(r_multiples);
+
+    GLVNaf naf1;
+    GLVNaf naf2;
+    GLVNaf naf3;
+    GLVNaf naf4;
+    const auto [g_naf, endo_g_naf] = glv_wnaf<G_WNAF_WIDTH>(u1, naf1, naf2);
+    const auto [r_naf, endo_r_naf] = glv_wnaf<ecc::WNAF_WIDTH>(u2, naf3, naf4);
+
+    return ecc::mul_wnaf<uint256, Point, 4>(Fp,
+        {std::span<const Point>{g_tables.g}, std::span<const Point>{g_tables.endo_g},
+            std::span<const Point>{r_multiples}, std::span<const Point>{endo_r_multiples}},
+        {g_naf, endo_g_naf, r_naf, endo_r_naf}, B3);
+}
+
+/// Recovers the public keys of the chunk of at most ChunkSize signatures.
+/// The scratch space on the stack is proportional to the ChunkSize.
+template <size_t ChunkSize>
+void recover_chunk(
+    std::span<const RecoveryInput> inputs, std::span<std::optional<Point>> outputs) noexcept
+{
+    // Follows
+    // https://en.wikipedia.org/wiki/Elliptic_Curve_Digital_Signature_Algorithm#Public_key_recovery
+
+    assert(inputs.size() <= ChunkSize);
+    static constexpr ModArith<uint256> n{Order};
+
+    // The indexes of the signatures still valid at the given recovery step.
+    std::array<size_t, ChunkSize> valid;
+    size_t num_valid = 0;
+
+    std::array<uint256, ChunkSize> values;
+    std::array<uint256, ChunkSize> scratch;
+
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        outputs[i] = std::nullopt;
+
+        // 1. Validate r and s are within [1, n-1].
+        const auto& r = inputs[i].r;
+        const auto& s = inputs[i].s;
+        if (r == 0 || r >= Order || s == 0 || s >= Order)
+            continue;
+
+        values[num_valid] = n.to_mont(r);
+        valid[num_valid++] = i;
+    }
+
+    // 5. Calculate u1 and u2 (continued below). Compute the inversions of r for all signatures.
+    ecc::batch_inv(n, std::span<uint256>{values}.first(num_valid), std::span<uint256>{scratch});
+
+    std::array<uint256, ChunkSize> u1s;
+    std::array<uint256, ChunkSize> u2s;
+    std::array<Point, ChunkSize> Rs;
+    size_t num_points = 0;
+    for (size_t k = 0; k < num_valid; ++k)
+    {
+        const auto i = valid[k];
+        const auto& [e, r, s, v] = inputs[i];
+        const auto& r_inv = values[k];
+
+        // 2. Calculate y coordinate of R from r and v.
+        const auto r_mont = Fp.to_mont(r);
+        const auto y_mont = calculate_y(Fp, r_mont, v);
+        if (!y_mont.has_value())
+            continue;
+
+        // 3. Hash of the message is already calculated in e.
+        // 4. Convert hash e to z field element by doing z = e % n.
+        //    https://www.rfc-editor.org/rfc/rfc6979#section-2.3.2
+        //    We can do this by n - e because n > 2^255.
+        static_assert(Order > 1_u256 << 255);
+        auto z = intx::be::load<uint256>(e.bytes);
+        if (z >= Order)
+            z -= Order;
+
+        // 5. Calculate u1 and u2.
+        const auto z_mont = n.to_mont(z);
+        const auto z_neg = n.sub(0, z_mont);
+        u1s[num_points] = n.from_mont(n.mul(z_neg, r_inv));
+        const auto s_mont = n.to_mont(s);
+        u2s[num_points] = n.from_mont(n.mul(s_mont, r_inv));
+
+        Rs[num_points] = {r_mont, *y_mont};
+        valid[num_points++] = i;
+    }
+
+    // 6. Calculate public key point Q = u1×G + u2×R.
+    std::array<MultiplesTable<ecc::WNAF_WIDTH>, ChunkSize> R_multiples;
+    compute_multiples<ecc::WNAF_WIDTH, ChunkSize>(
+        std::span<const Point>{Rs}.first(num_points), R_multiples);
+
+    std::array<ecc::ProjPoint<uint256>, ChunkSize> Qs;
+    size_t num_results = 0;
+    for (size_t k = 0; k < num_points; ++k)
+    {
+        const auto Q = mul_add_generator(u1s[k], R_multiples[k], u2s[k]);
+
+        // Any other validity check needed?
+        if (Q.z == 0)
+            continue;  // The point at infinity.
+
+        Qs[num_results] = Q;
+        values[num_results] = Q.z;
+        valid[num_results++] = valid[k];
+    }
+
+    // Convert the public keys to affine coordinates with the batch inversion of z coordinates.
+    ecc::batch_inv(
+        Fp, std::span<uint256>{values}.first(num_results), std::span<uint256>{scratch});
+    for (size_t k = 0; k < num_results; ++k)
+    {
+        const auto& Q = Qs[k];
+        const auto& z_inv = values[k];
+        outputs[valid[k]] =
+            Point{Fp.from_mont(Fp.mul(Q.x, z_inv)), Fp.from_mont(Fp.mul(Q.y, z_inv))};
+    }
+}
 }  // namespace
 
 // FIXME: Change to "uncompress_point".
@@ -21,7 +256,7 @@ std::optional<uint256> calculate_y(
     const ModArith<uint256>& m, const uint256& x, bool y_parity) noexcept
 {
     // Calculate sqrt(x^3 + 7)
-    const auto x3 = m.mul(m.mul(x, x), x);
+    const auto x3 = m.mul(m.sqr(x), x);
     const auto y = field_sqrt(m, m.add(x3, B));
     if (!y.has_value())
         return std::nullopt;
@@ -54,8 +289,13 @@ Point mul(const Point& p, const uint256& c) noexcept
     if (c == 0)
         return {0, 0};
 
+    // The scalar is reduced modulo the group order for the GLV decomposition.
+    // A single subtraction is enough because the order is greater than 2^255.
+    static_assert(Order > 1_u256 << 255);
+    const auto k = c >= Order ? c - Order : c;
+
     const Point p_mont{Fp.to_mont(p.x), Fp.to_mont(p.y)};
-    const auto r = ecc::mul(Fp, p_mont, c, B3);
+    const auto r = ecc::mul(Fp, p_mont, k, B3, GLV);
     return ecc::to_affine(Fp, r);
 }
 
@@ -76,59 +316,10 @@ evmc::address to_address(const Point& pt) noexcept
 std::optional<Point> secp256k1_ecdsa_recover(
     const ethash::hash256& e, const uint256& r, const uint256& s, bool v) noexcept
 {
-    // Follows
-    // https://en.wikipedia.org/wiki/Elliptic_Curve_Digital_Signature_Algorithm#Public_key_recovery
-
-    // 1. Validate r and s are within [1, n-1].
-    if (r == 0 || r >= Order || s == 0 || s >= Order)
-        return std::nullopt;
-
-    // 3. Hash of the message is already calculated in e.
-    // 4. Convert hash e to z field element by doing z = e % n.
-    //    https://www.rfc-editor.org/rfc/rfc6979#section-2.3.2
-    //    We can do this by n - e because n > 2^255.
-    static_assert(Order > 1_u256 << 255);
-    auto z = intx::be::load<uint256>(e.bytes);
-    if (z >= Order)
-        z -= Order;
-
-
-    const ModArith<uint256> n{Order};
-
-    // 5. Calculate u1 and u2.
-    const auto r_n = n.to_mont(r);
-    const auto r_inv = n.inv(r_n);
-
-    const auto z_mont = n.to_mont(z);
-    const auto z_neg = n.sub(0, z_mont);
-    const auto u1_mont = n.mul(z_neg, r_inv);
-    const auto u1 = n.from_mont(u1_mont);
-
-    const auto s_mont = n.to_mont(s);
-    const auto u2_mont = n.mul(s_mont, r_inv);
-    const auto u2 = n.from_mont(u2_mont);
-
-    // 2. Calculate y coordinate of R from r and v.
-    const auto r_mont = Fp.to_mont(r);
-    const auto y_mont = calculate_y(Fp, r_mont, v);
-    if (!y_mont.has_value())
-        return std::nullopt;
-    const auto y = Fp.from_mont(*y_mont);
-
-    // 6. Calculate public key point Q.
-    const auto R = Point{Fp.to_mont(r), Fp.to_mont(y)};
-    const auto pG = Point{Fp.to_mont(G.x), Fp.to_mont(G.y)};
-    const auto T1 = ecc::mul(Fp, pG, u1, B3);
-    const auto T2 = ecc::mul(Fp, R, u2, B3);
-    const auto pQ = ecc::add(Fp, T1, T2, B3);
-
-    const auto Q = ecc::to_affine(Fp, pQ);
-
-    // Any other validity check needed?
-    if (Q.is_inf())
-        return std::nullopt;
-
-    return Q;
+    const RecoveryInput input{e, r, s, v};
+    std::optional<Point> result;
+    recover_chunk<1>({&input, 1}, {&result, 1});
+    return result;
 }
 
 std::optional<evmc::address> ecrecover(
@@ -141,6 +332,45 @@ std::optional<evmc::address> ecrecover(
     return to_address(*point);
 }
 
+void secp256k1_ecdsa_recover_batch(
+    std::span<const RecoveryInput> inputs, std::span<std::optional<Point>> outputs) noexcept
+{
+    assert(inputs.size() == outputs.size());
+
+    // The single signature doesn't need the scratch space for the full chunk.
+    if (inputs.size() == 1)
+        return recover_chunk<1>(inputs, outputs);
+
+    // Process the signatures in chunks to keep the scratch space on the stack.
+    while (!inputs.empty())
+    {
+        const auto n = std::min(inputs.size(), BATCH_CHUNK_SIZE);
+        recover_chunk<BATCH_CHUNK_SIZE>(inputs.first(n), outputs.first(n));
+        inputs = inputs.subspan(n);
+        outputs = outputs.subspan(n);
+    }
+}
+
+void ecrecover_batch(std::span<const RecoveryInput> inputs,
+    std::span<std::optional<evmc::address>> outputs) noexcept
+{
+    assert(inputs.size() == outputs.size());
+
+    std::optional<Point> points[BATCH_CHUNK_SIZE];
+    while (!inputs.empty())
+    {
+        const auto n = std::min(inputs.size(), BATCH_CHUNK_SIZE);
+        secp256k1_ecdsa_recover_batch(inputs.first(n), {points, n});
+        for (size_t i = 0; i < n; ++i)
+        {
+            outputs[i] =
+                points[i].has_value() ? std::optional{to_address(*points[i])} : std::nullopt;
+        }
+        inputs = inputs.subspan(n);
+        outputs = outputs.subspan(n);
+    }
+}
+
 std::optional<uint256> field_sqrt(const ModArith<uint256>& m, const uint256& x) noexcept
 {
     // Computes modular exponentiation
@@ -180,107 +410,107 @@ std::optional<uint256> field_sqrt(const ModArith<uint256>& m, const uint256& x)
 
 
     // Step 1: z = x^0x2
-    z = m.mul(x, x);
+    z = m.sqr(x);
 
     // Step 2: z = x^0x3
     z = m.mul(x, z);
 
     // Step 4: t0 = x^0xc
-    t0 = m.mul(z, z);
+    t0 = m.sqr(z);
     for (int i = 1; i < 2; ++i)
-        t0 = m.mul(t0, t0);
+        t0 = m.sqr(t0);
 
     // Step 5: t0 = x^0xf
     t0 = m.mul(z, t0);
 
     // Step 6: t1 = x^0x1e
-    t1 = m.mul(t0, t0);
+    t1 = m.sqr(t0);
 
     // Step 7: t2 = x^0x1f
     t2 = m.mul(x, t1);
 
     // Step 9: t1 = x^0x7c
-    t1 = m.mul(t2, t2);
+    t1 = m.sqr(t2);
     for (int i = 1; i < 2; ++i)
-        t1 = m.mul(t1, t1);
+        t1 = m.sqr(t1);
 
     // Step 10: t1 = x^0x7f
     t1 = m.mul(z, t1);
 
     // Step 14: t3 = x^0x7f0
-    t3 = m.mul(t1, t1);
+    t3 = m.sqr(t1);
     for (int i = 1; i < 4; ++i)
-        t3 = m.mul(t3, t3);
+        t3 = m.sqr(t3);
 
     // Step 15: t0 = x^0x7ff
     t0 = m.mul(t0, t3);
 
     // Step 26: t3 = x^0x3ff800
-    t3 = m.mul(t0, t0);
+    t3 = m.sqr(t0);
     for (int i = 1; i < 11; ++i)
-        t3 = m.mul(t3, t3);
+        t3 = m.sqr(t3);
 
     // Step 27: t0 = x^0x3fffff
     t0 = m.mul(t0, t3);
 
     // Step 32: t3 = x^0x7ffffe0
-    t3 = m.mul(t0, t0);
+    t3 = m.sqr(t0);
     for (int i = 1; i < 5; ++i)
-        t3 = m.mul(t3, t3);
+        t3 = m.sqr(t3);
 
     // Step 33: t2 = x^0x7ffffff
     t2 = m.mul(t2, t3);
 
     // Step 60: t3 = x^0x3ffffff8000000
-    t3 = m.mul(t2, t2);
+    t3 = m.sqr(t2);
     for (int i = 1; i < 27; ++i)
-        t3 = m.mul(t3, t3);
+        t3 = m.sqr(t3);
 
     // Step 61: t2 = x^0x3fffffffffffff
     t2 = m.mul(t2, t3);
 
     // Step 115: t3 = x^0xfffffffffffffc0000000000000
-    t3 = m.mul(t2, t2);
+    t3 = m.sqr(t2);
     for (int i = 1; i < 54; ++i)
-        t3 = m.mul(t3, t3);
+        t3 = m.sqr(t3);
 
     // Step 116: t2 = x^0xfffffffffffffffffffffffffff
     t2 = m.mul(t2, t3);
 
     // Step 224: t3 = x^0xfffffffffffffffffffffffffff000000000000000000000000000
-    t3 = m.mul(t2, t2);
+    t3 = m.sqr(t2);
     for (int i = 1; i < 108; ++i)
-        t3 = m.mul(t3, t3);
+        t3 = m.sqr(t3);
 
     // Step 225: t2 = x^0xffffffffffffffffffffffffffffffffffffffffffffffffffffff
     t2 = m.mul(t2, t3);
 
     // Step 232: t2 = x^0x7fffffffffffffffffffffffffffffffffffffffffffffffffffff80
     for (int i = 0; i < 7; ++i)
-        t2 = m.mul(t2, t2);
+        t2 = m.sqr(t2);
 
     // Step 233: t1 = x^0x7fffffffffffffffffffffffffffffffffffffffffffffffffffffff
     t1 = m.mul(t1, t2);
 
     // Step 256: t1 = x^0x3fffffffffffffffffffffffffffffffffffffffffffffffffffffff800000
     for (int i = 0; i < 23; ++i)
-        t1 = m.mul(t1, t1);
+        t1 = m.sqr(t1);
 
     // Step 257: t0 = x^0x3fffffffffffffffffffffffffffffffffffffffffffffffffffffffbfffff
     t0 = m.mul(t0, t1);
 
     // Step 263: t0 = x^0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc0
     for (int i = 0; i < 6; ++i)
-        t0 = m.mul(t0, t0);
+        t0 = m.sqr(t0);
 
     // Step 264: z = x^0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc3
     z = m.mul(z, t0);
 
     // Step 266: z = x^0x3fffffffffffffffffffffffffffffffffffffffffffffffffffffffbfffff0c
     for (int i = 0; i < 2; ++i)
-        z = m.mul(z, z);
+        z = m.sqr(z);
 
-    if (m.mul(z, z) != x)
+    if (m.sqr(z) != x)
         return std::nullopt;  // Computed value is not the square root.
 
     return z;
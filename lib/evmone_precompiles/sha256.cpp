@@ -11,6 +11,7 @@
 /// https://github.com/Mysticial/FeatureDetector (Author: Alexander Yee)
 
 #include "sha256.hpp"
+#include <algorithm>
 #include <bit>
 #include <cstdint>
 #include <cstring>
@@ -58,14 +59,23 @@ static const uint32_t k[] = {0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3
     0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb,
     0xbef9a3f7, 0xc67178f2};
 
+/*
+ * Initialize hash values:
+ * (first 32 bits of the fractional parts of the square roots of the first 8 primes 2..19):
+ */
+static const uint32_t initial_h[] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f,
+    0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+
 struct BufferState
 {
-    const std::byte* p;
-    size_t len;
-    size_t total_len;
+    const std::byte* p = nullptr;
+    size_t len = 0;
+    size_t total_len = 0;
     bool single_one_delivered = false;
     bool total_len_delivered = false;
 
+    constexpr BufferState() = default;
+
     constexpr BufferState(const std::byte* input, size_t size)
       : p{input}, len{size}, total_len{size}
     {}
@@ -243,6 +253,28 @@ static void sha_256_generic(uint32_t h[8], const std::byte* input, size_t len)
 
 static void (*sha_256_best)(uint32_t h[8], const std::byte* input, size_t len) = sha_256_generic;
 
+/// Writes the final hash value (big-endian) to the output.
+static void store_hash(std::byte hash[SHA256_HASH_SIZE], const uint32_t h[8])
+{
+    for (unsigned i = 0, j = 0; i < 8; i++)
+    {
+        hash[j++] = static_cast<std::byte>(h[i] >> 24);
+        hash[j++] = static_cast<std::byte>(h[i] >> 16);
+        hash[j++] = static_cast<std::byte>(h[i] >> 8);
+        hash[j++] = static_cast<std::byte>(h[i]);
+    }
+}
+
+static void sha_256_batch_generic(
+    std::byte* hashes, const std::byte* const inputs[], const size_t sizes[], size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        sha256(&hashes[i * SHA256_HASH_SIZE], inputs[i], sizes[i]);
+}
+
+static void (*sha_256_batch_best)(std::byte* hashes, const std::byte* const inputs[],
+    const size_t sizes[], size_t n) = sha_256_batch_generic;
+
 #if defined(__x86_64__)
 
 __attribute__((target("bmi,bmi2"))) static void sha_256_x86_bmi(
@@ -481,6 +513,124 @@ __attribute__((target("sha,sse4.1"))) static void sha_256_x86_sha(
 
 #pragma GCC diagnostic pop
 
+/// The vector of the same 32-bit word of SHA256_AVX2_LANES independent SHA256 states.
+using u32x8 = uint32_t __attribute__((vector_size(SHA256_AVX2_LANES * sizeof(uint32_t))));
+
+// The vector operations are macros because passing vectors by value depends
+// on the instruction set.
+#define ROTR_LANES(X, N) (((X) >> (N)) | ((X) << (32 - (N))))
+
+/// Computes the SHA256 hashes of up to SHA256_AVX2_LANES inputs at once.
+///
+/// Each lane of the 256-bit vectors processes a different input so that the 64 rounds
+/// of the compression function are computed for all the inputs with the same instructions.
+/// The inputs of different sizes are allowed: the hash of the input is taken after its last
+/// chunk and its lane idles later.
+__attribute__((target("avx2"))) void sha_256_x86_avx2_lanes(
+    std::byte* hashes, const std::byte* const inputs[], const size_t sizes[], size_t n)
+{
+    BufferState states[SHA256_AVX2_LANES];
+    bool done[SHA256_AVX2_LANES]{};
+    for (size_t l = 0; l < n; ++l)
+        states[l] = {inputs[l], sizes[l]};
+
+    u32x8 h[8];
+    for (size_t i = 0; i < 8; ++i)
+        h[i] = u32x8{} + initial_h[i];
+
+    /* 512-bit chunks is what we will operate on. */
+    uint8_t chunk[CHUNK_SIZE];
+    alignas(32) uint32_t chunk_words[16][SHA256_AVX2_LANES]{};
+
+    while (true)
+    {
+        bool active = false;
+        for (size_t l = 0; l < n; ++l)
+        {
+            if (done[l])
+                continue;
+
+            if (calc_chunk(chunk, &states[l]))
+            {
+                for (size_t j = 0; j < 16; ++j)
+                {
+                    const auto* const p = &chunk[j * 4];
+                    chunk_words[j][l] = (uint32_t)p[0] << 24 | (uint32_t)p[1] << 16 |
+                                        (uint32_t)p[2] << 8 | (uint32_t)p[3];
+                }
+                active = true;
+            }
+            else
+            {
+                // All chunks of the input have been processed.
+                uint32_t lane_h[8];
+                for (size_t i = 0; i < 8; ++i)
+                    lane_h[i] = h[i][l];
+                store_hash(&hashes[l * SHA256_HASH_SIZE], lane_h);
+                done[l] = true;
+            }
+        }
+        if (!active)
+            break;
+
+        u32x8 w[16];
+        std::memcpy(w, chunk_words, sizeof(w));
+
+        u32x8 ah[8];
+        for (size_t i = 0; i < 8; ++i)
+            ah[i] = h[i];
+
+#pragma GCC unroll 64
+        for (size_t i = 0; i < 64; ++i)
+        {
+            const size_t j = i & 0xf;
+            if (i >= 16)
+            {
+                const u32x8 w1 = w[(j + 1) & 0xf];
+                const u32x8 w14 = w[(j + 14) & 0xf];
+                const u32x8 s0 = ROTR_LANES(w1, 7) ^ ROTR_LANES(w1, 18) ^ (w1 >> 3);
+                const u32x8 s1 = ROTR_LANES(w14, 17) ^ ROTR_LANES(w14, 19) ^ (w14 >> 10);
+                w[j] = w[j] + s0 + w[(j + 9) & 0xf] + s1;
+            }
+            const u32x8 s1 = ROTR_LANES(ah[4], 6) ^ ROTR_LANES(ah[4], 11) ^ ROTR_LANES(ah[4], 25);
+            const u32x8 ch = (ah[4] & ah[5]) ^ (~ah[4] & ah[6]);
+            const u32x8 temp1 = ah[7] + s1 + ch + k[i] + w[j];
+            const u32x8 s0 = ROTR_LANES(ah[0], 2) ^ ROTR_LANES(ah[0], 13) ^ ROTR_LANES(ah[0], 22);
+            const u32x8 maj = (ah[0] & ah[1]) ^ (ah[0] & ah[2]) ^ (ah[1] & ah[2]);
+            const u32x8 temp2 = s0 + maj;
+
+            ah[7] = ah[6];
+            ah[6] = ah[5];
+            ah[5] = ah[4];
+            ah[4] = ah[3] + temp1;
+            ah[3] = ah[2];
+            ah[2] = ah[1];
+            ah[1] = ah[0];
+            ah[0] = temp1 + temp2;
+        }
+
+        for (size_t i = 0; i < 8; ++i)
+            h[i] += ah[i];
+    }
+}
+
+#undef ROTR_LANES
+
+static void sha_256_batch_x86_avx2(
+    std::byte* hashes, const std::byte* const inputs[], const size_t sizes[], size_t n)
+{
+    while (n >= 2)
+    {
+        const auto num_lanes = std::min(n, SHA256_AVX2_LANES);
+        sha_256_x86_avx2_lanes(hashes, inputs, sizes, num_lanes);
+        hashes += num_lanes * SHA256_HASH_SIZE;
+        inputs += num_lanes;
+        sizes += num_lanes;
+        n -= num_lanes;
+    }
+    sha_256_batch_generic(hashes, inputs, sizes, n);
+}
+
 // https://stackoverflow.com/questions/6121792/how-to-check-if-a-cpu-supports-the-sse3-instruction-set
 static void cpuid(int info[4], int InfoType)  // NOLINT(readability-non-const-parameter)
 {
@@ -511,6 +661,11 @@ __attribute__((constructor)) static void select_sha256_implementation()
         hw_sha = (info[1] & (1 << 29)) != 0;
     }
 
+    // The AVX2 CPUID bit alone does not mean the OS saves the YMM registers:
+    // __builtin_cpu_supports() also checks the XCR0 register.
+    __builtin_cpu_init();
+    const bool hw_avx2 = __builtin_cpu_supports("avx2");
+
     if (hw_sse41 && hw_sha)
     {
         sha_256_best = sha_256_x86_sha;
@@ -519,6 +674,12 @@ __attribute__((constructor)) static void select_sha256_implementation()
     {
         sha_256_best = sha_256_x86_bmi;
     }
+
+    // The single-stream SHA extensions are faster than the AVX2 multi-buffer implementation.
+    if (!hw_sha && hw_avx2)
+    {
+        sha_256_batch_best = sha_256_batch_x86_avx2;
+    }
 }
 
 #elif defined(__aarch64__) && defined(__APPLE__)
@@ -727,23 +888,18 @@ __attribute__((constructor)) static void select_sha256_implementation(void)
  */
 void sha256(std::byte hash[SHA256_HASH_SIZE], const std::byte* data, size_t size)
 {
-    /*
-     * Initialize hash values:
-     * (first 32 bits of the fractional parts of the square roots of the first 8 primes 2..19):
-     */
-    uint32_t h[] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c,
-        0x1f83d9ab, 0x5be0cd19};
+    uint32_t h[8];
+    std::memcpy(h, initial_h, sizeof(h));
 
     sha_256_best(h, data, size);
 
-    /* Produce the final hash value (big-endian): */
-    for (unsigned i = 0, j = 0; i < 8; i++)
-    {
-        hash[j++] = static_cast<std::byte>(h[i] >> 24);
-        hash[j++] = static_cast<std::byte>(h[i] >> 16);
-        hash[j++] = static_cast<std::byte>(h[i] >> 8);
-        hash[j++] = static_cast<std::byte>(h[i]);
-    }
+    store_hash(hash, h);
+}
+
+void sha256_batch(
+    std::byte* hashes, const std::byte* const inputs[], const size_t sizes[], size_t n)
+{
+    sha_256_batch_best(hashes, inputs, sizes, n);
 }
 
 }  // namespace evmone::crypto
@@ -16,4 +16,30 @@ static constexpr std::size_t SHA256_HASH_SIZE = 256 / 8;
 /// @param      data  The input data.
 /// @param      size  The size of the input data.
 void sha256(std::byte hash[SHA256_HASH_SIZE], const std::byte* data, size_t size);
+
+/// Computes the SHA256 hashes of multiple independent inputs.
+///
+/// This is faster than computing the hashes one by one because the inputs are hashed
+/// together using SIMD instructions if available.
+///
+/// @param[out] hashes  The result message digests are written consecutively to the provided
+///                     memory of n * SHA256_HASH_SIZE bytes.
+/// @param      inputs  The pointers to the input data.
+/// @param      sizes   The sizes of the input data.
+/// @param      n       The number of inputs.
+void sha256_batch(
+    std::byte* hashes, const std::byte* const inputs[], const size_t sizes[], size_t n);
+
+#if defined(__x86_64__)
+/// The number of inputs hashed together by the AVX2 multi-buffer implementation.
+inline constexpr std::size_t SHA256_AVX2_LANES = 8;
+
+/// Computes the SHA256 hashes of up to SHA256_AVX2_LANES inputs with the AVX2 multi-buffer
+/// implementation. The CPU must support AVX2.
+///
+/// This is used by sha256_batch() on CPUs without the SHA extensions
+/// and is exposed to be tested on any CPU with AVX2.
+void sha_256_x86_avx2_lanes(
+    std::byte* hashes, const std::byte* const inputs[], const size_t sizes[], size_t n);
+#endif
 }  // namespace evmone::crypto
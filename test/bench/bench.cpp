@@ -106,12 +106,15 @@ void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
     evmc::VM* advanced_vm = nullptr;
     evmc::VM* baseline_vm = nullptr;
     evmc::VM* basel_cg_vm = nullptr;
+    evmc::VM* basel_jit_vm = nullptr;
     if (const auto it = registered_vms.find("advanced"); it != registered_vms.end())
         advanced_vm = &it->second;
     if (const auto it = registered_vms.find("baseline"); it != registered_vms.end())
         baseline_vm = &it->second;
     if (const auto it = registered_vms.find("bnocgoto"); it != registered_vms.end())
         basel_cg_vm = &it->second;
+    if (const auto it = registered_vms.find("bjit"); it != registered_vms.end())
+        basel_jit_vm = &it->second;
 
     for (const auto& b : benchmark_cases)
     {
@@ -131,6 +134,14 @@ void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
             })->Unit(kMicrosecond);
         }
 
+        if (basel_jit_vm != nullptr)
+        {
+            RegisterBenchmark("bjit/analyse/" + b.name, [&b](State& state) {
+                bench_analyse<baseline::CodeAnalysis, baseline_jit_analyse>(
+                    state, default_revision, b.code);
+            })->Unit(kMicrosecond);
+        }
+
         for (const auto& input : b.inputs)
         {
             const auto case_name = b.name + (!input.name.empty() ? '/' + input.name : "");
@@ -159,6 +170,15 @@ void register_benchmarks(std::span<const BenchmarkCase> benchmark_cases)
                 })->Unit(kMicrosecond);
             }
 
+            if (basel_jit_vm != nullptr)
+            {
+                const auto name = "bjit/execute/" + case_name;
+                RegisterBenchmark(name, [&vm = *basel_jit_vm, &b, &input](State& state) {
+                    bench_baseline_jit_execute(
+                        state, vm, b.code, input.input, input.expected_output);
+                })->Unit(kMicrosecond);
+            }
+
             for (auto& [vm_name, vm] : registered_vms)
             {
                 const auto name = std::string{vm_name} + "/total/" + case_name;
@@ -276,6 +296,9 @@ int main(int argc, char** argv)
         registered_vms["advanced"] = evmc::VM{evmc_create_evmone(), {{"advanced", ""}}};
         registered_vms["baseline"] = evmc::VM{evmc_create_evmone()};
         registered_vms["bnocgoto"] = evmc::VM{evmc_create_evmone(), {{"cgoto", "no"}}};
+#if EVMONE_JIT_SUPPORTED
+        registered_vms["bjit"] = evmc::VM{evmc_create_evmone(), {{"jit", "0"}}};
+#endif
         register_benchmarks(benchmark_cases);
         register_synthetic_benchmarks();
         RunSpecifiedBenchmarks();
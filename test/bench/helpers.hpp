@@ -10,6 +10,7 @@
 #include <evmone/advanced_analysis.hpp>
 #include <evmone/advanced_execution.hpp>
 #include <evmone/baseline.hpp>
+#include <evmone/baseline_jit.hpp>
 #include <evmone/eof.hpp>
 #include <evmone/vm.hpp>
 
@@ -45,6 +46,13 @@ inline baseline::CodeAnalysis baseline_analyse(evmc_revision /*rev*/, bytes_view
     return baseline::analyze(code, true);  // Always enable EOF.
 }
 
+inline baseline::CodeAnalysis baseline_jit_analyse(evmc_revision rev, bytes_view code)
+{
+    auto analysis = baseline_analyse(rev, code);
+    baseline::compile_jit(analysis);
+    return analysis;
+}
+
 inline FakeCodeAnalysis evmc_analyse(evmc_revision /*rev*/, bytes_view /*code*/)
 {
     return {};
@@ -152,6 +160,9 @@ constexpr auto bench_advanced_execute = bench_execute<advanced::AdvancedExecutio
 constexpr auto bench_baseline_execute =
     bench_execute<ExecutionState, baseline::CodeAnalysis, baseline_execute, baseline_analyse>;
 
+constexpr auto bench_baseline_jit_execute =
+    bench_execute<ExecutionState, baseline::CodeAnalysis, baseline_execute, baseline_jit_analyse>;
+
 inline void bench_evmc_execute(benchmark::State& state, evmc::VM& vm, bytes_view code,
     bytes_view input = {}, bytes_view expected_output = {})
 {
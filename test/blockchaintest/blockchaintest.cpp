@@ -16,11 +16,11 @@ namespace
 class BlockchainGTest : public testing::Test
 {
     fs::path m_json_test_file;
-    evmc::VM& m_vm;
+    std::span<evmc::VM> m_vms;
 
 public:
-    explicit BlockchainGTest(fs::path json_test_file, evmc::VM& vm) noexcept
-      : m_json_test_file{std::move(json_test_file)}, m_vm{vm}
+    explicit BlockchainGTest(fs::path json_test_file, std::span<evmc::VM> vms) noexcept
+      : m_json_test_file{std::move(json_test_file)}, m_vms{vms}
     {}
 
     void TestBody() final
@@ -29,7 +29,7 @@ public:
 
         try
         {
-            evmone::test::run_blockchain_tests(evmone::test::load_blockchain_tests(f), m_vm);
+            evmone::test::run_blockchain_tests(evmone::test::load_blockchain_tests(f), m_vms);
         }
         catch (const evmone::test::UnsupportedTestFeature& ex)
         {
@@ -38,14 +38,14 @@ public:
     }
 };
 
-void register_test(const std::string& suite_name, const fs::path& file, evmc::VM& vm)
+void register_test(const std::string& suite_name, const fs::path& file, std::span<evmc::VM> vms)
 {
     testing::RegisterTest(suite_name.c_str(), file.stem().string().c_str(), nullptr, nullptr,
         file.string().c_str(), 0,
-        [file, &vm]() -> testing::Test* { return new BlockchainGTest(file, vm); });
+        [file, vms]() -> testing::Test* { return new BlockchainGTest(file, vms); });
 }
 
-void register_test_files(const fs::path& root, evmc::VM& vm)
+void register_test_files(const fs::path& root, std::span<evmc::VM> vms)
 {
     if (is_directory(root))
     {
@@ -57,11 +57,11 @@ void register_test_files(const fs::path& root, evmc::VM& vm)
         std::ranges::sort(test_files);
 
         for (const auto& p : test_files)
-            register_test(fs::relative(p, root).parent_path().string(), p, vm);
+            register_test(fs::relative(p, root).parent_path().string(), p, vms);
     }
     else  // Treat as a file.
     {
-        register_test(root.parent_path().string(), root, vm);
+        register_test(root.parent_path().string(), root, vms);
     }
 }
 }  // namespace
@@ -85,15 +85,30 @@ int main(int argc, char* argv[])
         bool trace_flag = false;
         app.add_flag("--trace", trace_flag, "Enable EVM tracing");
 
+        unsigned num_jobs = 1;
+        app.add_option("-j,--jobs", num_jobs,
+               "Number of threads executing transactions of a block in parallel")
+            ->check(CLI::PositiveNumber);
+
         CLI11_PARSE(app, argc, argv);
 
-        evmc::VM vm{evmc_create_evmone()};
+        // The traces of the transactions executed in parallel would be interleaved.
+        if (trace_flag && num_jobs > 1)
+        {
+            return app.exit(
+                CLI::ValidationError{"--trace", "cannot be used with --jobs greater than 1"});
+        }
 
-        if (trace_flag)
-            vm.set_option("trace", "1");
+        std::vector<evmc::VM> vms;
+        for (unsigned i = 0; i < num_jobs; ++i)
+        {
+            auto& vm = vms.emplace_back(evmc_create_evmone());
+            if (trace_flag)
+                vm.set_option("trace", "1");
+        }
 
         for (const auto& p : paths)
-            register_test_files(p, vm);
+            register_test_files(p, vms);
 
         return RUN_ALL_TESTS();
     }
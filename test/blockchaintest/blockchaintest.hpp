@@ -74,6 +74,10 @@ struct BlockchainTest
 
 std::vector<BlockchainTest> load_blockchain_tests(std::istream& input);
 
-void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm);
+/// Runs the blockchain tests.
+///
+/// @param vms  The VMs to execute the transactions. If more than one is provided,
+///             the transactions of a block are executed in parallel, one VM per thread.
+void run_blockchain_tests(std::span<const BlockchainTest> tests, std::span<evmc::VM> vms);
 
 }  // namespace evmone::test
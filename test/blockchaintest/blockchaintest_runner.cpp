@@ -2,7 +2,9 @@
 // Copyright 2023 The evmone Authors.
 // SPDX-License-Identifier: Apache-2.0
 
+#include "../state/layered_state.hpp"
 #include "../state/mpt_hash.hpp"
+#include "../state/parallel_transition.hpp"
 #include "../state/requests.hpp"
 #include "../state/rlp.hpp"
 #include "../state/system_contracts.hpp"
@@ -28,16 +30,24 @@ struct TransitionResult
     int64_t gas_used;
     state::BloomFilter bloom;
     int64_t blob_gas_left;
-    TestState block_state;
+    LayeredState block_state;
+    hash256 state_root;
 };
 
 namespace
 {
-TransitionResult apply_block(const TestState& state, evmc::VM& vm, const state::BlockInfo& block,
-    const state::BlockHashes& block_hashes, const std::vector<state::Transaction>& txs,
-    evmc_revision rev, std::optional<int64_t> block_reward)
+/// Applies the block on top of the given state.
+///
+/// The state trie must be in sync with the given state. It is updated with the block changes
+/// to compute the state root (and the per-transaction state roots before Byzantium).
+TransitionResult apply_block(std::shared_ptr<const LayeredState> state, std::span<evmc::VM> vms,
+    const state::BlockInfo& block, const state::BlockHashes& block_hashes,
+    const std::vector<state::Transaction>& txs, evmc_revision rev,
+    std::optional<int64_t> block_reward, state::StateTrie& state_trie)
 {
-    TestState block_state(state);
+    auto& vm = vms.front();
+    // The block state is the thin layer of changes over the state of the parent block.
+    LayeredState block_state(std::move(state));
     system_call_block_start(block_state, block, block_hashes, rev, vm);
 
     std::vector<state::Log> txs_logs;
@@ -49,13 +59,28 @@ TransitionResult apply_block(const TestState& state, evmc::VM& vm, const state::
 
     int64_t cumulative_gas_used = 0;
 
+    // Before Byzantium receipts contain the state root after each transaction:
+    // follow the transactions' changes in the state trie.
+    const bool tx_state_roots = rev < EVMC_BYZANTIUM;
+    if (tx_state_roots)
+        state_trie.apply(block_state.diff());
+
+    // With multiple VMs execute the transactions in parallel up front.
+    // The results are the same as of the sequential execution below.
+    auto parallel_results =
+        vms.size() > 1 ? transition_parallel(block_state, block, block_hashes, txs, rev, vms,
+                             block_gas_left, blob_gas_left) :
+                         std::vector<std::variant<state::TransactionReceipt, std::error_code>>{};
+
     for (size_t i = 0; i < txs.size(); ++i)
     {
         const auto& tx = txs[i];
 
         const auto computed_tx_hash = keccak256(rlp::encode(tx));
-        auto res = test::transition(
-            block_state, block, block_hashes, tx, rev, vm, block_gas_left, blob_gas_left);
+        auto res = !parallel_results.empty() ?
+                       std::move(parallel_results[i]) :
+                       test::transition(block_state, block, block_hashes, tx, rev, vm,
+                           block_gas_left, blob_gas_left);
 
         if (holds_alternative<std::error_code>(res))
         {
@@ -71,8 +96,11 @@ TransitionResult apply_block(const TestState& state, evmc::VM& vm, const state::
             txs_logs.insert(txs_logs.end(), tx_logs.begin(), tx_logs.end());
             cumulative_gas_used += receipt.gas_used;
             receipt.cumulative_gas_used = cumulative_gas_used;
-            if (rev < EVMC_BYZANTIUM)
-                receipt.post_state = state::mpt_hash(block_state);
+            if (tx_state_roots)
+            {
+                state_trie.apply(receipt.state_diff);
+                receipt.post_state = state_trie.hash();
+            }
 
             block_gas_left -= receipt.gas_used;
             blob_gas_left -= static_cast<int64_t>(tx.blob_gas_used());
@@ -103,8 +131,12 @@ TransitionResult apply_block(const TestState& state, evmc::VM& vm, const state::
 
     const auto bloom = compute_bloom_filter(receipts);
 
+    // The block changes override the transactions' changes applied already.
+    state_trie.apply(block_state.diff());
+    const auto state_root = state_trie.hash();
+
     return {std::move(receipts), std::move(rejected_txs), std::move(requests), cumulative_gas_used,
-        bloom, blob_gas_left, std::move(block_state)};
+        bloom, blob_gas_left, std::move(block_state), state_root};
 }
 
 bool validate_block(
@@ -226,7 +258,7 @@ std::string print_state(const TestState& s)
 }
 }  // namespace
 
-void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm)
+void run_blockchain_tests(std::span<const BlockchainTest> tests, std::span<evmc::VM> vms)
 {
     for (size_t case_index = 0; case_index != tests.size(); ++case_index)
     {
@@ -251,14 +283,29 @@ void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm)
         struct BlockData
         {
             const BlockHeader* header;
-            TestState post_state;
+            std::shared_ptr<const LayeredState> post_state;
             intx::uint256 total_difficulty;
         };
+        // The block states are layers over the pre-state. The pre-state outlives them,
+        // so it is referenced without copying.
+        const auto genesis_state = std::make_shared<const LayeredState>(
+            std::shared_ptr<const TestState>{std::shared_ptr<void>{}, &c.pre_state});
         std::unordered_map<hash256, BlockData> block_data{{{c.genesis_block_header.hash,
-            {&c.genesis_block_header, c.pre_state, c.genesis_block_header.difficulty}}}};
-        const auto* canonical_state = &c.pre_state;
+            {&c.genesis_block_header, genesis_state, c.genesis_block_header.difficulty}}}};
+        auto canonical_state = genesis_state;
         intx::uint256 max_total_difficulty = c.genesis_block_header.difficulty;
 
+        // The state trie follows the state of the most recently applied block, so the state
+        // roots are computed from the block changes only. The trie is rebuilt from the full
+        // state if a block is applied on top of another one (a fork or after an invalid block).
+        state::StateTrie state_trie{c.pre_state};
+        const LayeredState* state_trie_head = genesis_state.get();
+        const auto sync_state_trie = [&](const LayeredState& parent_state) {
+            if (state_trie_head != &parent_state)
+                state_trie = state::StateTrie{parent_state.to_test_state()};
+            state_trie_head = nullptr;
+        };
+
         for (size_t i = 0; i < c.test_blocks.size(); ++i)
         {
             const auto& test_block = c.test_blocks[i];
@@ -280,22 +327,25 @@ void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm)
 
                 // Block being valid guarantees its parent was found.
                 assert(parent_data_it != block_data.end());
-                const auto& pre_state = parent_data_it->second.post_state;
+                const auto& parent_state = parent_data_it->second.post_state;
 
-                auto res = apply_block(pre_state, vm, bi, block_hashes, test_block.transactions,
-                    rev, mining_reward(rev));
+                sync_state_trie(*parent_state);
+                auto res = apply_block(parent_state, vms, bi, block_hashes,
+                    test_block.transactions, rev, mining_reward(rev), state_trie);
 
                 ASSERT_TRUE(res.requests.has_value());
 
                 block_hashes[test_block.expected_block_header.block_number] =
                     test_block.expected_block_header.hash;
                 const auto [inserted_it, _] = block_data.insert({test_block.block_info.hash,
-                    {&test_block.expected_block_header, std::move(res.block_state),
+                    {&test_block.expected_block_header,
+                        std::make_shared<const LayeredState>(std::move(res.block_state)),
                         parent_data_it->second.total_difficulty +
                             test_block.block_info.difficulty}});
+                state_trie_head = inserted_it->second.post_state.get();
                 if (inserted_it->second.total_difficulty >= max_total_difficulty)
                 {
-                    canonical_state = &inserted_it->second.post_state;
+                    canonical_state = inserted_it->second.post_state;
                     max_total_difficulty = inserted_it->second.total_difficulty;
                 }
 
@@ -304,8 +354,7 @@ void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm)
                 EXPECT_TRUE(res.blob_gas_left == 0)
                     << "Transactions used more or less blob gas than expected in block header";
 
-                EXPECT_EQ(state::mpt_hash(inserted_it->second.post_state),
-                    test_block.expected_block_header.state_root);
+                EXPECT_EQ(res.state_root, test_block.expected_block_header.state_root);
 
                 if (rev >= EVMC_SHANGHAI)
                 {
@@ -333,10 +382,11 @@ void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm)
 
                 // Block being valid guarantees its parent was found.
                 assert(parent_data_it != block_data.end());
-                const auto& pre_state = parent_data_it->second.post_state;
+                const auto& parent_state = parent_data_it->second.post_state;
 
-                const auto res = apply_block(pre_state, vm, bi, block_hashes,
-                    test_block.transactions, rev, mining_reward(rev));
+                sync_state_trie(*parent_state);
+                const auto res = apply_block(parent_state, vms, bi, block_hashes,
+                    test_block.transactions, rev, mining_reward(rev), state_trie);
                 if (!res.requests.has_value())
                     continue;
                 if (!res.rejected.empty())
@@ -344,7 +394,7 @@ void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm)
                 if (res.blob_gas_left != 0)
                     continue;
 
-                if (state::mpt_hash(res.block_state) != test_block.expected_block_header.state_root)
+                if (res.state_root != test_block.expected_block_header.state_root)
                     continue;
 
                 if (rev >= EVMC_SHANGHAI && state::mpt_hash(test_block.block_info.withdrawals) !=
@@ -371,9 +421,10 @@ void run_blockchain_tests(std::span<const BlockchainTest> tests, evmc::VM& vm)
             std::holds_alternative<TestState>(c.expectation.post_state) ?
                 state::mpt_hash(std::get<TestState>(c.expectation.post_state)) :
                 std::get<hash256>(c.expectation.post_state);
-        EXPECT_EQ(state::mpt_hash(*canonical_state), expected_post_hash)
+        const auto canonical_post_state = canonical_state->to_test_state();
+        EXPECT_EQ(state::mpt_hash(canonical_post_state), expected_post_hash)
             << "Result state:\n"
-            << print_state(*canonical_state)
+            << print_state(canonical_post_state)
             << (std::holds_alternative<TestState>(c.expectation.post_state) ?
                        "\n\nExpected state:\n" +
                            print_state(std::get<TestState>(c.expectation.post_state)) :
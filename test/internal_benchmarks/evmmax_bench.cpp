@@ -11,6 +11,9 @@ namespace
 {
 constexpr auto bn254 = 0x30644e72e131a029b85045b68181585d97816a916871ca8d3c208c16d87cfd47_u256;
 constexpr auto secp256k1 = 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f_u256;
+constexpr auto bls12_381 =
+    0x1a0111ea397fe69a4b1ba7b6434bacd764774b84f38512bf6730d2a0f6b0f6241eabfffeb153ffffb9feffffffffaaab_u384;
+constexpr auto m511 = (uint512{1} << 511) - 1;
 
 template <typename UintT, const UintT& Mod>
 void evmmax_add(benchmark::State& state)
@@ -53,6 +56,45 @@ void evmmax_mul(benchmark::State& state)
         b = m.mul(b, a);
     }
 }
+
+template <typename UintT, const UintT& Mod>
+void evmmax_sqr(benchmark::State& state)
+{
+    const evmmax::ModArith<UintT> m{Mod};
+    auto a = m.to_mont(Mod / 2);
+
+    while (state.KeepRunningBatch(2))
+    {
+        a = m.sqr(a);
+        a = m.sqr(a);
+    }
+}
+
+/// Computes the sum of two products a⋅b + c⋅d with the reduction of each product
+/// or with the single lazy reduction of the sum.
+template <typename UintT, const UintT& Mod, bool Lazy>
+void evmmax_sum_of_products(benchmark::State& state)
+{
+    const evmmax::ModArith<UintT> m{Mod};
+    auto a = m.to_mont(Mod / 2);
+    auto b = m.to_mont(Mod / 3);
+    const auto c = m.to_mont(Mod / 5);
+    const auto d = m.to_mont(Mod / 7);
+
+    while (state.KeepRunningBatch(2))
+    {
+        if constexpr (Lazy)
+        {
+            a = m.reduce(m.add_wide(m.mul_wide(a, b), m.mul_wide(c, d)));
+            b = m.reduce(m.add_wide(m.mul_wide(b, a), m.mul_wide(c, d)));
+        }
+        else
+        {
+            a = m.add(m.mul(a, b), m.mul(c, d));
+            b = m.add(m.mul(b, a), m.mul(c, d));
+        }
+    }
+}
 }  // namespace
 
 BENCHMARK_TEMPLATE(evmmax_add, uint256, bn254);
@@ -61,3 +103,15 @@ BENCHMARK_TEMPLATE(evmmax_sub, uint256, bn254);
 BENCHMARK_TEMPLATE(evmmax_sub, uint256, secp256k1);
 BENCHMARK_TEMPLATE(evmmax_mul, uint256, bn254);
 BENCHMARK_TEMPLATE(evmmax_mul, uint256, secp256k1);
+BENCHMARK_TEMPLATE(evmmax_mul, uint384, bls12_381);
+BENCHMARK_TEMPLATE(evmmax_mul, uint512, m511);
+BENCHMARK_TEMPLATE(evmmax_sqr, uint256, bn254);
+BENCHMARK_TEMPLATE(evmmax_sqr, uint256, secp256k1);
+BENCHMARK_TEMPLATE(evmmax_sqr, uint384, bls12_381);
+BENCHMARK_TEMPLATE(evmmax_sqr, uint512, m511);
+BENCHMARK_TEMPLATE(evmmax_sum_of_products, uint256, bn254, false);
+BENCHMARK_TEMPLATE(evmmax_sum_of_products, uint256, bn254, true);
+BENCHMARK_TEMPLATE(evmmax_sum_of_products, uint384, bls12_381, false);
+BENCHMARK_TEMPLATE(evmmax_sum_of_products, uint384, bls12_381, true);
+BENCHMARK_TEMPLATE(evmmax_sum_of_products, uint512, m511, false);
+BENCHMARK_TEMPLATE(evmmax_sum_of_products, uint512, m511, true);
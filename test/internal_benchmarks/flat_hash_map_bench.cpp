@@ -0,0 +1,127 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../state/account.hpp"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+using evmone::state::FlatHashMap;
+using evmone::state::StorageValue;
+using evmc::address;
+using evmc::bytes32;
+
+namespace
+{
+using NodeStorage = std::unordered_map<bytes32, StorageValue>;
+using FlatStorage = FlatHashMap<bytes32, StorageValue>;
+
+/// Generates the storage keys: the small sequential slot numbers and
+/// the random-looking ones, like for Solidity mappings.
+std::vector<bytes32> generate_keys(size_t n)
+{
+    std::mt19937_64 rng{n};
+    std::vector<bytes32> keys(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (i % 4 == 0)
+            keys[i] = bytes32{i};
+        else
+        {
+            for (size_t j = 0; j < sizeof(bytes32); j += sizeof(uint64_t))
+            {
+                const auto word = rng();
+                std::memcpy(&keys[i].bytes[j], &word, sizeof(word));
+            }
+        }
+    }
+    return keys;
+}
+
+/// The warm SLOADs: the lookups of the already accessed storage entries.
+template <typename Map>
+void storage_sload_warm(benchmark::State& state)
+{
+    auto keys = generate_keys(static_cast<size_t>(state.range(0)));
+    Map storage;
+    for (const auto& key : keys)
+        storage[key] = {key, key};
+
+    // Access the entries in a different order than they have been inserted.
+    std::ranges::shuffle(keys, std::mt19937_64{});
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& key : keys)
+        {
+            const auto it = storage.find(key);
+            benchmark::DoNotOptimize(it->second.current);
+        }
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+BENCHMARK(storage_sload_warm<NodeStorage>)->Arg(16)->Arg(128)->Arg(1024);
+BENCHMARK(storage_sload_warm<FlatStorage>)->Arg(16)->Arg(128)->Arg(1024);
+
+/// The storage of a transaction: the cold SSTOREs (inserting entries), the warm SSTOREs
+/// and the iteration to build the state diff.
+template <typename Map>
+void storage_sstore_tx(benchmark::State& state)
+{
+    const auto keys = generate_keys(static_cast<size_t>(state.range(0)));
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Map storage;
+        for (const auto& key : keys)
+        {
+            const auto [it, missing] = storage.try_emplace(key);
+            if (missing)
+                it->second.original = key;
+            it->second.current = key;
+        }
+        for (const auto& key : keys)
+            storage.find(key)->second.access_status = EVMC_ACCESS_WARM;
+
+        size_t num_modified = 0;
+        for (const auto& [k, v] : storage)
+            num_modified += v.current != v.original;
+        benchmark::DoNotOptimize(num_modified);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * keys.size()));
+}
+BENCHMARK(storage_sstore_tx<NodeStorage>)->Arg(16)->Arg(128)->Arg(1024);
+BENCHMARK(storage_sstore_tx<FlatStorage>)->Arg(16)->Arg(128)->Arg(1024);
+
+/// The lookups of the accounts modified in a transaction.
+template <typename Map>
+void modified_accounts_find(benchmark::State& state)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    std::vector<address> addrs(n);
+    std::mt19937_64 rng{n};
+    for (auto& addr : addrs)
+    {
+        for (auto& b : addr.bytes)
+            b = static_cast<uint8_t>(rng());
+    }
+
+    Map accounts;
+    for (const auto& addr : addrs)
+        accounts[addr] = std::make_unique<int>(0);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& addr : addrs)
+            benchmark::DoNotOptimize(accounts.find(addr)->second.get());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+BENCHMARK(modified_accounts_find<std::unordered_map<address, std::unique_ptr<int>>>)->Arg(8);
+BENCHMARK(modified_accounts_find<FlatHashMap<address, std::unique_ptr<int>>>)->Arg(8);
+}  // namespace
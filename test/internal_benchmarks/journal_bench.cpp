@@ -0,0 +1,131 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../state/journal.hpp"
+#include <benchmark/benchmark.h>
+#include <evmc/evmc.hpp>
+#include <intx/intx.hpp>
+#include <variant>
+#include <vector>
+
+using evmc::address;
+using evmc::bytes32;
+
+namespace
+{
+// The journal entries like in the evmone::state::State.
+struct JournalBase
+{
+    address addr;
+};
+struct JournalBalanceChange : JournalBase
+{
+    intx::uint256 prev_balance;
+};
+struct JournalStorageChange : JournalBase
+{
+    bytes32 key;
+    bytes32 prev_value;
+    evmc_access_status prev_access_status;
+};
+struct JournalAccessAccount : JournalBase
+{};
+struct JournalTouched : JournalBase
+{};
+
+/// The journal implementation with std::vector of std::variant entries (the previous one).
+template <typename... Entries>
+class VariantJournal
+{
+    std::vector<std::variant<Entries...>> m_entries;
+
+public:
+    [[nodiscard]] size_t checkpoint() const noexcept { return m_entries.size(); }
+    [[nodiscard]] size_t size_bytes() const noexcept
+    {
+        return m_entries.size() * sizeof(std::variant<Entries...>);
+    }
+
+    template <typename T>
+    void push(const T& entry)
+    {
+        m_entries.emplace_back(entry);
+    }
+
+    template <typename Fn>
+    void rollback(size_t checkpoint, Fn&& fn)
+    {
+        while (m_entries.size() != checkpoint)
+        {
+            std::visit(fn, m_entries.back());
+            m_entries.pop_back();
+        }
+    }
+};
+
+/// The sink for the reverted values.
+struct Reverter
+{
+    uint64_t sum = 0;
+
+    void operator()(const JournalBalanceChange& e) noexcept
+    {
+        sum += e.addr.bytes[0] + e.prev_balance[0];
+    }
+    void operator()(const JournalStorageChange& e) noexcept
+    {
+        sum += e.addr.bytes[0] + e.key.bytes[0] + e.prev_value.bytes[0] + e.prev_access_status;
+    }
+    void operator()(const JournalAccessAccount& e) noexcept { sum += e.addr.bytes[0]; }
+    void operator()(const JournalTouched& e) noexcept { sum += e.addr.bytes[0]; }
+};
+
+/// Simulates the nested calls where each call accesses the callee account, transfers value,
+/// performs SSTOREs and then reverts after its subcalls return.
+template <typename J>
+void call(J& journal, Reverter& reverter, size_t depth, size_t num_sstores, size_t& peak_bytes)
+{
+    const auto checkpoint = journal.checkpoint();
+    const address callee{depth};
+    journal.push(JournalAccessAccount{callee});
+    journal.push(JournalTouched{callee});
+    journal.push(JournalBalanceChange{{callee}, depth});
+    for (size_t i = 0; i < num_sstores; ++i)
+    {
+        const bytes32 key{i};
+        journal.push(JournalStorageChange{{callee}, key, key, EVMC_ACCESS_COLD});  // Access.
+        journal.push(JournalStorageChange{{callee}, key, key, EVMC_ACCESS_WARM});  // Write.
+    }
+    if (depth != 0)
+        call(journal, reverter, depth - 1, num_sstores, peak_bytes);
+    else
+        peak_bytes = journal.size_bytes();
+    journal.rollback(checkpoint, reverter);
+}
+
+template <typename J>
+void journal_call_revert(benchmark::State& state)
+{
+    const auto depth = static_cast<size_t>(state.range(0));
+    const auto num_sstores = static_cast<size_t>(state.range(1));
+
+    Reverter reverter;
+    size_t peak_bytes = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        J journal;
+        call(journal, reverter, depth, num_sstores, peak_bytes);
+        benchmark::DoNotOptimize(reverter.sum);
+    }
+    state.counters["journal_bytes"] = static_cast<double>(peak_bytes);
+}
+
+using VariantJournalT = VariantJournal<JournalBalanceChange, JournalStorageChange,
+    JournalAccessAccount, JournalTouched>;
+using CompactJournalT = evmone::state::Journal<JournalBalanceChange, JournalStorageChange,
+    JournalAccessAccount, JournalTouched>;
+
+BENCHMARK(journal_call_revert<VariantJournalT>)->Args({1024, 0})->Args({64, 10})->Args({4, 1000});
+BENCHMARK(journal_call_revert<CompactJournalT>)->Args({1024, 0})->Args({64, 10})->Args({4, 1000});
+}  // namespace
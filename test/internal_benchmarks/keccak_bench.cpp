@@ -0,0 +1,60 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <benchmark/benchmark.h>
+#include <evmone_precompiles/keccak.hpp>
+#include <vector>
+
+namespace
+{
+/// Prepares the given number of inputs of the given size.
+std::vector<uint8_t> make_inputs(size_t num_inputs, size_t size)
+{
+    std::vector<uint8_t> data(num_inputs * size);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i);
+    return data;
+}
+
+void keccak256_scalar(benchmark::State& state)
+{
+    const auto num_inputs = static_cast<size_t>(state.range(0));
+    const auto size = static_cast<size_t>(state.range(1));
+    const auto data = make_inputs(num_inputs, size);
+    std::vector<ethash::hash256> hashes(num_inputs);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (size_t i = 0; i < num_inputs; ++i)
+            hashes[i] = ethash::keccak256(&data[i * size], size);
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_inputs));
+}
+
+void keccak256_batch(benchmark::State& state)
+{
+    const auto num_inputs = static_cast<size_t>(state.range(0));
+    const auto size = static_cast<size_t>(state.range(1));
+    const auto data = make_inputs(num_inputs, size);
+    std::vector<ethash::hash256> hashes(num_inputs);
+    std::vector<const uint8_t*> inputs(num_inputs);
+    const std::vector<size_t> sizes(num_inputs, size);
+    for (size_t i = 0; i < num_inputs; ++i)
+        inputs[i] = &data[i * size];
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        ethash::keccak256_batch(hashes.data(), inputs.data(), sizes.data(), num_inputs);
+        benchmark::DoNotOptimize(hashes.data());
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * num_inputs));
+}
+
+// The input sizes: an address, a storage key, an account RLP and a large input.
+#define KECCAK_ARGS ArgsProduct({{1024}, {20, 32, 104, 1000}})
+BENCHMARK(keccak256_scalar)->KECCAK_ARGS;
+BENCHMARK(keccak256_batch)->KECCAK_ARGS;
+#undef KECCAK_ARGS
+}  // namespace
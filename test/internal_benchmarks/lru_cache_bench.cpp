@@ -147,4 +147,54 @@ void lru_cache_put_full(benchmark::State& state)
 BENCHMARK(lru_cache_put_full<int, int>)->Arg(5000);
 BENCHMARK(lru_cache_put_full<hash256, std::shared_ptr<char>>)->Arg(5000);
 
+
+/// Benchmarks the concurrent cache accessed by multiple threads.
+///
+/// The cache is filled to capacity and then each thread concurrently gets existing entries
+/// and replaces every 16th one. The shards count 1 is equivalent to the LRUCache
+/// guarded by a single mutex.
+template <typename Key, typename Value>
+void concurrent_lru_cache_get_put(benchmark::State& state)
+{
+    const auto capacity = static_cast<size_t>(state.range(0));
+    const auto num_shards = static_cast<size_t>(state.range(1));
+
+    // Shared by all benchmark threads. Created and destroyed by the thread 0.
+    static std::unique_ptr<evmone::ConcurrentLRUCache<Key, Value>> cache;
+    if (state.thread_index() == 0)
+    {
+        cache = std::make_unique<evmone::ConcurrentLRUCache<Key, Value>>(capacity, num_shards);
+        for (size_t i = 0; i < capacity; ++i)
+            cache->put(static_cast<Key>(i), {});
+    }
+
+    // Each thread starts at a different position in the key space.
+    auto key_index = static_cast<size_t>(state.thread_index()) * capacity / 8;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto key = static_cast<Key>(key_index % capacity);
+        if (key_index % 16 == 0)
+            cache->put(key, {});
+        else
+        {
+            auto v = cache->get(key);
+            benchmark::DoNotOptimize(v);
+        }
+        ++key_index;
+    }
+
+    if (state.thread_index() == 0)
+        cache.reset();
+}
+BENCHMARK(concurrent_lru_cache_get_put<int, int>)
+    ->Args({5000, 1})
+    ->Args({5000, 16})
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+BENCHMARK(concurrent_lru_cache_get_put<hash256, std::shared_ptr<char>>)
+    ->Args({5000, 1})
+    ->Args({5000, 16})
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
 }  // namespace
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <benchmark/benchmark.h>
+#include <evmone/execution_state.hpp>
 #include <cstdlib>
 
 #if defined(__unix__) || defined(__APPLE__)
@@ -52,4 +53,47 @@ BENCHMARK_TEMPLATE(allocate, malloc_) ARGS;
 BENCHMARK_TEMPLATE(allocate, calloc_) ARGS;
 BENCHMARK_TEMPLATE(allocate, os_specific) ARGS;
 
+#undef ARGS
+
+
+/// Grows the fresh EVM memory to the given size in 1k steps.
+template <bool Virtual>
+void memory_grow(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0)) * 1024;
+
+    for (auto _ : state)
+    {
+        evmone::Memory memory;
+        memory.set_virtual(Virtual);
+        for (size_t s = 1024; s <= size; s += 1024)
+            memory.grow(s);
+        benchmark::DoNotOptimize(memory.data());
+    }
+}
+
+/// Grows the reused EVM memory (as in the execution states pool) to the given size in 1k steps.
+template <bool Virtual>
+void memory_grow_reused(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0)) * 1024;
+
+    evmone::Memory memory;
+    memory.set_virtual(Virtual);
+    for (auto _ : state)
+    {
+        memory.clear();
+        for (size_t s = 1024; s <= size; s += 1024)
+            memory.grow(s);
+        benchmark::DoNotOptimize(memory.data());
+    }
+}
+
+#define ARGS ->RangeMultiplier(4)->Range(1, 16 * 1024)
+
+BENCHMARK_TEMPLATE(memory_grow, false) ARGS;
+BENCHMARK_TEMPLATE(memory_grow, true) ARGS;
+BENCHMARK_TEMPLATE(memory_grow_reused, false) ARGS;
+BENCHMARK_TEMPLATE(memory_grow_reused, true) ARGS;
+
 }  // namespace
@@ -7,6 +7,10 @@
 #include <iostream>
 #include <vector>
 
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#endif
+
 using namespace std::chrono;
 using timer = high_resolution_clock;
 
@@ -49,8 +53,49 @@ void benchmark_realloc()
     }
 }
 
+/// Reserves the virtual address range once and commits the pages on demand
+/// (as the virtual EVM memory does). The memory address never changes.
+void benchmark_reserve_and_commit()
+{
+#if defined(__unix__) || defined(__APPLE__)
+    constexpr int repeats = 6;
+    constexpr size_t commit_multiplier = 2;
+    constexpr size_t size_start = 128 * 1024;
+    constexpr size_t size_end = 8 * 1024 * 1024;
+    constexpr size_t reserved_size = 64 * 1024 * 1024;
+
+    auto results = std::vector<result>{};
+    results.reserve(size_end / size_start);
+
+    for (int i = 0; i < repeats; ++i)
+    {
+        const auto m = mmap(nullptr, reserved_size, PROT_NONE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+        if (m == MAP_FAILED)
+            return;
+
+        for (auto size = size_start; size <= size_end; size *= commit_multiplier)
+        {
+            const auto start_time = timer::now();
+            mprotect(m, size, PROT_READ | PROT_WRITE);
+            const auto duration = timer::now() - start_time;
+            results.push_back({size, m, duration});
+        }
+        munmap(m, reserved_size);
+    }
+
+    std::cout << "reserve and commit:\n";
+    for (auto r : results)
+    {
+        std::cout << (r.size / 1024) << "k\t " << r.memory_ptr << "\t"
+                  << duration_cast<nanoseconds>(r.duration).count() << "\n";
+    }
+#endif
+}
+
 int main()
 {
     benchmark_realloc();
+    benchmark_reserve_and_commit();
     return 0;
 }
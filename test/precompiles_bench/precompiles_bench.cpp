@@ -4,12 +4,19 @@
 
 #include "../utils/utils.hpp"
 #include <benchmark/benchmark.h>
+#include <evmone_precompiles/bn254.hpp>
+#include <evmone_precompiles/modexp.hpp>
+#include <evmone_precompiles/parallel.hpp>
+#include <evmone_precompiles/secp256k1.hpp>
+#include <evmone_precompiles/sha256.hpp>
 #include <intx/intx.hpp>
 #include <state/precompiles.hpp>
 #include <state/precompiles_internal.hpp>
 #include <array>
+#include <cstring>
 #include <memory>
 #include <span>
+#include <vector>
 
 #ifdef EVMONE_PRECOMPILES_GMP
 #include <state/precompiles_gmp.hpp>
@@ -273,6 +280,47 @@ BENCHMARK_TEMPLATE(precompile, PrecompileId::ecrecover, evmmax_cpp);
 constexpr auto libsecp256k1 = silkpre_ecrecover_execute;
 BENCHMARK_TEMPLATE(precompile, PrecompileId::ecrecover, libsecp256k1);
 #endif
+
+/// Recovers the given number of signatures (taken from the ecrecover inputs)
+/// one by one or in a batch.
+template <bool Batch>
+void ecrecover_signatures(benchmark::State& state)
+{
+    using namespace evmmax::secp256k1;
+
+    const auto n = static_cast<size_t>(state.range(0));
+    const auto& precompile_inputs = inputs<PrecompileId::ecrecover>;
+    std::vector<RecoveryInput> signatures(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto& input = precompile_inputs[i % precompile_inputs.size()];
+        auto& signature = signatures[i];
+        std::memcpy(signature.e.bytes, input.data(), sizeof(signature.e));
+        signature.v = input[63] == 28;
+        signature.r = intx::be::unsafe::load<intx::uint256>(&input[64]);
+        signature.s = intx::be::unsafe::load<intx::uint256>(&input[96]);
+    }
+    std::vector<std::optional<evmc::address>> addresses(n);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        if constexpr (Batch)
+            ecrecover_batch(signatures, addresses);
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+            {
+                const auto& [e, r, s, v] = signatures[i];
+                addresses[i] = ecrecover(e, r, s, v);
+            }
+        }
+        benchmark::DoNotOptimize(addresses.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+BENCHMARK_TEMPLATE(ecrecover_signatures, false)->RangeMultiplier(4)->Range(1, 1024);
+BENCHMARK_TEMPLATE(ecrecover_signatures, true)->RangeMultiplier(4)->Range(1, 1024);
 }  // namespace bench_ecrecovery
 
 namespace bench_expmod
@@ -281,6 +329,66 @@ namespace bench_expmod
 constexpr auto gmp = expmod_execute;
 BENCHMARK(precompile<PrecompileId::expmod, gmp>);
 #endif
+
+/// Benchmarks the modexp implementation for the odd modulus of the given length
+/// and the exponent of the given bit width (all bits set).
+template <auto Fn>
+void modexp_odd(benchmark::State& state)
+{
+    const auto mod_len = static_cast<size_t>(state.range(0));
+    const auto exp_bits = static_cast<size_t>(state.range(1));
+    const auto exp_len = (exp_bits + 7) / 8;
+
+    bytes input(3 * 32, 0);
+    intx::be::unsafe::store(&input[0], intx::uint256{mod_len});
+    intx::be::unsafe::store(&input[32], intx::uint256{exp_len});
+    intx::be::unsafe::store(&input[64], intx::uint256{mod_len});
+    input.append(mod_len, 0xfe);
+    input.push_back(static_cast<uint8_t>(0xff >> (exp_len * 8 - exp_bits)));
+    input.append(exp_len - 1, 0xff);
+    input.append(mod_len, 0xff);
+    const auto payload = std::span{input}.subspan(3 * 32);
+    const auto base = payload.subspan(0, mod_len);
+    const auto exp = payload.subspan(mod_len, exp_len);
+    const auto mod = payload.subspan(mod_len + exp_len);
+
+    const auto output = std::make_unique_for_overwrite<uint8_t[]>(mod_len);
+    const auto gas_cost = expmod_analyze(input, EVMC_OSAKA).gas_cost;
+    int64_t total_gas_used = 0;
+    for ([[maybe_unused]] auto _ : state)
+    {
+        Fn(base, exp, mod, output.get());
+        benchmark::DoNotOptimize(output.get());
+        total_gas_used += gas_cost;
+    }
+
+    using benchmark::Counter;
+    state.counters["gas_used"] = Counter(static_cast<double>(gas_cost));
+    state.counters["gas_rate"] = Counter(static_cast<double>(total_gas_used), Counter::kIsRate);
+}
+
+/// The EIP-7883 worst cases (the most expensive computation for the gas cost)
+/// and the RSA-style exponentiations.
+void modexp_odd_args(benchmark::internal::Benchmark* b)
+{
+    b->ArgNames({"mod_len", "exp_bits"})
+        ->Args({32, 32})
+        ->Args({64, 4})
+        ->Args({128, 2})
+        ->Args({256, 2})
+        ->Args({1024, 2})
+        ->Args({256, 17})
+        ->Args({128, 1024})
+        ->Args({256, 2048})
+        ->Args({512, 4096});
+}
+
+constexpr auto evmmax_cpp = evmone::crypto::modexp;
+BENCHMARK_TEMPLATE(modexp_odd, evmmax_cpp)->Apply(modexp_odd_args);
+#ifdef EVMONE_PRECOMPILES_GMP
+constexpr auto gmp_odd = expmod_gmp;
+BENCHMARK_TEMPLATE(modexp_odd, gmp_odd)->Apply(modexp_odd_args);
+#endif
 #ifdef EVMONE_PRECOMPILES_SILKPRE
 constexpr auto silkpre = silkpre_expmod_execute;
 BENCHMARK(precompile<PrecompileId::expmod, silkpre>);
@@ -315,8 +423,191 @@ BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, evmmax_cpp);
 constexpr auto libff = silkpre_ecpairing_execute;
 BENCHMARK_TEMPLATE(precompile, PrecompileId::ecpairing, libff);
 #endif
+
+constexpr size_t PAIR_SIZE = 192;
+
+/// Returns all the (G1, G2) pairs from the ecpairing inputs.
+std::vector<bytes_view> ecpairing_input_pairs()
+{
+    std::vector<bytes_view> pairs;
+    for (const auto& input : inputs<PrecompileId::ecpairing>)
+    {
+        for (size_t i = 0; i + PAIR_SIZE <= input.size(); i += PAIR_SIZE)
+            pairs.emplace_back(&input[i], PAIR_SIZE);
+    }
+    return pairs;
+}
+
+/// Executes the ecpairing precompile for the input of the given number of pairs
+/// (taken from the ecpairing inputs).
+template <ExecuteFn Fn>
+void ecpairing_pairs(benchmark::State& state)
+{
+    const auto all_pairs = ecpairing_input_pairs();
+    const auto n = static_cast<size_t>(state.range(0));
+    bytes input;
+    for (size_t i = 0; i < n; ++i)
+        input += all_pairs[i % all_pairs.size()];
+
+    uint8_t output[32];
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = Fn(input.data(), input.size(), output, sizeof(output));
+        if (r.status_code != EVMC_SUCCESS) [[unlikely]]
+        {
+            state.SkipWithError("invalid result");
+            return;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+BENCHMARK_TEMPLATE(ecpairing_pairs, evmmax_cpp)->DenseRange(1, 6)->Arg(16);
+#ifdef EVMONE_PRECOMPILES_SILKPRE
+BENCHMARK_TEMPLATE(ecpairing_pairs, libff)->DenseRange(1, 6)->Arg(16);
+#endif
+
+/// Replays the sequence of Groth16-like verifications: every input has 4 pairs where
+/// the G2 points of 3 pairs are fixed (from the verifying key) and the G2 point of one pair
+/// is from the proof. Without the cache the G2 precomputation cache is cleared before
+/// every verification.
+template <bool Cached>
+void ecpairing_verifier(benchmark::State& state)
+{
+    constexpr size_t NUM_VERIFICATIONS = 16;
+    constexpr size_t NUM_FIXED_G2 = 3;
+    constexpr size_t G1_SIZE = 64;
+
+    const auto all_pairs = ecpairing_input_pairs();
+    std::vector<bytes> verifications(NUM_VERIFICATIONS);
+    for (size_t i = 0; i < NUM_VERIFICATIONS; ++i)
+    {
+        auto& input = verifications[i];
+        input += all_pairs[(i + NUM_FIXED_G2) % all_pairs.size()];
+        for (size_t k = 0; k < NUM_FIXED_G2; ++k)
+        {
+            input += all_pairs[(i + k) % all_pairs.size()].substr(0, G1_SIZE);
+            input += all_pairs[k].substr(G1_SIZE);
+        }
+    }
+
+    evmmax::bn254::clear_g2_cache();
+    uint8_t output[32];
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& input : verifications)
+        {
+            if constexpr (!Cached)
+                evmmax::bn254::clear_g2_cache();
+
+            const auto r = ecpairing_execute(input.data(), input.size(), output, sizeof(output));
+            if (r.status_code != EVMC_SUCCESS) [[unlikely]]
+            {
+                state.SkipWithError("invalid result");
+                return;
+            }
+            benchmark::DoNotOptimize(output);
+        }
+    }
+
+    const auto stats = evmmax::bn254::get_g2_cache_stats();
+    state.counters["g2_cache_hits"] = static_cast<double>(stats.hits);
+    state.counters["g2_cache_misses"] = static_cast<double>(stats.misses);
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * NUM_VERIFICATIONS));
+}
+BENCHMARK_TEMPLATE(ecpairing_verifier, false);
+BENCHMARK_TEMPLATE(ecpairing_verifier, true);
+
+/// Executes the pairing check precompile for the input of the given number of pairs
+/// with the parallel execution using NumThreads threads (0 for sequential execution).
+template <ExecuteFn Fn, unsigned NumThreads>
+void pairing_parallel(benchmark::State& state, bytes_view pair)
+{
+    const auto n = static_cast<size_t>(state.range(0));
+    bytes input;
+    for (size_t i = 0; i < n; ++i)
+        input += pair;
+
+    evmone::crypto::set_parallel_pairing(NumThreads, 2);
+    uint8_t output[32];
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const auto r = Fn(input.data(), input.size(), output, sizeof(output));
+        if (r.status_code != EVMC_SUCCESS) [[unlikely]]
+        {
+            state.SkipWithError("invalid result");
+            break;
+        }
+        benchmark::DoNotOptimize(output);
+    }
+    evmone::crypto::set_parallel_pairing(0);
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+}
+
+template <unsigned NumThreads>
+void ecpairing_parallel(benchmark::State& state)
+{
+    pairing_parallel<ecpairing_execute, NumThreads>(state, ecpairing_input_pairs()[0]);
+}
+BENCHMARK_TEMPLATE(ecpairing_parallel, 0)->RangeMultiplier(2)->Range(8, 64);
+BENCHMARK_TEMPLATE(ecpairing_parallel, 4)->RangeMultiplier(2)->Range(8, 64);
+
+/// The BLS12-381 pairing check input pair of the G1 and G2 generators.
+const auto bls12_generators_pair =
+    "0000000000000000000000000000000017f1d3a73197d7942695638c4fa9ac0fc3688c4f9774b905a14e3a3f171bac586c55e83ff97a1aeffb3af00adb22c6bb0000000000000000000000000000000008b3f481e3aaa0f1a09e30ed741d8ae4fcf5e095d5d00af600db18cb2c04b3edd03cc744a2888ae40caa232946c5e7e1"
+    "00000000000000000000000000000000024aa2b2f08f0a91260805272dc51051c6e47ad4fa403b02b4510b647ae3d1770bac0326a805bbefd48056c8c121bdb80000000000000000000000000000000013e02b6052719f607dacd3a088274f65596bd0d09920b61ab5da61bbdc7f5049334cf11213945d57e5ac7d055d042b7e"
+    "000000000000000000000000000000000ce5d527727d6e118cc9cdc6da2e351aadfd9baa8cbdd3a76d429a695160d12c923ac9cc3baca289e193548608b82801000000000000000000000000000000000606c4a02ea734cc32acd2b02bc28b99cb3e287e85a763af267492ab572e99ab3f370d275cec1da1aaa9075ff05f79be"_hex;
+
+template <unsigned NumThreads>
+void bls12_pairing_check_parallel(benchmark::State& state)
+{
+    pairing_parallel<bls12_pairing_check_execute, NumThreads>(state, bls12_generators_pair);
+}
+BENCHMARK_TEMPLATE(bls12_pairing_check_parallel, 0)->RangeMultiplier(2)->Range(8, 64);
+BENCHMARK_TEMPLATE(bls12_pairing_check_parallel, 4)->RangeMultiplier(2)->Range(8, 64);
 }  // namespace bench_ecpairing
 
+namespace bench_sha256
+{
+/// Computes the SHA256 hashes of the given number of inputs of the given size
+/// one by one or in a batch.
+template <bool Batch>
+void sha256_inputs(benchmark::State& state)
+{
+    using namespace evmone::crypto;
+
+    const auto size = static_cast<size_t>(state.range(0));
+    const auto n = static_cast<size_t>(state.range(1));
+    std::vector<std::byte> data(n * size);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<std::byte>(i);
+    std::vector<const std::byte*> inputs(n);
+    const std::vector<size_t> sizes(n, size);
+    for (size_t i = 0; i < n; ++i)
+        inputs[i] = &data[i * size];
+    std::vector<std::byte> hashes(n * SHA256_HASH_SIZE);
+
+    for ([[maybe_unused]] auto _ : state)
+    {
+        if constexpr (Batch)
+            sha256_batch(hashes.data(), inputs.data(), sizes.data(), n);
+        else
+        {
+            for (size_t i = 0; i < n; ++i)
+                sha256(&hashes[i * SHA256_HASH_SIZE], inputs[i], size);
+        }
+        benchmark::DoNotOptimize(hashes.data());
+    }
+
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * n));
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * n * size));
+}
+BENCHMARK_TEMPLATE(sha256_inputs, false)->ArgsProduct({{32, 64, 1024, 4096}, {1, 64}});
+BENCHMARK_TEMPLATE(sha256_inputs, true)->ArgsProduct({{32, 64, 1024, 4096}, {1, 64}});
+}  // namespace bench_sha256
+
 namespace bench_kzg
 {
 constexpr auto evmone_blst = point_evaluation_execute;
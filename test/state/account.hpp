@@ -3,9 +3,10 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "code.hpp"
+#include "flat_hash_map.hpp"
 #include <evmc/evmc.hpp>
 #include <intx/intx.hpp>
-#include <unordered_map>
 
 namespace evmone::state
 {
@@ -48,16 +49,16 @@ struct Account
     bool has_initial_storage = false;
 
     /// The cached and modified account storage entries.
-    std::unordered_map<bytes32, StorageValue> storage;
+    FlatHashMap<bytes32, StorageValue> storage;
 
     /// The EIP-1153 transient (transaction-level lifetime) storage.
-    std::unordered_map<bytes32, bytes32> transient_storage;
+    FlatHashMap<bytes32, bytes32> transient_storage;
 
     /// The cache of the account code.
     ///
     /// Check code_hash to know if an account code is empty.
     /// Empty here only means it has not been loaded from the initial storage.
-    bytes code;
+    Code code;
 
     /// The account has been destructed and should be erased at the end of a transaction.
     bool destructed = false;
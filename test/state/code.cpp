@@ -0,0 +1,124 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "code.hpp"
+#include "account.hpp"
+#include "hash_utils.hpp"
+#include <evmone/delegation.hpp>
+#include <evmone/eof.hpp>
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace evmone::state
+{
+struct Code::Data
+{
+    bytes code;
+    bytes32 hash;
+    bool eof = false;
+    std::optional<address> delegate;
+};
+
+namespace
+{
+/// The process-wide store of the codes currently held by any Code handle.
+class CodeStore
+{
+    /// The minimal number of entries triggering the removal of the expired entries.
+    static constexpr size_t MIN_PURGE_THRESHOLD = 1024;
+
+    std::mutex m_mutex;
+    std::unordered_map<bytes32, std::weak_ptr<const Code::Data>> m_codes;
+    size_t m_purge_threshold = MIN_PURGE_THRESHOLD;
+
+    /// Removes the entries of the codes not held anymore. Must be called with the lock held.
+    void purge()
+    {
+        std::erase_if(m_codes, [](const auto& entry) { return entry.second.expired(); });
+        m_purge_threshold = std::max(MIN_PURGE_THRESHOLD, 2 * m_codes.size());
+    }
+
+public:
+    static CodeStore& instance()
+    {
+        static CodeStore store;
+        return store;
+    }
+
+    std::shared_ptr<const Code::Data> find(const bytes32& code_hash)
+    {
+        const std::lock_guard lock{m_mutex};
+        const auto it = m_codes.find(code_hash);
+        return it != m_codes.end() ? it->second.lock() : nullptr;
+    }
+
+    std::shared_ptr<const Code::Data> intern(bytes_view code, const bytes32& code_hash)
+    {
+        if (auto data = find(code_hash))
+            return data;
+
+        // Prepare the new entry without holding the lock.
+        std::optional<address> delegate;
+        if (is_code_delegated(code) && code.size() == DELEGATION_MAGIC.size() + sizeof(address))
+        {
+            delegate.emplace();
+            std::copy_n(&code[DELEGATION_MAGIC.size()], sizeof(address), delegate->bytes);
+        }
+        auto new_data = std::make_shared<const Code::Data>(
+            Code::Data{bytes{code}, code_hash, is_eof_container(code), delegate});
+
+        const std::lock_guard lock{m_mutex};
+        auto& entry = m_codes[code_hash];
+        if (auto data = entry.lock())  // Interned by another thread in the meantime.
+            return data;
+        entry = new_data;
+        if (m_codes.size() >= m_purge_threshold)
+            purge();
+        return new_data;
+    }
+};
+}  // namespace
+
+Code::Code(bytes_view code)
+  : Code{code, code.empty() ? Account::EMPTY_CODE_HASH : keccak256(code)}
+{}
+
+Code::Code(bytes_view code, const bytes32& code_hash)
+{
+    if (!code.empty())
+        m_data = CodeStore::instance().intern(code, code_hash);
+}
+
+std::optional<Code> Code::find(const bytes32& code_hash)
+{
+    if (code_hash == Account::EMPTY_CODE_HASH)
+        return Code{};
+    if (auto data = CodeStore::instance().find(code_hash))
+        return Code{std::move(data)};
+    return std::nullopt;
+}
+
+bytes_view Code::view() const noexcept
+{
+    // The empty code has non-null data pointer like the empty bytes.
+    static constexpr uint8_t empty_code[1]{};
+    return m_data != nullptr ? bytes_view{m_data->code} : bytes_view{empty_code, 0};
+}
+
+const bytes32& Code::hash() const noexcept
+{
+    return m_data != nullptr ? m_data->hash : Account::EMPTY_CODE_HASH;
+}
+
+bool Code::is_eof() const noexcept
+{
+    return m_data != nullptr && m_data->eof;
+}
+
+std::optional<address> Code::delegate() const noexcept
+{
+    return m_data != nullptr ? m_data->delegate : std::nullopt;
+}
+}  // namespace evmone::state
@@ -0,0 +1,70 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <evmc/evmc.hpp>
+#include <memory>
+#include <optional>
+
+namespace evmone::state
+{
+using evmc::address;
+using evmc::bytes;
+using evmc::bytes32;
+using evmc::bytes_view;
+
+/// The immutable account code.
+///
+/// This is a cheap-to-copy handle to the code bytes shared by all accounts and states having
+/// the same code. The code is interned in the process-wide store keyed by the code hash,
+/// so the popular contracts are loaded and kept in memory once. The code properties
+/// (the EOF format, the EIP-7702 delegation) are computed once at the interning.
+/// The default-constructed handle is the empty code.
+class Code
+{
+public:
+    struct Data;
+
+private:
+    std::shared_ptr<const Data> m_data;
+
+    explicit Code(std::shared_ptr<const Data> data) noexcept : m_data{std::move(data)} {}
+
+public:
+    Code() noexcept = default;
+
+    /// Interns the code.
+    explicit Code(bytes_view code);
+
+    /// Interns the code with the known code hash (the hash is not verified).
+    Code(bytes_view code, const bytes32& code_hash);
+
+    /// Returns the interned code with the given hash if it is currently held by any handle.
+    [[nodiscard]] static std::optional<Code> find(const bytes32& code_hash);
+
+    [[nodiscard]] bytes_view view() const noexcept;
+    operator bytes_view() const noexcept { return view(); }  // NOLINT(*-explicit-*)
+
+    [[nodiscard]] const uint8_t* data() const noexcept { return view().data(); }
+    [[nodiscard]] size_t size() const noexcept { return view().size(); }
+    [[nodiscard]] bool empty() const noexcept { return m_data == nullptr; }
+
+    /// The keccak256 hash of the code.
+    [[nodiscard]] const bytes32& hash() const noexcept;
+
+    /// Whether the code is the EOF container.
+    [[nodiscard]] bool is_eof() const noexcept;
+
+    /// The EIP-7702 delegate address if the code is the delegation designator.
+    [[nodiscard]] std::optional<address> delegate() const noexcept;
+
+    /// Checks if two handles refer to the same code.
+    friend bool operator==(const Code& a, const Code& b) noexcept
+    {
+        return a.m_data == b.m_data || a.hash() == b.hash();
+    }
+
+    friend bool operator==(const Code& a, bytes_view b) noexcept { return a.view() == b; }
+};
+}  // namespace evmone::state
@@ -0,0 +1,548 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <intx/intx.hpp>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define EVMONE_FLAT_HASH_MAP_SSE2 1
+#endif
+
+namespace evmone::state
+{
+/// The hash map with open addressing.
+///
+/// The layout follows the "Swiss table" design: the entries are stored inline in a single array
+/// and each entry has a 1-byte control word holding 7 bits of the entry's hash or the empty
+/// or deleted marker. The lookup matches the control words of a group of 16 entries
+/// at once (using SSE2 if available) and compares keys only for the matching entries.
+/// The map is optimized for small keys with cheap comparison, like addresses and 32-byte words.
+///
+/// The interface is a subset of the std::unordered_map interface with the following differences:
+/// - the insertion invalidates all iterators, pointers and references to entries,
+/// - clear() keeps the allocated memory.
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class FlatHashMap
+{
+public:
+    using key_type = Key;
+    using mapped_type = Value;
+    using value_type = std::pair<const Key, Value>;
+    using size_type = size_t;
+
+private:
+    using ctrl_t = int8_t;
+
+    static constexpr ctrl_t EMPTY = -128;  // 0b10000000
+    static constexpr ctrl_t DELETED = -2;  // 0b11111110
+
+    /// The number of entries probed at once.
+    static constexpr size_t GROUP_SIZE = 16;
+
+    /// The group of control words with the bitmasks of the matching entries.
+    struct Group
+    {
+#ifdef EVMONE_FLAT_HASH_MAP_SSE2
+        __m128i ctrl;
+
+        explicit Group(const ctrl_t* p) noexcept
+          : ctrl{_mm_loadu_si128(reinterpret_cast<const __m128i*>(p))}
+        {}
+
+        [[nodiscard]] uint32_t match(ctrl_t c) const noexcept
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(ctrl, _mm_set1_epi8(c))));
+        }
+
+        [[nodiscard]] uint32_t match_empty() const noexcept { return match(EMPTY); }
+
+        /// Matches the empty and deleted entries (the control words with the top bit set).
+        [[nodiscard]] uint32_t match_free() const noexcept
+        {
+            return static_cast<uint32_t>(_mm_movemask_epi8(ctrl));
+        }
+#else
+        const ctrl_t* ctrl;
+
+        explicit Group(const ctrl_t* p) noexcept : ctrl{p} {}
+
+        [[nodiscard]] uint32_t match(ctrl_t c) const noexcept
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_SIZE; ++i)
+                mask |= uint32_t{ctrl[i] == c} << i;
+            return mask;
+        }
+
+        [[nodiscard]] uint32_t match_empty() const noexcept { return match(EMPTY); }
+
+        [[nodiscard]] uint32_t match_free() const noexcept
+        {
+            uint32_t mask = 0;
+            for (size_t i = 0; i < GROUP_SIZE; ++i)
+                mask |= uint32_t{ctrl[i] < 0} << i;
+            return mask;
+        }
+#endif
+    };
+
+    /// The control words. The size is the capacity, a multiple of GROUP_SIZE.
+    std::unique_ptr<ctrl_t[]> m_ctrl;
+
+    /// The entries storage. Only the entries with the non-negative control word are alive.
+    value_type* m_slots = nullptr;
+
+    size_t m_capacity = 0;
+    size_t m_size = 0;
+
+    /// The number of entries which can be inserted into empty slots before the rehash.
+    /// The deleted slots are not counted as they are reused only by the insertions.
+    size_t m_growth_left = 0;
+
+    [[no_unique_address]] Hash m_hash;
+
+    /// Computes the hash of the key.
+    ///
+    /// The std::hash of the key is additionally mixed (the halves of the full 128-bit product
+    /// are folded) because all bits of the hash are used for open addressing. E.g. the evmc hash
+    /// of small 32-byte numbers (storage slots) differs only in the high bits.
+    [[nodiscard]] uint64_t hash(const Key& key) const noexcept
+    {
+        const auto m = intx::umul(static_cast<uint64_t>(m_hash(key)), 0x9e3779b97f4a7c15);
+        return m[0] ^ m[1];
+    }
+
+    /// The 7 bits of the hash stored in the control word.
+    static ctrl_t h2(uint64_t h) noexcept { return static_cast<ctrl_t>(h & 0x7f); }
+
+    /// The hash bits selecting the first group to probe.
+    static size_t h1(uint64_t h) noexcept { return static_cast<size_t>(h >> 7); }
+
+    /// The maximum number of entries for the capacity (the load factor 7/8).
+    static size_t max_size_for(size_t capacity) noexcept { return capacity - capacity / 8; }
+
+    /// The probe sequence visiting all groups: the group index is incremented
+    /// by the triangular numbers.
+    class ProbeSeq
+    {
+        size_t m_mask;
+        size_t m_group;
+        size_t m_step = 0;
+
+    public:
+        ProbeSeq(uint64_t h, size_t num_groups) noexcept
+          : m_mask{num_groups - 1}, m_group{h1(h) & m_mask}
+        {}
+
+        [[nodiscard]] size_t offset() const noexcept { return m_group * GROUP_SIZE; }
+
+        void next() noexcept
+        {
+            ++m_step;
+            m_group = (m_group + m_step) & m_mask;
+        }
+    };
+
+    [[nodiscard]] size_t num_groups() const noexcept { return m_capacity / GROUP_SIZE; }
+
+    /// Finds the index of the entry with the key and hash or returns the capacity if not found.
+    [[nodiscard]] size_t find_index(const Key& key, uint64_t h) const noexcept
+    {
+        if (m_size == 0)
+            return m_capacity;
+
+        for (ProbeSeq seq{h, num_groups()};; seq.next())
+        {
+            const auto offset = seq.offset();
+            const Group g{&m_ctrl[offset]};
+            for (auto mask = g.match(h2(h)); mask != 0; mask &= mask - 1)
+            {
+                const auto index = offset + static_cast<size_t>(std::countr_zero(mask));
+                if (m_slots[index].first == key) [[likely]]
+                    return index;
+            }
+            if (g.match_empty() != 0) [[likely]]
+                return m_capacity;
+        }
+    }
+
+    /// Finds the free slot for the new entry with the given hash.
+    /// The map must have at least one empty slot.
+    [[nodiscard]] size_t find_free_index(uint64_t h) const noexcept
+    {
+        for (ProbeSeq seq{h, num_groups()};; seq.next())
+        {
+            if (const auto mask = Group{&m_ctrl[seq.offset()]}.match_free(); mask != 0)
+                return seq.offset() + static_cast<size_t>(std::countr_zero(mask));
+        }
+    }
+
+    void destroy_slots() noexcept
+    {
+        if constexpr (!std::is_trivially_destructible_v<value_type>)
+        {
+            for (size_t i = 0; i < m_capacity; ++i)
+            {
+                if (m_ctrl[i] >= 0)
+                    std::destroy_at(&m_slots[i]);
+            }
+        }
+    }
+
+    void deallocate() noexcept
+    {
+        std::allocator<value_type>{}.deallocate(m_slots, m_capacity);
+        m_slots = nullptr;
+        m_ctrl.reset();
+        m_capacity = 0;
+    }
+
+    /// Moves all entries to the newly allocated storage of the given capacity.
+    void rehash(size_t new_capacity)
+    {
+        assert(new_capacity % GROUP_SIZE == 0 && std::has_single_bit(new_capacity));
+        assert(max_size_for(new_capacity) > m_size);
+
+        auto old_ctrl = std::move(m_ctrl);
+        auto* const old_slots = m_slots;
+        const auto old_capacity = m_capacity;
+
+        m_ctrl = std::make_unique_for_overwrite<ctrl_t[]>(new_capacity);
+        std::memset(m_ctrl.get(), EMPTY, new_capacity);
+        m_slots = std::allocator<value_type>{}.allocate(new_capacity);
+        m_capacity = new_capacity;
+        m_growth_left = max_size_for(new_capacity) - m_size;
+
+        for (size_t i = 0; i < old_capacity; ++i)
+        {
+            if (old_ctrl[i] < 0)
+                continue;
+            auto& old_slot = old_slots[i];
+            const auto h = hash(old_slot.first);
+            const auto index = find_free_index(h);
+            m_ctrl[index] = h2(h);
+            // The key is const in the value_type, so the entries are moved by reconstruction.
+            std::construct_at(&m_slots[index], std::move(const_cast<Key&>(old_slot.first)),
+                std::move(old_slot.second));
+            std::destroy_at(&old_slot);
+        }
+        std::allocator<value_type>{}.deallocate(old_slots, old_capacity);
+    }
+
+    /// Prepares the storage for inserting one more entry.
+    void reserve_one()
+    {
+        if (m_growth_left != 0)
+            return;
+
+        // Reclaim the deleted slots if they are the majority of the used slots.
+        // Otherwise, grow the capacity.
+        const auto used = max_size_for(m_capacity);
+        const auto new_capacity =
+            m_capacity == 0 ? GROUP_SIZE : (m_size <= used / 2 ? m_capacity : m_capacity * 2);
+        rehash(new_capacity);
+    }
+
+    [[nodiscard]] size_t find_index(const Key& key) const noexcept
+    {
+        return find_index(key, hash(key));
+    }
+
+    /// Inserts a new entry constructed from the arguments. The key must not be in the map.
+    template <typename K, typename... Args>
+    size_t insert_new(uint64_t h, K&& key, Args&&... args)
+    {
+        reserve_one();
+        const auto index = find_free_index(h);
+        std::construct_at(&m_slots[index], std::piecewise_construct,
+            std::forward_as_tuple(std::forward<K>(key)),
+            std::forward_as_tuple(std::forward<Args>(args)...));
+        if (m_ctrl[index] == EMPTY)
+            --m_growth_left;
+        m_ctrl[index] = h2(h);
+        ++m_size;
+        return index;
+    }
+
+    template <typename V>
+    class Iterator
+    {
+        friend class FlatHashMap;
+
+        const ctrl_t* m_ctrl = nullptr;
+        const ctrl_t* m_ctrl_end = nullptr;
+        V* m_slot = nullptr;
+
+        Iterator(const ctrl_t* ctrl, const ctrl_t* ctrl_end, V* slot) noexcept
+          : m_ctrl{ctrl}, m_ctrl_end{ctrl_end}, m_slot{slot}
+        {}
+
+        void skip_free() noexcept
+        {
+            while (m_ctrl != m_ctrl_end && *m_ctrl < 0)
+            {
+                ++m_ctrl;
+                ++m_slot;
+            }
+        }
+
+    public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = FlatHashMap::value_type;
+        using difference_type = std::ptrdiff_t;
+        using pointer = V*;
+        using reference = V&;
+
+        Iterator() noexcept = default;
+
+        /// Converts the iterator to the const iterator.
+        operator Iterator<const value_type>() const noexcept  // NOLINT(*-explicit-*)
+        {
+            return {m_ctrl, m_ctrl_end, m_slot};
+        }
+
+        reference operator*() const noexcept { return *m_slot; }
+        pointer operator->() const noexcept { return m_slot; }
+
+        Iterator& operator++() noexcept
+        {
+            ++m_ctrl;
+            ++m_slot;
+            skip_free();
+            return *this;
+        }
+
+        Iterator operator++(int) noexcept
+        {
+            auto it = *this;
+            ++*this;
+            return it;
+        }
+
+        friend bool operator==(const Iterator& a, const Iterator& b) noexcept
+        {
+            return a.m_ctrl == b.m_ctrl;
+        }
+    };
+
+    template <typename V>
+    Iterator<V> make_iterator(V* slots, size_t index) const noexcept
+    {
+        const auto* const ctrl_end = m_ctrl.get() + m_capacity;
+        return {m_ctrl.get() + index, ctrl_end, slots + index};
+    }
+
+public:
+    using iterator = Iterator<value_type>;
+    using const_iterator = Iterator<const value_type>;
+
+    FlatHashMap() noexcept = default;
+
+    FlatHashMap(std::initializer_list<value_type> init)
+    {
+        for (const auto& [k, v] : init)
+            insert_or_assign(k, v);
+    }
+
+    FlatHashMap(const FlatHashMap& other)
+    {
+        if (other.m_size == 0)
+            return;
+        size_t capacity = GROUP_SIZE;
+        while (max_size_for(capacity) <= other.m_size)
+            capacity *= 2;
+        rehash(capacity);
+        for (const auto& [k, v] : other)
+            insert_new(hash(k), k, v);
+    }
+
+    FlatHashMap(FlatHashMap&& other) noexcept { swap(other); }
+
+    FlatHashMap& operator=(const FlatHashMap& other)
+    {
+        if (this != &other)
+        {
+            FlatHashMap copy{other};
+            swap(copy);
+        }
+        return *this;
+    }
+
+    FlatHashMap& operator=(FlatHashMap&& other) noexcept
+    {
+        FlatHashMap tmp{std::move(other)};
+        swap(tmp);
+        return *this;
+    }
+
+    ~FlatHashMap()
+    {
+        destroy_slots();
+        deallocate();
+    }
+
+    void swap(FlatHashMap& other) noexcept
+    {
+        using std::swap;
+        swap(m_ctrl, other.m_ctrl);
+        swap(m_slots, other.m_slots);
+        swap(m_capacity, other.m_capacity);
+        swap(m_size, other.m_size);
+        swap(m_growth_left, other.m_growth_left);
+        swap(m_hash, other.m_hash);
+    }
+
+    [[nodiscard]] size_t size() const noexcept { return m_size; }
+    [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+    [[nodiscard]] size_t capacity() const noexcept { return m_capacity; }
+
+    iterator begin() noexcept
+    {
+        auto it = make_iterator(m_slots, 0);
+        it.skip_free();
+        return it;
+    }
+    iterator end() noexcept { return make_iterator(m_slots, m_capacity); }
+    const_iterator begin() const noexcept
+    {
+        auto it = make_iterator<const value_type>(m_slots, 0);
+        it.skip_free();
+        return it;
+    }
+    const_iterator end() const noexcept
+    {
+        return make_iterator<const value_type>(m_slots, m_capacity);
+    }
+
+    iterator find(const Key& key) noexcept { return make_iterator(m_slots, find_index(key)); }
+    const_iterator find(const Key& key) const noexcept
+    {
+        return make_iterator<const value_type>(m_slots, find_index(key));
+    }
+
+    [[nodiscard]] bool contains(const Key& key) const noexcept
+    {
+        return find_index(key) != m_capacity;
+    }
+
+    [[nodiscard]] size_t count(const Key& key) const noexcept { return contains(key) ? 1 : 0; }
+
+    Value& at(const Key& key)
+    {
+        const auto index = find_index(key);
+        if (index == m_capacity)
+            throw std::out_of_range{"FlatHashMap::at"};
+        return m_slots[index].second;
+    }
+    const Value& at(const Key& key) const { return const_cast<FlatHashMap&>(*this).at(key); }
+
+    template <typename... Args>
+    std::pair<iterator, bool> try_emplace(const Key& key, Args&&... args)
+    {
+        const auto h = hash(key);
+        if (const auto index = find_index(key, h); index != m_capacity)
+            return {make_iterator(m_slots, index), false};
+        return {make_iterator(m_slots, insert_new(h, key, std::forward<Args>(args)...)), true};
+    }
+
+    std::pair<iterator, bool> insert(value_type&& entry)
+    {
+        return try_emplace(entry.first, std::move(entry.second));
+    }
+
+    std::pair<iterator, bool> insert(const value_type& entry)
+    {
+        return try_emplace(entry.first, entry.second);
+    }
+
+    template <typename V>
+    std::pair<iterator, bool> insert_or_assign(const Key& key, V&& value)
+    {
+        auto r = try_emplace(key, std::forward<V>(value));
+        if (!r.second)
+            r.first->second = std::forward<V>(value);
+        return r;
+    }
+
+    Value& operator[](const Key& key) { return try_emplace(key).first->second; }
+
+    /// Erases the entry pointed by the iterator. Other iterators stay valid.
+    void erase(const_iterator pos) noexcept
+    {
+        const auto index = static_cast<size_t>(pos.m_ctrl - m_ctrl.get());
+        assert(index < m_capacity && m_ctrl[index] >= 0);
+        std::destroy_at(&m_slots[index]);
+        --m_size;
+
+        // The groups are aligned and the empty slots are created only by clearing all entries.
+        // So if the group has an empty slot it has never been passed by a probe sequence
+        // and the slot can be marked empty instead of deleted.
+        const auto group_offset = index - index % GROUP_SIZE;
+        if (Group{&m_ctrl[group_offset]}.match_empty() != 0)
+        {
+            m_ctrl[index] = EMPTY;
+            ++m_growth_left;
+        }
+        else
+            m_ctrl[index] = DELETED;
+    }
+
+    void erase(iterator pos) noexcept { erase(const_iterator{pos}); }
+
+    size_t erase(const Key& key) noexcept
+    {
+        const auto index = find_index(key);
+        if (index == m_capacity)
+            return 0;
+        erase(make_iterator<const value_type>(m_slots, index));
+        return 1;
+    }
+
+    /// Erases all entries. The allocated memory is kept for reuse.
+    void clear() noexcept
+    {
+        if (m_capacity == 0)
+            return;
+        destroy_slots();
+        std::memset(m_ctrl.get(), EMPTY, m_capacity);
+        m_size = 0;
+        m_growth_left = max_size_for(m_capacity);
+    }
+
+    /// Prepares the map for the given number of entries without rehashing.
+    void reserve(size_t n)
+    {
+        size_t capacity = GROUP_SIZE;
+        while (max_size_for(capacity) <= n)
+            capacity *= 2;
+        if (capacity > m_capacity)
+            rehash(capacity);
+    }
+
+    friend bool operator==(const FlatHashMap& a, const FlatHashMap& b)
+    {
+        if (a.size() != b.size())
+            return false;
+        for (const auto& [k, v] : a)
+        {
+            const auto it = b.find(k);
+            if (it == b.end() || !(it->second == v))
+                return false;
+        }
+        return true;
+    }
+};
+}  // namespace evmone::state
@@ -8,6 +8,8 @@
 #include <evmc/hex.hpp>
 #include <evmone_precompiles/keccak.hpp>
 #include <bit>
+#include <span>
+#include <vector>
 
 namespace evmone
 {
@@ -31,4 +33,19 @@ inline hash256 keccak256(bytes_view data) noexcept
 {
     return std::bit_cast<hash256>(ethash::keccak256(data.data(), data.size()));
 }
+
+/// Computes Keccak hashes of multiple inputs of the same size
+/// (wrapper of ethash::keccak256_batch).
+inline std::vector<hash256> keccak256_batch(std::span<const uint8_t* const> inputs, size_t size)
+{
+    const std::vector<size_t> sizes(inputs.size(), size);
+    std::vector<ethash::hash256> hashes(inputs.size());
+    ethash::keccak256_batch(hashes.data(), inputs.data(), sizes.data(), inputs.size());
+
+    std::vector<hash256> result;
+    result.reserve(hashes.size());
+    for (const auto& h : hashes)
+        result.emplace_back(std::bit_cast<hash256>(h));
+    return result;
+}
 }  // namespace evmone
@@ -70,6 +70,8 @@ evmc_storage_status Host::set_storage(
 
 uint256be Host::get_balance(const address& addr) const noexcept
 {
+    if (addr == m_block.coinbase)
+        m_coinbase_balance_read = true;
     const auto* const acc = m_state.find(addr);
     return (acc != nullptr) ? intx::be::store<uint256be>(acc->balance) : uint256be{};
 }
@@ -79,9 +81,9 @@ namespace
 /// For EXTCODE* instructions if the target is an EOF account, then only return EF00.
 /// While we only do this if the caller is legacy, it is not a problem doing this
 /// unconditionally, because EOF contracts dot no have EXTCODE* instructions.
-bytes_view extcode(bytes_view code) noexcept
+bytes_view extcode(const Code& code) noexcept
 {
-    return is_eof_container(code) ? code.substr(0, 2) : code;
+    return code.is_eof() ? code.view().substr(0, 2) : code.view();
 }
 
 /// Check if an existing account is the "create collision"
@@ -108,8 +110,7 @@ bytes_view extcode(bytes_view code) noexcept
 
 size_t Host::get_code_size(const address& addr) const noexcept
 {
-    const auto raw_code = m_state.get_code(addr);
-    return extcode(raw_code).size();
+    return extcode(m_state.get_code(addr)).size();
 }
 
 bytes32 Host::get_code_hash(const address& addr) const noexcept
@@ -120,7 +121,7 @@ bytes32 Host::get_code_hash(const address& addr) const noexcept
 
     // Load code and check if not EOF.
     // TODO: Optimize the second account lookup here.
-    if (is_eof_container(m_state.get_code(addr)))
+    if (m_state.get_code(addr).is_eof())
         return EOF_CODE_HASH_SENTINEL;
 
     return acc->code_hash;
@@ -129,8 +130,7 @@ bytes32 Host::get_code_hash(const address& addr) const noexcept
 size_t Host::copy_code(const address& addr, size_t code_offset, uint8_t* buffer_data,
     size_t buffer_size) const noexcept
 {
-    const auto raw_code = m_state.get_code(addr);
-    const auto code = extcode(raw_code);
+    const auto code = extcode(m_state.get_code(addr));
     const auto code_slice = code.substr(std::min(code_offset, code.size()));
     const auto num_bytes = std::min(buffer_size, code_slice.size());
     std::copy_n(code_slice.begin(), num_bytes, buffer_data);
@@ -143,6 +143,8 @@ bool Host::selfdestruct(const address& addr, const address& beneficiary) noexcep
         m_state.journal_create(beneficiary, false);
     auto& acc = m_state.get(addr);
     const auto balance = acc.balance;
+    if (addr == m_block.coinbase)
+        m_coinbase_balance_read = true;
     auto& beneficiary_acc = m_state.touch(beneficiary);
 
     m_state.journal_balance_change(beneficiary, beneficiary_acc.balance);
@@ -389,7 +391,7 @@ evmc::Result Host::create(const evmc_message& msg) noexcept
         }
 
         new_acc->code_hash = keccak256(code);
-        new_acc->code = code;
+        new_acc->code = Code{code, new_acc->code_hash};
         new_acc->code_changed = true;
     }
 
@@ -55,6 +55,9 @@ class Host : public evmc::Host
     std::vector<Log> m_logs;
     std::vector<evmc_tx_initcode> m_tx_initcodes;
 
+    /// Whether the EVM has read the balance of the block coinbase account.
+    mutable bool m_coinbase_balance_read = false;
+
 public:
     Host(evmc_revision rev, evmc::VM& vm, State& state, const BlockInfo& block,
         const BlockHashes& block_hashes, const Transaction& tx) noexcept
@@ -72,6 +75,10 @@ public:
 
     [[nodiscard]] std::vector<Log>&& take_logs() noexcept { return std::move(m_logs); }
 
+    /// Returns true if the EVM has read the balance of the block coinbase account
+    /// (BALANCE, SELFBALANCE, value transfer checks or SELFDESTRUCT of the coinbase).
+    [[nodiscard]] bool coinbase_balance_read() const noexcept { return m_coinbase_balance_read; }
+
     evmc::Result call(const evmc_message& msg) noexcept override;
 
 private:
@@ -0,0 +1,106 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace evmone::state
+{
+/// The append-only log of entries of the given types with the rollback to a checkpoint.
+///
+/// The entries are stored in a single byte buffer, each as the entry bytes followed by
+/// the 1-byte type tag. Therefore, an entry takes only its own size instead of the size of
+/// the largest entry type (like in std::vector<std::variant>). The entries are read back
+/// from the end of the buffer: the tag of the last entry determines its type and size.
+template <typename... Entries>
+class Journal
+{
+    static_assert(sizeof...(Entries) <= 256);
+    static_assert((std::is_trivially_copyable_v<Entries> && ...));
+
+    using tag_t = uint8_t;
+
+    std::vector<uint8_t> m_data;
+
+    template <typename T, size_t I = 0, typename First, typename... Rest>
+    static consteval tag_t tag_of_impl()
+    {
+        if constexpr (std::is_same_v<T, First>)
+            return I;
+        else
+        {
+            static_assert(sizeof...(Rest) != 0, "not a journal entry type");
+            return tag_of_impl<T, I + 1, Rest...>();
+        }
+    }
+
+    /// The tag of the entry type (its index in the Entries list).
+    template <typename T>
+    static constexpr tag_t tag_of = tag_of_impl<T, 0, Entries...>();
+
+    /// Copies out the entry of the type T which ends at the given position and passes it
+    /// to the function. Returns the position of the entry.
+    template <typename T, typename Fn>
+    size_t visit_entry(size_t end, Fn& fn) const
+    {
+        const auto pos = end - sizeof(T);
+        T entry;
+        std::memcpy(&entry, &m_data[pos], sizeof(T));
+        fn(std::as_const(entry));
+        return pos;
+    }
+
+    /// Passes the entry ending (with the tag) at the given position to the function
+    /// and returns the position of the entry.
+    template <typename Fn, size_t... I>
+    size_t visit_before(size_t tag_end, Fn& fn, std::index_sequence<I...>) const
+    {
+        const auto end = tag_end - sizeof(tag_t);
+        const auto tag = m_data[end];
+        size_t pos = 0;
+        [[maybe_unused]] const bool found =
+            ((tag == I ? (pos = visit_entry<Entries>(end, fn), true) : false) || ...);
+        assert(found);
+        return pos;
+    }
+
+public:
+    /// Returns the checkpoint which can be later used in rollback() to revert the entries
+    /// added after it.
+    [[nodiscard]] size_t checkpoint() const noexcept { return m_data.size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return m_data.empty(); }
+
+    /// The size of the journal in bytes.
+    [[nodiscard]] size_t size_bytes() const noexcept { return m_data.size(); }
+
+    /// Appends the entry.
+    template <typename T>
+    void push(const T& entry)
+    {
+        const auto* const bytes = reinterpret_cast<const uint8_t*>(&entry);
+        m_data.insert(m_data.end(), bytes, bytes + sizeof(T));
+        m_data.push_back(tag_of<T>);
+    }
+
+    /// Removes the entries added after the checkpoint. Each entry (in the reverse order)
+    /// is passed to the function which reverts its changes.
+    template <typename Fn>
+    void rollback(size_t checkpoint, Fn&& fn)
+    {
+        assert(checkpoint <= m_data.size());
+        for (auto end = m_data.size(); end != checkpoint;)
+            end = visit_before(end, fn, std::index_sequence_for<Entries...>{});
+        m_data.resize(checkpoint);
+    }
+
+    /// Removes all entries. The allocated memory is kept for reuse.
+    void clear() noexcept { m_data.clear(); }
+};
+}  // namespace evmone::state
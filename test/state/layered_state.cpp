@@ -0,0 +1,243 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "layered_state.hpp"
+#include "account.hpp"
+#include "state_diff.hpp"
+#include <cassert>
+#include <vector>
+
+namespace evmone::test
+{
+LayeredState::LayeredState(std::shared_ptr<const TestState> base) noexcept
+  : m_base{std::move(base)}
+{}
+
+LayeredState::LayeredState(std::shared_ptr<const LayeredState> parent) : m_base{parent->m_base}
+{
+    if (parent->m_depth >= MAX_DEPTH)
+        parent = std::make_shared<const LayeredState>(parent->flatten());
+    m_depth = parent->m_depth + 1;
+    m_parent = std::move(parent);
+}
+
+const LayeredState::AccountEntry* LayeredState::find_entry(const address& addr) const noexcept
+{
+    for (const auto* layer = this; layer != nullptr; layer = layer->m_parent.get())
+    {
+        if (const auto it = layer->m_accounts.find(addr); it != layer->m_accounts.end())
+            return &it->second;
+    }
+    return nullptr;
+}
+
+std::optional<state::StateView::Account> LayeredState::get_account(
+    const address& addr) const
+{
+    const auto* const entry = find_entry(addr);
+    if (entry == nullptr)
+        return m_base->get_account(addr);
+    if (entry->deleted)
+        return std::nullopt;
+    return Account{entry->nonce, entry->balance, entry->code_hash, entry->storage_size != 0};
+}
+
+state::Code LayeredState::get_account_code(const address& addr) const
+{
+    for (const auto* layer = this; layer != nullptr; layer = layer->m_parent.get())
+    {
+        const auto it = layer->m_accounts.find(addr);
+        if (it == layer->m_accounts.end())
+            continue;
+        const auto& entry = it->second;
+        if (entry.deleted)
+            return {};
+        if (entry.code.has_value())
+            return *entry.code;
+    }
+    return m_base->get_account_code(addr);
+}
+
+bytes32 LayeredState::get_storage(const address& addr, const bytes32& key) const noexcept
+{
+    for (const auto* layer = this; layer != nullptr; layer = layer->m_parent.get())
+    {
+        const auto it = layer->m_accounts.find(addr);
+        if (it == layer->m_accounts.end())
+            continue;
+        const auto& entry = it->second;
+        if (entry.deleted)
+            return {};
+        if (const auto sit = entry.storage.find(key); sit != entry.storage.end())
+            return sit->second;
+        if (entry.storage_cleared)
+            return {};
+    }
+    return m_base->get_storage(addr, key);
+}
+
+size_t LayeredState::get_storage_size(const address& addr) const noexcept
+{
+    if (const auto* const entry = find_entry(addr); entry != nullptr)
+        return entry->deleted ? 0 : entry->storage_size;
+    const auto it = m_base->find(addr);
+    return it != m_base->end() ? it->second.storage.size() : 0;
+}
+
+LayeredState::AccountEntry& LayeredState::modify(const address& addr)
+{
+    if (const auto it = m_accounts.find(addr); it != m_accounts.end())
+    {
+        if (!it->second.deleted)
+            return it->second;
+        return it->second = {.storage_cleared = true,
+                   .code_hash = state::Account::EMPTY_CODE_HASH,
+                   .code = state::Code{}};
+    }
+
+    // The account is not in this layer yet: copy its properties from the parent layers.
+    // The modified storage entries and the code are looked up in the parent layers on demand.
+    if (const auto acc = get_account(addr); acc.has_value())
+    {
+        const auto storage_size = get_storage_size(addr);
+        return m_accounts[addr] = {.nonce = acc->nonce,
+                   .balance = acc->balance,
+                   .code_hash = acc->code_hash,
+                   .storage_size = storage_size};
+    }
+
+    return m_accounts[addr] = {.storage_cleared = true,
+               .code_hash = state::Account::EMPTY_CODE_HASH,
+               .code = state::Code{}};
+}
+
+void LayeredState::apply(const state::StateDiff& diff)
+{
+    for (const auto& addr : diff.deleted_accounts)
+        m_accounts.insert_or_assign(addr, AccountEntry{.deleted = true});
+
+    for (const auto& m : diff.modified_accounts)
+    {
+        auto& a = modify(m.addr);
+        a.nonce = m.nonce;
+        a.balance = m.balance;
+        if (m.code.has_value())
+        {
+            a.code = state::Code{*m.code};
+            a.code_hash = a.code->hash();
+        }
+        for (const auto& [k, v] : m.modified_storage)
+        {
+            const bool was_set = !is_zero(get_storage(m.addr, k));
+            const bool is_set = !is_zero(v);
+            if (is_set && !was_set)
+                ++a.storage_size;
+            else if (!is_set && was_set)
+                --a.storage_size;
+
+            // Deleted entries must hide the parent storage unless it is not visible anyway.
+            if (is_set || !a.storage_cleared)
+                a.storage.insert_or_assign(k, v);
+            else
+                a.storage.erase(k);
+        }
+    }
+}
+
+state::StateDiff LayeredState::diff() const
+{
+    state::StateDiff diff;
+    for (const auto& [addr, entry] : m_accounts)
+    {
+        // The account which did not exist in the parent layers doesn't inherit their storage:
+        // it is deleted first (deleting an account missing in the parent layers has no effect).
+        if (entry.deleted || entry.storage_cleared)
+            diff.deleted_accounts.push_back(addr);
+        if (entry.deleted)
+            continue;
+
+        auto& m = diff.modified_accounts.emplace_back(
+            state::StateDiff::Entry{.addr = addr, .nonce = entry.nonce, .balance = entry.balance});
+        if (entry.code.has_value())
+            m.code = bytes{entry.code->view()};
+        m.modified_storage.assign(entry.storage.begin(), entry.storage.end());
+    }
+    return diff;
+}
+
+void LayeredState::merge(AccountEntry& entry, const AccountEntry& child_entry)
+{
+    // The deleted and re-created accounts don't depend on the parent layers.
+    if (child_entry.deleted || child_entry.storage_cleared)
+    {
+        entry = child_entry;
+        return;
+    }
+
+    // Otherwise, the account existed in the parent layers when the child entry was created.
+    assert(!entry.deleted);
+    entry.nonce = child_entry.nonce;
+    entry.balance = child_entry.balance;
+    entry.code_hash = child_entry.code_hash;
+    entry.storage_size = child_entry.storage_size;
+    if (child_entry.code.has_value())
+        entry.code = child_entry.code;
+    for (const auto& [k, v] : child_entry.storage)
+    {
+        if (!is_zero(v) || !entry.storage_cleared)
+            entry.storage.insert_or_assign(k, v);
+        else
+            entry.storage.erase(k);
+    }
+}
+
+LayeredState LayeredState::flatten() const
+{
+    std::vector<const LayeredState*> layers;
+    for (const auto* layer = this; layer != nullptr; layer = layer->m_parent.get())
+        layers.push_back(layer);
+
+    LayeredState flat{m_base};
+    for (auto it = layers.rbegin(); it != layers.rend(); ++it)
+    {
+        for (const auto& [addr, entry] : (*it)->m_accounts)
+        {
+            if (const auto [flat_it, inserted] = flat.m_accounts.try_emplace(addr, entry);
+                !inserted)
+                merge(flat_it->second, entry);
+        }
+    }
+    return flat;
+}
+
+TestState LayeredState::to_test_state() const
+{
+    auto flat = flatten();
+    TestState state(*m_base);
+    for (auto& [addr, entry] : flat.m_accounts)
+    {
+        if (entry.deleted)
+        {
+            state.erase(addr);
+            continue;
+        }
+
+        auto& acc = state[addr];
+        if (entry.storage_cleared)
+            acc = {};
+        acc.nonce = entry.nonce;
+        acc.balance = entry.balance;
+        if (entry.code.has_value())
+            acc.code = bytes{entry.code->view()};
+        for (const auto& [k, v] : entry.storage)
+        {
+            if (!is_zero(v))
+                acc.storage.insert_or_assign(k, v);
+            else
+                acc.storage.erase(k);
+        }
+    }
+    return state;
+}
+}  // namespace evmone::test
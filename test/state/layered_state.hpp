@@ -0,0 +1,103 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "state_diff.hpp"
+#include "test_state.hpp"
+#include <memory>
+#include <unordered_map>
+
+namespace evmone::test
+{
+/// The copy-on-write state layer.
+///
+/// The layer keeps only the accounts modified by the state diffs applied to it.
+/// All other accounts are read from the parent layers and finally from the base TestState.
+/// The parent layers are shared and never modified, so the states of sibling blocks
+/// can be built on top of the state of their common parent block
+/// with the memory proportional to the number of changes in each block.
+///
+/// Lookups walk the chain of layers, so a new layer flattens the chain of its parent
+/// into a single layer once the chain gets longer than MAX_DEPTH.
+class LayeredState : public state::StateView
+{
+    /// The account modified in the layer.
+    struct AccountEntry
+    {
+        /// The account has been deleted. Hides the account of the parent layers.
+        bool deleted = false;
+
+        /// The account did not exist in the parent layers, so their storage is not visible.
+        bool storage_cleared = false;
+
+        uint64_t nonce = 0;
+        uint256 balance;
+        bytes32 code_hash;
+
+        /// The account code if it has been modified in the layer.
+        std::optional<state::Code> code;
+
+        /// The number of non-zero storage entries of the account.
+        size_t storage_size = 0;
+
+        /// The storage entries modified in the layer. The value 0 means the entry is deleted.
+        std::unordered_map<bytes32, bytes32> storage;
+    };
+
+    /// The base state at the bottom of the chain of layers.
+    std::shared_ptr<const TestState> m_base;
+
+    /// The parent layer. Null for the first layer over the base state.
+    std::shared_ptr<const LayeredState> m_parent;
+
+    /// The number of layers in the chain including this one.
+    size_t m_depth = 1;
+
+    std::unordered_map<address, AccountEntry> m_accounts;
+
+    /// Finds the most recent entry of the account in the chain of layers.
+    /// Returns null if the account is not modified in any layer.
+    const AccountEntry* find_entry(const address& addr) const noexcept;
+
+    /// Returns the number of non-zero storage entries of the account.
+    size_t get_storage_size(const address& addr) const noexcept;
+
+    /// Returns the entry of the account in this layer, creates it from the parent layers if needed.
+    AccountEntry& modify(const address& addr);
+
+    /// Merges the entries of the account from a parent layer and a child layer.
+    static void merge(AccountEntry& entry, const AccountEntry& child_entry);
+
+public:
+    /// The maximum length of the chain of layers before it is flattened.
+    static constexpr size_t MAX_DEPTH = 64;
+
+    /// Creates the empty layer over the base state.
+    explicit LayeredState(std::shared_ptr<const TestState> base) noexcept;
+
+    /// Creates the empty layer over the parent layer.
+    explicit LayeredState(std::shared_ptr<const LayeredState> parent);
+
+    /// Returns the number of layers in the chain including this one.
+    [[nodiscard]] size_t depth() const noexcept { return m_depth; }
+
+    std::optional<Account> get_account(const address& addr) const override;
+    state::Code get_account_code(const address& addr) const override;
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override;
+
+    /// Apply the state changes to this layer.
+    void apply(const state::StateDiff& diff);
+
+    /// Returns the changes of this layer over the parent layers.
+    /// Applying them to the parent state results in this state.
+    [[nodiscard]] state::StateDiff diff() const;
+
+    /// Returns the equivalent state consisting of a single layer over the base state.
+    /// The cost is proportional to the number of changes in all the layers.
+    [[nodiscard]] LayeredState flatten() const;
+
+    /// Returns the full copy of the state.
+    [[nodiscard]] TestState to_test_state() const;
+};
+}  // namespace evmone::test
@@ -41,6 +41,13 @@ public:
         std::copy(first, last, m_nibbles);
     }
 
+    /// Constructs a path by concatenating two paths.
+    Path(const Path& head, const Path& tail) noexcept : m_size{head.m_size + tail.m_size}
+    {
+        assert(m_size <= std::size(m_nibbles));
+        std::copy(tail.begin(), tail.end(), std::copy(head.begin(), head.end(), m_nibbles));
+    }
+
     /// Constructs a path from bytes - each byte will produce 2 nibbles in the path.
     explicit Path(bytes_view key) noexcept : m_size{2 * key.size()}
     {
@@ -85,6 +92,10 @@ class MPTNode
     bytes m_value;
     std::unique_ptr<MPTNode> m_children[num_children];
 
+    /// The cached reference to this node used in the parent node encoding
+    /// (see ref()). Empty if the node has been modified since the last encoding.
+    mutable bytes m_ref;
+
     explicit MPTNode(Kind kind, const Path& path = {}, bytes&& value = {}) noexcept
       : m_kind{kind}, m_path{path}, m_value{std::move(value)}
     {}
@@ -135,7 +146,15 @@ public:
 
     void insert(const Path& path, bytes&& value);
 
+    /// Erases the value of the given path if exists.
+    /// Returns true if the node becomes empty and must be removed from its parent.
+    [[nodiscard]] bool erase(const Path& path);
+
     [[nodiscard]] bytes encode() const;
+
+    /// Returns the reference to this node used in the parent node encoding:
+    /// the node encoding if shorter than 32 bytes or the encoded hash of it otherwise.
+    [[nodiscard]] const bytes& ref() const;
 };
 
 void MPTNode::insert(const Path& path, bytes&& value)  // NOLINT(misc-no-recursion)
@@ -144,11 +163,19 @@ void MPTNode::insert(const Path& path, bytes&& value)  // NOLINT(misc-no-recursi
     // in an existing branch node. Otherwise, we need to create new branch node
     // (possibly with an adjusted extended node) and transform existing nodes around it.
 
+    m_ref.clear();  // The node is modified, invalidate the cached reference.
+
     const auto [this_idx, insert_idx] = std::ranges::mismatch(m_path, path);
 
+    if (m_kind == Kind::leaf && this_idx == m_path.end() && insert_idx == path.end())
+    {
+        m_value = std::move(value);  // The key exists: update the value.
+        return;
+    }
+
     // insert_idx is always valid if requirements are fulfilled:
     // - if m_path is not shorter than path they must have mismatched nibbles,
-    //   given the requirement of key uniqueness and not being a prefix if existing key,
+    //   given the requirement of not being a prefix if existing key,
     // - if m_path is shorter and matches the path prefix
     //   then insert_idx points at path[m_path.size()].
     assert(insert_idx != path.end() && "a key must not be a prefix of another key");
@@ -191,7 +218,7 @@ void MPTNode::insert(const Path& path, bytes&& value)  // NOLINT(misc-no-recursi
     case Kind::leaf:
     {
         assert(!m_path.empty());  // Leaf must have non-empty path.
-        assert(this_idx != m_path.end() && "a key must be unique");
+        assert(this_idx != m_path.end() && "a key must not be a prefix of another key");
         auto this_leaf = leaf({this_idx + 1, m_path.end()}, std::move(m_value));
         auto new_leaf = leaf(insert_tail, std::move(value));
         *this =
@@ -204,14 +231,93 @@ void MPTNode::insert(const Path& path, bytes&& value)  // NOLINT(misc-no-recursi
     }
 }
 
-/// Encodes a node and optionally hashes the encoded bytes
-/// if their length exceeds the specified threshold.
-static bytes encode_child(const MPTNode& child) noexcept  // NOLINT(misc-no-recursion)
+bool MPTNode::erase(const Path& path)  // NOLINT(misc-no-recursion)
 {
-    if (auto e = child.encode(); e.size() < 32)
-        return e;  // "short" node
-    else
-        return rlp::encode(keccak256(e));
+    const auto [this_idx, erase_idx] = std::ranges::mismatch(m_path, path);
+    if (this_idx != m_path.end())
+        return false;  // The path diverges: the key does not exist.
+
+    switch (m_kind)
+    {
+    case Kind::leaf:
+    {
+        // The leaf is removed if the key matches. Otherwise, the key does not exist.
+        return erase_idx == path.end();
+    }
+
+    case Kind::ext:
+    {
+        auto& child = m_children[0];
+        [[maybe_unused]] const auto empty = child->erase({erase_idx, path.end()});
+        assert(!empty && "branch node cannot become empty");
+        m_ref.clear();
+
+        // The child branch node might have been collapsed into a leaf or an extended node:
+        // merge this extended node's path into it.
+        if (child->m_kind != Kind::branch)
+        {
+            auto c = std::move(child);
+            const Path merged_path{m_path, c->m_path};
+            *this = std::move(*c);
+            m_path = merged_path;
+            m_ref.clear();
+        }
+        return false;
+    }
+
+    case Kind::branch:
+    {
+        assert(erase_idx != path.end() && "a key must not be a prefix of another key");
+        auto& child = m_children[*erase_idx];
+        if (!child)
+            return false;
+        m_ref.clear();
+
+        if (child->erase({erase_idx + 1, path.end()}))
+            child.reset();
+
+        const auto num_remaining = std::ranges::count_if(
+            m_children, [](const auto& c) noexcept { return c != nullptr; });
+        assert(num_remaining != 0);
+        if (num_remaining == 1)
+        {
+            // The branch node with a single child must be collapsed: the child is joined with
+            // the child index nibble into a leaf or extended node.
+            const auto it = std::ranges::find_if(
+                m_children, [](const auto& c) noexcept { return c != nullptr; });
+            const auto idx = static_cast<uint8_t>(it - std::begin(m_children));
+            const Path idx_path{&idx, &idx + 1};
+            auto c = std::move(*it);
+            if (c->m_kind == Kind::branch)
+                *this = ext(idx_path, std::move(c));
+            else
+            {
+                const Path merged_path{idx_path, c->m_path};
+                *this = std::move(*c);
+                m_path = merged_path;
+                m_ref.clear();
+            }
+        }
+        return false;
+    }
+
+    default:
+        assert(false);
+        return false;
+    }
+}
+
+const bytes& MPTNode::ref() const  // NOLINT(misc-no-recursion)
+{
+    if (m_ref.empty())
+    {
+        // Encodes the node and hashes the encoded bytes if their length exceeds the threshold.
+        if (auto e = encode(); e.size() < 32)
+            m_ref = std::move(e);  // "short" node
+        else
+            m_ref = rlp::encode(keccak256(e));
+    }
+    return m_ref;
 }
 
 bytes MPTNode::encode() const  // NOLINT(misc-no-recursion)
@@ -232,7 +338,7 @@ bytes MPTNode::encode() const  // NOLINT(misc-no-recursion)
         for (const auto& child : m_children)
         {
             if (child)
-                encoded += encode_child(*child);
+                encoded += child->ref();
             else
                 encoded += empty;
         }
@@ -241,7 +347,7 @@ bytes MPTNode::encode() const  // NOLINT(misc-no-recursion)
     }
     case Kind::ext:
     {
-        encoded = rlp::encode(m_path.encode(m_kind)) + encode_child(*m_children[0]);
+        encoded = rlp::encode(m_path.encode(m_kind)) + m_children[0]->ref();
         break;
     }
     }
@@ -251,6 +357,8 @@ bytes MPTNode::encode() const  // NOLINT(misc-no-recursion)
 
 
 MPT::MPT() noexcept = default;
+MPT::MPT(MPT&&) noexcept = default;
+MPT& MPT::operator=(MPT&&) noexcept = default;
 MPT::~MPT() noexcept = default;
 
 void MPT::insert(bytes_view key, bytes&& value)
@@ -264,6 +372,14 @@ void MPT::insert(bytes_view key, bytes&& value)
         m_root->insert(path, std::move(value));
 }
 
+void MPT::erase(bytes_view key)
+{
+    assert(key.size() <= Path::capacity() / 2);  // must fit the path impl. length limit
+
+    if (m_root != nullptr && m_root->erase(Path{key}))
+        m_root.reset();
+}
+
 [[nodiscard]] hash256 MPT::hash() const
 {
     if (m_root == nullptr)
@@ -8,26 +8,33 @@
 
 namespace evmone::state
 {
-/// Insert-only Merkle Patricia Trie implementation for getting the root hash
+/// Merkle Patricia Trie implementation for getting the root hash
 /// out of (key, value) pairs.
 ///
+/// The trie is persistent: the values can be inserted, updated and erased.
+/// The node hashes are cached so the root hash computation after modifications
+/// rehashes only the nodes on the modified paths.
+///
 /// Limitations:
 /// 1. A key must not be longer than 32 bytes. Protected by debug assert.
 /// 2. A key must not be a prefix of another key. Protected by debug assert.
 ///    This comes from the spec (Yellow Paper Appendix D) - a branch node cannot store a value.
-/// 3. A key must be unique. Protected by debug assert.
-///    I.e. inserted values cannot be updated by inserting with the same key again.
-/// 4. Inserted values cannot be erased. There is no method for this.
 class MPT
 {
     std::unique_ptr<class MPTNode> m_root;
 
 public:
     MPT() noexcept;
+    MPT(MPT&&) noexcept;
+    MPT& operator=(MPT&&) noexcept;
     ~MPT() noexcept;
 
+    /// Inserts the value under the key. The value of an existing key is updated.
     void insert(bytes_view key, bytes&& value);
 
+    /// Erases the value under the key if exists.
+    void erase(bytes_view key);
+
     [[nodiscard]] hash256 hash() const;
 };
 
@@ -6,6 +6,7 @@
 #include "block.hpp"
 #include "mpt.hpp"
 #include "rlp.hpp"
+#include "state_diff.hpp"
 #include "test_state.hpp"
 #include "transaction.hpp"
 
@@ -15,27 +16,114 @@ namespace
 {
 hash256 mpt_hash(const std::map<bytes32, bytes32>& storage)
 {
-    MPT trie;
+    std::vector<const uint8_t*> keys;
+    std::vector<const bytes32*> values;
     for (const auto& [key, value] : storage)
     {
         if (!is_zero(value))  // Skip "deleted" values.
-            trie.insert(keccak256(key), rlp::encode(rlp::trim(value)));
+        {
+            keys.push_back(key.bytes);
+            values.push_back(&value);
+        }
     }
+
+    // Hash all the keys in a batch: this is faster than hashing them one by one.
+    const auto key_hashes = keccak256_batch(keys, sizeof(bytes32));
+
+    MPT trie;
+    for (size_t i = 0; i < values.size(); ++i)
+        trie.insert(key_hashes[i], rlp::encode(rlp::trim(*values[i])));
     return trie.hash();
 }
 }  // namespace
 
 hash256 mpt_hash(const test::TestState& state)
 {
+    std::vector<const uint8_t*> addrs;
+    addrs.reserve(state.size());
+    for (const auto& [addr, _] : state)
+        addrs.push_back(addr.bytes);
+    const auto addr_hashes = keccak256_batch(addrs, sizeof(address));
+
     MPT trie;
-    for (const auto& [addr, acc] : state)
+    size_t i = 0;
+    for (const auto& [_, acc] : state)
     {
-        trie.insert(keccak256(addr),
+        trie.insert(addr_hashes[i++],
             rlp::encode_tuple(acc.nonce, acc.balance, mpt_hash(acc.storage), keccak256(acc.code)));
     }
     return trie.hash();
 }
 
+StateTrie::StateTrie(const test::TestState& state)
+{
+    for (const auto& [addr, acc] : state)
+    {
+        auto& e = modify(addr);
+        e.nonce = acc.nonce;
+        e.balance = acc.balance;
+        e.code_hash = keccak256(acc.code);
+        for (const auto& [key, value] : acc.storage)
+        {
+            if (!is_zero(value))  // Skip "deleted" values.
+                e.storage.insert(keccak256(key), rlp::encode(rlp::trim(value)));
+        }
+    }
+}
+
+StateTrie::AccountEntry& StateTrie::modify(const address& addr)
+{
+    auto& e = m_accounts[addr];
+    if (!e.dirty)
+    {
+        e.dirty = true;
+        m_dirty_accounts.push_back(addr);
+    }
+    return e;
+}
+
+void StateTrie::apply(const StateDiff& diff)
+{
+    for (const auto& addr : diff.deleted_accounts)
+    {
+        m_accounts.erase(addr);
+        m_trie.erase(keccak256(addr));
+    }
+
+    for (const auto& m : diff.modified_accounts)
+    {
+        auto& e = modify(m.addr);
+        e.nonce = m.nonce;
+        e.balance = m.balance;
+        if (m.code.has_value())
+            e.code_hash = keccak256(*m.code);
+        for (const auto& [key, value] : m.modified_storage)
+        {
+            if (!is_zero(value))
+                e.storage.insert(keccak256(key), rlp::encode(rlp::trim(value)));
+            else
+                e.storage.erase(keccak256(key));
+        }
+    }
+}
+
+hash256 StateTrie::hash()
+{
+    for (const auto& addr : m_dirty_accounts)
+    {
+        const auto it = m_accounts.find(addr);
+        if (it == m_accounts.end())
+            continue;  // Deleted after modification.
+
+        auto& e = it->second;
+        m_trie.insert(keccak256(addr),
+            rlp::encode_tuple(e.nonce, e.balance, e.storage.hash(), e.code_hash));
+        e.dirty = false;
+    }
+    m_dirty_accounts.clear();
+    return m_trie.hash();
+}
+
 template <typename T>
 hash256 mpt_hash(std::span<const T> list)
 {
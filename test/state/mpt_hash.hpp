@@ -3,8 +3,13 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "account.hpp"
 #include "hash_utils.hpp"
+#include "mpt.hpp"
+#include <intx/intx.hpp>
 #include <span>
+#include <unordered_map>
+#include <vector>
 
 namespace evmone::test
 {
@@ -13,6 +18,8 @@ class TestState;
 
 namespace evmone::state
 {
+struct StateDiff;
+
 /// The hash of the empty Merkle Patricia Trie.
 ///
 /// Specifically, this is the value of keccak256(RLP("")), i.e. keccak256({0x80}).
@@ -26,6 +33,46 @@ hash256 mpt_hash(const test::TestState& state);
 template <typename T>
 hash256 mpt_hash(std::span<const T> list);
 
+/// The Merkle Patricia Tries of the state accounts and their storage
+/// for computing the state root hash incrementally.
+///
+/// The tries are built once from the state and later are kept in sync with the state
+/// by applying the same state changes. The hash() recomputes only the hashes
+/// of the trie nodes on the paths modified since the previous call,
+/// i.e. the cost is proportional to the number of changes, not the state size.
+class StateTrie
+{
+    struct AccountEntry
+    {
+        uint64_t nonce = 0;
+        intx::uint256 balance;
+        hash256 code_hash = Account::EMPTY_CODE_HASH;
+        MPT storage;
+
+        /// The account has been modified and must be re-inserted into the accounts trie.
+        bool dirty = false;
+    };
+
+    MPT m_trie;
+    std::unordered_map<address, AccountEntry> m_accounts;
+
+    /// The addresses of the modified accounts, i.e. the accounts marked as dirty.
+    std::vector<address> m_dirty_accounts;
+
+    /// Returns the account entry marked as modified.
+    AccountEntry& modify(const address& addr);
+
+public:
+    /// Builds the tries of the given state.
+    explicit StateTrie(const test::TestState& state);
+
+    /// Applies the state changes. The deleted accounts are removed first.
+    void apply(const StateDiff& diff);
+
+    /// Computes the state root hash.
+    [[nodiscard]] hash256 hash();
+};
+
 /// A helper to automatically convert collections (e.g. vector, array) to span.
 template <typename T>
 inline hash256 mpt_hash(const T& list)
@@ -0,0 +1,322 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "parallel_transition.hpp"
+#include "layered_state.hpp"
+#include "state.hpp"
+#include <algorithm>
+#include <atomic>
+#include <barrier>
+#include <cassert>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <thread>
+#include <unordered_map>
+
+namespace evmone::test
+{
+namespace
+{
+using TransactionResult = std::variant<state::TransactionReceipt, std::error_code>;
+
+/// The initial number of transactions executed speculatively in a round, per thread.
+constexpr size_t INITIAL_WINDOW_PER_THREAD = 4;
+
+/// The maximum number of transactions executed speculatively in a round, per thread.
+constexpr size_t MAX_WINDOW_PER_THREAD = 64;
+
+/// The values read from the state by a transaction execution.
+struct ReadSet
+{
+    std::unordered_map<address, std::optional<state::StateView::Account>> accounts;
+    std::unordered_map<address, std::unordered_map<bytes32, bytes32>> storage;
+};
+
+/// The StateView recording the values read from the underlying state.
+class RecordingStateView : public state::StateView
+{
+    const StateView& m_state;
+    ReadSet& m_reads;
+
+public:
+    RecordingStateView(const StateView& state, ReadSet& reads) noexcept
+      : m_state{state}, m_reads{reads}
+    {}
+
+    std::optional<Account> get_account(const address& addr) const override
+    {
+        auto acc = m_state.get_account(addr);
+        m_reads.accounts.try_emplace(addr, acc);
+        return acc;
+    }
+
+    state::Code get_account_code(const address& addr) const override
+    {
+        // The code is identified by the code hash, so recording the account is enough.
+        if (!m_reads.accounts.contains(addr))
+            m_reads.accounts.try_emplace(addr, m_state.get_account(addr));
+        return m_state.get_account_code(addr);
+    }
+
+    bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override
+    {
+        const auto value = m_state.get_storage(addr, key);
+        m_reads.storage[addr].try_emplace(key, value);
+        return value;
+    }
+};
+
+/// The result of the speculative execution of a transaction.
+struct Speculation
+{
+    ReadSet reads;
+
+    /// The transaction receipt. Null if the transaction has not been executed
+    /// or has been invalid in the speculative state.
+    std::optional<state::TransactionReceipt> receipt;
+};
+
+/// Executes the transaction speculatively, recording the values read from the state.
+void speculate(Speculation& spec, const state::StateView& state, const state::BlockInfo& block,
+    const state::BlockHashes& block_hashes, const state::Transaction& tx, evmc_revision rev,
+    evmc::VM& vm)
+{
+    spec = {};
+    const RecordingStateView view{state, spec.reads};
+
+    // The block gas limits depend on the preceding transactions. They are checked on commit.
+    const auto tx_props_or_error = state::validate_transaction(
+        view, block, tx, rev, tx.gas_limit, std::numeric_limits<int64_t>::max());
+    if (const auto* tx_props = std::get_if<state::TransactionProperties>(&tx_props_or_error))
+        spec.receipt = state::transition(view, block, block_hashes, tx, rev, vm, *tx_props);
+}
+
+bool same_account(
+    const state::StateView::Account& a, const state::StateView::Account& b) noexcept
+{
+    return a.nonce == b.nonce && a.balance == b.balance && a.code_hash == b.code_hash &&
+           a.has_storage == b.has_storage;
+}
+
+/// Checks if the result of the speculative execution is valid in the current state.
+/// @return  The increase of the coinbase balance since the speculative execution
+///          or std::nullopt if the result is invalid.
+std::optional<uint256> validate(
+    const Speculation& spec, const state::StateView& state, const address& coinbase)
+{
+    assert(spec.receipt.has_value());
+    uint256 coinbase_balance_diff = 0;
+    for (const auto& [addr, acc] : spec.reads.accounts)
+    {
+        const auto current = state.get_account(addr);
+        if (acc.has_value() != current.has_value())
+            return std::nullopt;
+        if (!acc.has_value() || same_account(*acc, *current))
+            continue;
+
+        // The coinbase balance may have been increased by the preceding transactions.
+        // This doesn't affect the transaction unless it depends on the coinbase balance
+        // or on the coinbase being empty.
+        auto rebased_acc = *acc;
+        rebased_acc.balance = current->balance;
+        if (addr == coinbase && !spec.receipt->coinbase_balance_read && acc->balance != 0 &&
+            current->balance != 0 && same_account(rebased_acc, *current))
+        {
+            coinbase_balance_diff = current->balance - acc->balance;
+            continue;
+        }
+        return std::nullopt;
+    }
+
+    for (const auto& [addr, slots] : spec.reads.storage)
+    {
+        for (const auto& [key, value] : slots)
+        {
+            if (state.get_storage(addr, key) != value)
+                return std::nullopt;
+        }
+    }
+    return coinbase_balance_diff;
+}
+
+/// The worker threads executing the speculative rounds together with the calling thread.
+///
+/// The threads are started once and wait on the barrier between the rounds.
+class Workers
+{
+    std::barrier<> m_barrier;
+
+    /// The task of the current round. Null stops the workers.
+    const std::function<void(evmc::VM&)>* m_task = nullptr;
+
+    std::vector<std::jthread> m_threads;
+
+    void work(evmc::VM& vm)
+    {
+        while (true)
+        {
+            m_barrier.arrive_and_wait();  // Wait for the round start.
+            if (m_task == nullptr)
+                return;
+            (*m_task)(vm);
+            m_barrier.arrive_and_wait();  // Report the round end.
+        }
+    }
+
+public:
+    /// Starts a worker for each VM except the first one, which is used by the calling thread.
+    explicit Workers(std::span<evmc::VM> vms) : m_barrier{static_cast<std::ptrdiff_t>(vms.size())}
+    {
+        m_threads.reserve(vms.size() - 1);
+        for (size_t k = 1; k < vms.size(); ++k)
+            m_threads.emplace_back([this, &vm = vms[k]] { work(vm); });
+    }
+
+    Workers(const Workers&) = delete;
+    Workers& operator=(const Workers&) = delete;
+
+    ~Workers()
+    {
+        m_task = nullptr;
+        m_barrier.arrive_and_wait();  // Release the workers to stop.
+    }
+
+    /// Runs the task on all the threads, the calling thread uses the given VM.
+    /// Returns when the task has been finished by all the threads.
+    void run(const std::function<void(evmc::VM&)>& task, evmc::VM& vm)
+    {
+        m_task = &task;
+        m_barrier.arrive_and_wait();
+        task(vm);
+        m_barrier.arrive_and_wait();
+    }
+};
+
+template <typename StateT>
+std::vector<TransactionResult> transition_sequential(StateT& state, const state::BlockInfo& block,
+    const state::BlockHashes& block_hashes, std::span<const state::Transaction> txs,
+    evmc_revision rev, evmc::VM& vm, int64_t block_gas_left, int64_t blob_gas_left)
+{
+    std::vector<TransactionResult> results;
+    results.reserve(txs.size());
+    for (const auto& tx : txs)
+    {
+        auto res =
+            transition(state, block, block_hashes, tx, rev, vm, block_gas_left, blob_gas_left);
+        if (const auto* receipt = std::get_if<state::TransactionReceipt>(&res))
+        {
+            block_gas_left -= receipt->gas_used;
+            blob_gas_left -= static_cast<int64_t>(tx.blob_gas_used());
+        }
+        results.emplace_back(std::move(res));
+    }
+    return results;
+}
+}  // namespace
+
+template <typename StateT>
+std::vector<TransactionResult> transition_parallel(StateT& state, const state::BlockInfo& block,
+    const state::BlockHashes& block_hashes, std::span<const state::Transaction> txs,
+    evmc_revision rev, std::span<evmc::VM> vms, int64_t block_gas_left, int64_t blob_gas_left)
+{
+    assert(!vms.empty());
+    const auto num_threads = vms.size();
+    if (num_threads == 1 || txs.size() <= 1)
+    {
+        return transition_sequential(
+            state, block, block_hashes, txs, rev, vms[0], block_gas_left, blob_gas_left);
+    }
+
+    std::vector<TransactionResult> results;
+    results.reserve(txs.size());
+    std::vector<Speculation> specs(txs.size());
+    std::vector<size_t> round;
+
+    // The speculative executions of a round are shared between the threads.
+    std::atomic<size_t> next_task = 0;
+    const std::function<void(evmc::VM&)> run_tasks = [&](evmc::VM& vm) {
+        for (auto t = next_task++; t < round.size(); t = next_task++)
+            speculate(specs[round[t]], state, block, block_hashes, txs[round[t]], rev, vm);
+    };
+    Workers workers{vms};
+
+    // The transactions are processed in rounds. In a round the transactions in the window
+    // are executed speculatively in parallel and then the valid results are committed.
+    // The window shrinks when the transactions conflict and grows otherwise.
+    auto window = INITIAL_WINDOW_PER_THREAD * num_threads;
+    size_t next = 0;
+    while (next != txs.size())
+    {
+        // Skip the transactions which speculative results are still valid.
+        const auto end = std::min(txs.size(), next + window);
+        round.clear();
+        for (auto i = next; i != end; ++i)
+        {
+            if (!specs[i].receipt.has_value() ||
+                !validate(specs[i], state, block.coinbase).has_value())
+                round.push_back(i);
+        }
+
+        next_task = 0;
+        workers.run(run_tasks, vms[0]);
+
+        // Commit the results in the transaction order. The first invalid result is replaced
+        // by the sequential execution, the next one ends the round.
+        bool reexecuted = false;
+        for (; next != end; ++next)
+        {
+            const auto& tx = txs[next];
+            const auto tx_props_or_error = state::validate_transaction(
+                state, block, tx, rev, block_gas_left, blob_gas_left);
+            if (const auto* err = std::get_if<std::error_code>(&tx_props_or_error))
+            {
+                results.emplace_back(*err);
+                continue;
+            }
+
+            auto& spec = specs[next];
+            auto coinbase_balance_diff = spec.receipt.has_value() ?
+                                             validate(spec, state, block.coinbase) :
+                                             std::nullopt;
+            if (!coinbase_balance_diff.has_value())
+            {
+                if (reexecuted)
+                    break;
+                spec.receipt = state::transition(state, block, block_hashes, tx, rev, vms[0],
+                    std::get<state::TransactionProperties>(tx_props_or_error));
+                coinbase_balance_diff = 0;
+                reexecuted = true;
+            }
+
+            auto& receipt = *spec.receipt;
+            if (*coinbase_balance_diff != 0)
+            {
+                for (auto& m : receipt.state_diff.modified_accounts)
+                {
+                    if (m.addr == block.coinbase)
+                        m.balance += *coinbase_balance_diff;
+                }
+            }
+
+            state.apply(receipt.state_diff);
+            block_gas_left -= receipt.gas_used;
+            blob_gas_left -= static_cast<int64_t>(tx.blob_gas_used());
+            results.emplace_back(std::move(receipt));
+            spec = {};
+        }
+
+        window = next == end ? std::min(window * 2, MAX_WINDOW_PER_THREAD * num_threads) :
+                               std::max(window / 2, num_threads);
+    }
+    return results;
+}
+
+template std::vector<TransactionResult> transition_parallel(TestState&, const state::BlockInfo&,
+    const state::BlockHashes&, std::span<const state::Transaction>, evmc_revision,
+    std::span<evmc::VM>, int64_t, int64_t);
+template std::vector<TransactionResult> transition_parallel(LayeredState&,
+    const state::BlockInfo&, const state::BlockHashes&, std::span<const state::Transaction>,
+    evmc_revision, std::span<evmc::VM>, int64_t, int64_t);
+}  // namespace evmone::test
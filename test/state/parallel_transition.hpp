@@ -0,0 +1,34 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+#pragma once
+
+#include "test_state.hpp"
+#include <span>
+#include <system_error>
+#include <variant>
+#include <vector>
+
+namespace evmone::test
+{
+/// Executes the block transactions in parallel and applies the state changes to the state.
+///
+/// The transactions are executed optimistically (in the Block-STM style): the worker threads
+/// execute them speculatively, each thread with its own VM, and record the values read
+/// from the state. Then the results are committed in the transaction order. A result is valid
+/// if all the values it has read are unchanged in the state updated by the preceding transactions.
+/// Invalid results are discarded and the transactions are executed again.
+/// The coinbase priority fee payments don't conflict with each other unless the transaction
+/// depends on the coinbase balance (see TransactionReceipt::coinbase_balance_read).
+///
+/// The results are the same as of the sequential execution of the transactions
+/// with test::transition().
+///
+/// @param vms  The VMs for the execution threads, the calling thread uses the first one.
+///             The number of VMs is the number of threads.
+template <typename StateT>
+[[nodiscard]] std::vector<std::variant<state::TransactionReceipt, std::error_code>>
+transition_parallel(StateT& state, const state::BlockInfo& block,
+    const state::BlockHashes& block_hashes, std::span<const state::Transaction> txs,
+    evmc_revision rev, std::span<evmc::VM> vms, int64_t block_gas_left, int64_t blob_gas_left);
+}  // namespace evmone::test
@@ -135,7 +135,7 @@ int64_t process_authorization_list(
 
         // 5. Verify the code of authority is either empty or already delegated.
         if (authority.code_hash != Account::EMPTY_CODE_HASH &&
-            !is_code_delegated(state.get_code(*auth.signer)))
+            !state.get_code(*auth.signer).delegate().has_value())
             continue;
 
         // 6. Verify the nonce of authority is equal to nonce.
@@ -163,7 +163,7 @@ int64_t process_authorization_list(
             if (authority.code_hash != Account::EMPTY_CODE_HASH)
             {
                 authority.code_changed = true;
-                authority.code.clear();
+                authority.code = {};
                 authority.code_hash = Account::EMPTY_CODE_HASH;
             }
         }
@@ -175,8 +175,8 @@ int64_t process_authorization_list(
             {
                 // We are doing this only if the code is different to make the state diff precise.
                 authority.code_changed = true;
-                authority.code = std::move(new_code);
-                authority.code_hash = keccak256(authority.code);
+                authority.code = Code{new_code};
+                authority.code_hash = authority.code.hash();
             }
         }
 
@@ -211,8 +211,9 @@ evmc_message build_message(const Transaction& tx, int64_t execution_gas_limit) n
 StateDiff State::build_diff(evmc_revision rev) const
 {
     StateDiff diff;
-    for (const auto& [addr, m] : m_modified)
+    for (const auto& [addr, acc] : m_modified)
     {
+        const auto& m = *acc;
         if (m.destructed)
         {
             // TODO: This must be done even for just_created
@@ -237,7 +238,7 @@ StateDiff State::build_diff(evmc_revision rev) const
         // Output only the new code.
         // TODO: Output also the code hash. It will be needed for DB update and MPT hash.
         if (m.code_changed)
-            a.code = m.code;
+            a.code = bytes{m.code.view()};
 
         for (const auto& [k, v] : m.storage)
         {
@@ -250,9 +251,9 @@ StateDiff State::build_diff(evmc_revision rev) const
 
 Account& State::insert(const address& addr, Account account)
 {
-    const auto r = m_modified.insert({addr, std::move(account)});
+    const auto r = m_modified.try_emplace(addr, std::make_unique<Account>(std::move(account)));
     assert(r.second);
-    return r.first->second;
+    return *r.first->second;
 }
 
 Account* State::find(const address& addr) noexcept
@@ -260,7 +261,7 @@ Account* State::find(const address& addr) noexcept
     // TODO: Avoid double lookup (find+insert) and not cached initial state lookup for non-existent
     //   accounts. If we want to cache non-existent account we need a proper flag for it.
     if (const auto it = m_modified.find(addr); it != m_modified.end())
-        return &it->second;
+        return it->second.get();
     if (const auto cacc = m_initial.get_account(addr); cacc)
         return &insert(addr, {.nonce = cacc->nonce,
                                  .balance = cacc->balance,
@@ -283,15 +284,22 @@ Account& State::get_or_insert(const address& addr, Account account)
     return insert(addr, std::move(account));
 }
 
-bytes_view State::get_code(const address& addr)
+const Code& State::get_code(const address& addr)
 {
+    static const Code empty_code;
     auto* a = find(addr);
     if (a == nullptr)
-        return {};
+        return empty_code;
     if (a->code_hash == Account::EMPTY_CODE_HASH)
-        return {};
+        return empty_code;
     if (a->code.empty())
-        a->code = m_initial.get_account_code(addr);
+    {
+        // Share the code if it is already held, otherwise load it from the initial state.
+        if (auto code = Code::find(a->code_hash); code.has_value())
+            a->code = std::move(*code);
+        else
+            a->code = m_initial.get_account_code(addr);
+    }
     return a->code;
 }
 
@@ -301,7 +309,7 @@ Account& State::touch(const address& addr)
     if (!acc.erase_if_empty && acc.is_empty())
     {
         acc.erase_if_empty = true;
-        m_journal.emplace_back(JournalTouched{addr});
+        m_journal.push(JournalTouched{addr});
     }
     return acc;
 }
@@ -321,107 +329,101 @@ StorageValue& State::get_storage(const address& addr, const bytes32& key)
 
 void State::journal_balance_change(const address& addr, const intx::uint256& prev_balance)
 {
-    m_journal.emplace_back(JournalBalanceChange{{addr}, prev_balance});
+    m_journal.push(JournalBalanceChange{{addr}, prev_balance});
 }
 
 void State::journal_storage_change(
     const address& addr, const bytes32& key, const StorageValue& value)
 {
-    m_journal.emplace_back(JournalStorageChange{{addr}, key, value.current, value.access_status});
+    m_journal.push(JournalStorageChange{{addr}, key, value.current, value.access_status});
 }
 
 void State::journal_transient_storage_change(
     const address& addr, const bytes32& key, const bytes32& value)
 {
-    m_journal.emplace_back(JournalTransientStorageChange{{addr}, key, value});
+    m_journal.push(JournalTransientStorageChange{{addr}, key, value});
 }
 
 void State::journal_bump_nonce(const address& addr)
 {
-    m_journal.emplace_back(JournalNonceBump{addr});
+    m_journal.push(JournalNonceBump{addr});
 }
 
 void State::journal_create(const address& addr, bool existed)
 {
-    m_journal.emplace_back(JournalCreate{{addr}, existed});
+    m_journal.push(JournalCreate{{addr}, existed});
 }
 
 void State::journal_destruct(const address& addr)
 {
-    m_journal.emplace_back(JournalDestruct{addr});
+    m_journal.push(JournalDestruct{addr});
 }
 
 void State::journal_access_account(const address& addr)
 {
-    m_journal.emplace_back(JournalAccessAccount{addr});
+    m_journal.push(JournalAccessAccount{addr});
 }
 
 void State::rollback(size_t checkpoint)
 {
-    while (m_journal.size() != checkpoint)
-    {
-        std::visit(
-            [this](const auto& e) {
-                using T = std::decay_t<decltype(e)>;
-                if constexpr (std::is_same_v<T, JournalNonceBump>)
-                {
-                    get(e.addr).nonce -= 1;
-                }
-                else if constexpr (std::is_same_v<T, JournalTouched>)
-                {
-                    get(e.addr).erase_if_empty = false;
-                }
-                else if constexpr (std::is_same_v<T, JournalDestruct>)
-                {
-                    get(e.addr).destructed = false;
-                }
-                else if constexpr (std::is_same_v<T, JournalAccessAccount>)
-                {
-                    get(e.addr).access_status = EVMC_ACCESS_COLD;
-                }
-                else if constexpr (std::is_same_v<T, JournalCreate>)
-                {
-                    if (e.existed)
-                    {
-                        // This account is not always "touched". TODO: Why?
-                        auto& a = get(e.addr);
-                        a.nonce = 0;
-                        a.code_hash = Account::EMPTY_CODE_HASH;
-                        a.code.clear();
-                    }
-                    else
-                    {
-                        // TODO: Before Spurious Dragon we don't clear empty accounts ("erasable")
-                        //       so we need to delete them here explicitly.
-                        //       This should be changed by tuning "erasable" flag
-                        //       and clear in all revisions.
-                        m_modified.erase(e.addr);
-                    }
-                }
-                else if constexpr (std::is_same_v<T, JournalStorageChange>)
-                {
-                    auto& s = get(e.addr).storage.find(e.key)->second;
-                    s.current = e.prev_value;
-                    s.access_status = e.prev_access_status;
-                }
-                else if constexpr (std::is_same_v<T, JournalTransientStorageChange>)
-                {
-                    auto& s = get(e.addr).transient_storage.find(e.key)->second;
-                    s = e.prev_value;
-                }
-                else if constexpr (std::is_same_v<T, JournalBalanceChange>)
-                {
-                    get(e.addr).balance = e.prev_balance;
-                }
-                else
-                {
-                    // TODO(C++23): Change condition to `false` once CWG2518 is in.
-                    static_assert(std::is_void_v<T>, "unhandled journal entry type");
-                }
-            },
-            m_journal.back());
-        m_journal.pop_back();
-    }
+    m_journal.rollback(checkpoint, [this](const auto& e) {
+        using T = std::decay_t<decltype(e)>;
+        if constexpr (std::is_same_v<T, JournalNonceBump>)
+        {
+            get(e.addr).nonce -= 1;
+        }
+        else if constexpr (std::is_same_v<T, JournalTouched>)
+        {
+            get(e.addr).erase_if_empty = false;
+        }
+        else if constexpr (std::is_same_v<T, JournalDestruct>)
+        {
+            get(e.addr).destructed = false;
+        }
+        else if constexpr (std::is_same_v<T, JournalAccessAccount>)
+        {
+            get(e.addr).access_status = EVMC_ACCESS_COLD;
+        }
+        else if constexpr (std::is_same_v<T, JournalCreate>)
+        {
+            if (e.existed)
+            {
+                // This account is not always "touched". TODO: Why?
+                auto& a = get(e.addr);
+                a.nonce = 0;
+                a.code_hash = Account::EMPTY_CODE_HASH;
+                a.code = {};
+            }
+            else
+            {
+                // TODO: Before Spurious Dragon we don't clear empty accounts ("erasable")
+                //       so we need to delete them here explicitly.
+                //       This should be changed by tuning "erasable" flag
+                //       and clear in all revisions.
+                m_modified.erase(e.addr);
+            }
+        }
+        else if constexpr (std::is_same_v<T, JournalStorageChange>)
+        {
+            auto& s = get(e.addr).storage.find(e.key)->second;
+            s.current = e.prev_value;
+            s.access_status = e.prev_access_status;
+        }
+        else if constexpr (std::is_same_v<T, JournalTransientStorageChange>)
+        {
+            auto& s = get(e.addr).transient_storage.find(e.key)->second;
+            s = e.prev_value;
+        }
+        else if constexpr (std::is_same_v<T, JournalBalanceChange>)
+        {
+            get(e.addr).balance = e.prev_balance;
+        }
+        else
+        {
+            // TODO(C++23): Change condition to `false` once CWG2518 is in.
+            static_assert(std::is_void_v<T>, "unhandled journal entry type");
+        }
+    });
 }
 
 /// Validates transaction and computes its execution gas limit (the amount of gas provided to EVM).
@@ -511,7 +513,7 @@ std::variant<TransactionProperties, std::error_code> validate_transaction(
         StateView::Account{.code_hash = Account::EMPTY_CODE_HASH});
 
     if (sender_acc.code_hash != Account::EMPTY_CODE_HASH &&
-        !is_code_delegated(state_view.get_account_code(tx.sender)))
+        !state_view.get_account_code(tx.sender).delegate().has_value())
         return make_error_code(SENDER_NOT_EOA);  // Origin must not be a contract (EIP-3607).
 
     if (sender_acc.nonce == Account::NonceMax)  // Nonce value limit (EIP-2681).
@@ -633,7 +635,7 @@ TransactionReceipt transition(const StateView& state_view, const BlockInfo& bloc
     auto message = build_message(tx, tx_props.execution_gas_limit);
     if (tx.to.has_value())
     {
-        if (const auto delegate = get_delegate_address(host, *tx.to))
+        if (const auto delegate = state.get_code(*tx.to).delegate())
         {
             message.code_address = *delegate;
             message.flags |= EVMC_DELEGATED;
@@ -663,6 +665,7 @@ TransactionReceipt transition(const StateView& state_view, const BlockInfo& bloc
 
     // Cannot put it into constructor call because logs are std::moved from host instance.
     receipt.logs_bloom_filter = compute_bloom_filter(receipt.logs);
+    receipt.coinbase_balance_read = tx.sender == block.coinbase || host.coinbase_balance_read();
 
     return receipt;
 }
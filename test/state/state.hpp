@@ -9,9 +9,11 @@
 #include "bloom_filter.hpp"
 #include "errors.hpp"
 #include "hash_utils.hpp"
+#include "journal.hpp"
 #include "state_diff.hpp"
 #include "state_view.hpp"
 #include "transaction.hpp"
+#include <memory>
 #include <variant>
 
 namespace evmone::state
@@ -59,19 +61,22 @@ class State
     struct JournalAccessAccount : JournalBase
     {};
 
-    using JournalEntry =
-        std::variant<JournalBalanceChange, JournalTouched, JournalStorageChange, JournalNonceBump,
+    using JournalLog =
+        Journal<JournalBalanceChange, JournalTouched, JournalStorageChange, JournalNonceBump,
             JournalCreate, JournalTransientStorageChange, JournalDestruct, JournalAccessAccount>;
 
     /// The read-only view of the initial (cold) state.
     const StateView& m_initial;
 
     /// The accounts loaded from the initial state and potentially modified.
-    std::unordered_map<address, Account> m_modified;
+    ///
+    /// The accounts are allocated individually because the references to them
+    /// are kept across insertions of other accounts, and the flat map moves its entries.
+    FlatHashMap<address, std::unique_ptr<Account>> m_modified;
 
     /// The state journal: the list of changes made to the state
     /// with information how to revert them.
-    std::vector<JournalEntry> m_journal;
+    JournalLog m_journal;
 
 public:
     explicit State(const StateView& state_view) noexcept : m_initial{state_view} {}
@@ -92,7 +97,9 @@ public:
     /// Gets an existing account or inserts new account.
     Account& get_or_insert(const address& addr, Account account = {});
 
-    bytes_view get_code(const address& addr);
+    /// Returns the code of the account at the address, loads it if needed.
+    /// The empty code is returned if the account doesn't exist.
+    const Code& get_code(const address& addr);
 
     StorageValue& get_storage(const address& addr, const bytes32& key);
 
@@ -100,7 +107,7 @@ public:
 
     /// Returns the state journal checkpoint. It can be later used to in rollback()
     /// to revert changes newer than the checkpoint.
-    [[nodiscard]] size_t checkpoint() const noexcept { return m_journal.size(); }
+    [[nodiscard]] size_t checkpoint() const noexcept { return m_journal.checkpoint(); }
 
     /// Reverts state changes made after the checkpoint.
     void rollback(size_t checkpoint);
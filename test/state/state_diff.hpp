@@ -43,9 +43,10 @@ struct StateDiff
 
     /// List of deleted accounts.
     ///
-    /// This list doesn't have common addresses with modified_accounts.
-    /// Note that from the Cancun revision (because of the modification to the SELFDESTRUCT)
-    /// accounts cannot be deleted and this list is always empty.
+    /// The deletions are applied before the modifications, so an address in both lists
+    /// means the account has been deleted and re-created. The diffs of single transactions
+    /// don't have such addresses. Note that from the Cancun revision (because of
+    /// the modification to the SELFDESTRUCT) accounts cannot be deleted by transactions.
     std::vector<address> deleted_accounts;
 };
 }  // namespace evmone::state
@@ -3,6 +3,7 @@
 // SPDX-License-Identifier: Apache-2.0
 #pragma once
 
+#include "code.hpp"
 #include <evmc/evmc.hpp>
 #include <intx/intx.hpp>
 #include <optional>
@@ -26,8 +27,13 @@ public:
     };
 
     virtual ~StateView() = default;
-    virtual std::optional<Account> get_account(const address& addr) const noexcept = 0;
-    virtual bytes get_account_code(const address& addr) const noexcept = 0;
+
+    /// Loads the account. May intern the account's code, so may throw std::bad_alloc.
+    virtual std::optional<Account> get_account(const address& addr) const = 0;
+
+    /// Loads the account's code. May intern the code, so may throw std::bad_alloc.
+    virtual Code get_account_code(const address& addr) const = 0;
+
     virtual bytes32 get_storage(const address& addr, const bytes32& key) const noexcept = 0;
 };
 
@@ -2,33 +2,59 @@
 // Copyright 2024 The evmone Authors.
 // SPDX-License-Identifier: Apache-2.0
 #include "test_state.hpp"
+#include "layered_state.hpp"
 #include "state.hpp"
 #include "system_contracts.hpp"
 
 namespace evmone::test
 {
-std::optional<state::StateView::Account> TestState::get_account(const address& addr) const noexcept
+std::optional<state::StateView::Account> TestState::get_account(const address& addr) const
 {
     const auto it = find(addr);
     if (it == end())
         return std::nullopt;
 
     const auto& acc = it->second;
-    // TODO: Cache code hash for MTP root hash calculation?
-    return Account{acc.nonce, acc.balance, keccak256(acc.code), !acc.storage.empty()};
+    return Account{acc.nonce, acc.balance, get_code(addr, acc.code).hash(), !acc.storage.empty()};
 }
 
-bytes TestState::get_account_code(const address& addr) const noexcept
+state::Code TestState::get_account_code(const address& addr) const
 {
     const auto it = find(addr);
     if (it == end())
         return {};
 
-    return it->second.code;
+    return get_code(addr, it->second.code);
+}
+
+state::Code TestState::get_code(const address& addr, const bytes& code) const
+{
+    if (code.empty())
+        return {};
+    if (m_code_cache == nullptr)
+        return state::Code{code};
+
+    auto& cache = *m_code_cache;
+    state::Code cached;
+    {
+        const std::lock_guard lock{cache.mutex};
+        if (const auto it = cache.codes.find(addr); it != cache.codes.end())
+            cached = it->second;
+    }
+    if (cached == code)  // Compare outside the lock: the codes are immutable.
+        return cached;
+
+    state::Code new_code{code};
+    const std::lock_guard lock{cache.mutex};
+    cache.codes.insert_or_assign(addr, new_code);
+    return new_code;
 }
 
 void TestState::apply(const state::StateDiff& diff)
 {
+    for (const auto& addr : diff.deleted_accounts)
+        erase(addr);
+
     for (const auto& m : diff.modified_accounts)
     {
         auto& a = (*this)[m.addr];
@@ -44,9 +70,6 @@ void TestState::apply(const state::StateDiff& diff)
                 a.storage.erase(k);
         }
     }
-
-    for (const auto& addr : diff.deleted_accounts)
-        erase(addr);
 }
 
 bytes32 TestState::get_storage(const address& addr, const bytes32& key) const noexcept
@@ -70,7 +93,8 @@ bytes32 TestBlockHashes::get_block_hash(int64_t block_number) const noexcept
     return keccak256({reinterpret_cast<const uint8_t*>(s.data()), s.size()});
 }
 
-[[nodiscard]] std::variant<state::TransactionReceipt, std::error_code> transition(TestState& state,
+template <typename StateT>
+[[nodiscard]] std::variant<state::TransactionReceipt, std::error_code> transition(StateT& state,
     const state::BlockInfo& block, const state::BlockHashes& block_hashes,
     const state::Transaction& tx, evmc_revision rev, evmc::VM& vm, int64_t block_gas_left,
     int64_t blob_gas_left)
@@ -86,7 +110,8 @@ bytes32 TestBlockHashes::get_block_hash(int64_t block_number) const noexcept
     return receipt;
 }
 
-void finalize(TestState& state, evmc_revision rev, const address& coinbase,
+template <typename StateT>
+void finalize(StateT& state, evmc_revision rev, const address& coinbase,
     std::optional<uint64_t> block_reward, std::span<const state::Ommer> ommers,
     std::span<const state::Withdrawal> withdrawals)
 {
@@ -94,14 +119,16 @@ void finalize(TestState& state, evmc_revision rev, const address& coinbase,
     state.apply(diff);
 }
 
-void system_call_block_start(TestState& state, const state::BlockInfo& block,
+template <typename StateT>
+void system_call_block_start(StateT& state, const state::BlockInfo& block,
     const state::BlockHashes& block_hashes, evmc_revision rev, evmc::VM& vm)
 {
     const auto diff = state::system_call_block_start(state, block, block_hashes, rev, vm);
     state.apply(diff);
 }
 
-std::optional<std::vector<state::Requests>> system_call_block_end(TestState& state,
+template <typename StateT>
+std::optional<std::vector<state::Requests>> system_call_block_end(StateT& state,
     const state::BlockInfo& block, const state::BlockHashes& block_hashes, evmc_revision rev,
     evmc::VM& vm)
 {
@@ -111,4 +138,19 @@ std::optional<std::vector<state::Requests>> system_call_block_end(TestState& sta
     state.apply(result->state_diff);
     return std::move(result->requests);
 }
+
+#define INSTANTIATE_STATE_WRAPPERS(StateT)                                                         \
+    template std::variant<state::TransactionReceipt, std::error_code> transition(StateT&,          \
+        const state::BlockInfo&, const state::BlockHashes&, const state::Transaction&,             \
+        evmc_revision, evmc::VM&, int64_t, int64_t);                                               \
+    template void finalize(StateT&, evmc_revision, const address&, std::optional<uint64_t>,        \
+        std::span<const state::Ommer>, std::span<const state::Withdrawal>);                        \
+    template void system_call_block_start(                                                         \
+        StateT&, const state::BlockInfo&, const state::BlockHashes&, evmc_revision, evmc::VM&);    \
+    template std::optional<std::vector<state::Requests>> system_call_block_end(StateT&,            \
+        const state::BlockInfo&, const state::BlockHashes&, evmc_revision, evmc::VM&);
+
+INSTANTIATE_STATE_WRAPPERS(TestState)
+INSTANTIATE_STATE_WRAPPERS(LayeredState)
+#undef INSTANTIATE_STATE_WRAPPERS
 }  // namespace evmone::test
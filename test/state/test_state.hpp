@@ -7,7 +7,10 @@
 #include <evmc/evmc.hpp>
 #include <intx/intx.hpp>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <span>
+#include <unordered_map>
 #include <variant>
 
 namespace evmone
@@ -48,11 +51,29 @@ struct TestAccount
 /// and is also easier to work with in tests.
 class TestState : public state::StateView, public std::map<address, TestAccount>
 {
+    /// The cache of the account codes interned as state::Code, keyed by the account address.
+    ///
+    /// The cached code is used only if it is equal to the account's code, so the accounts
+    /// can be modified directly and the copies of the state can share the cache.
+    /// The cache keeps the codes interned across transactions and saves hashing the code
+    /// on every account load.
+    struct CodeCache
+    {
+        std::mutex mutex;
+        std::unordered_map<address, state::Code> codes;
+    };
+
+    /// The code cache shared by the copies of the state. Null in a moved-from state.
+    std::shared_ptr<CodeCache> m_code_cache = std::make_shared<CodeCache>();
+
+    /// Returns the account's code from the cache, interns the code if not cached.
+    state::Code get_code(const address& addr, const bytes& code) const;
+
 public:
     using map::map;
 
-    std::optional<Account> get_account(const address& addr) const noexcept override;
-    bytes get_account_code(const address& addr) const noexcept override;
+    std::optional<Account> get_account(const address& addr) const override;
+    state::Code get_account_code(const address& addr) const override;
     bytes32 get_storage(const address& addr, const bytes32& key) const noexcept override;
 
     /// Inserts new account to the state.
@@ -81,23 +102,27 @@ public:
     bytes32 get_block_hash(int64_t block_number) const noexcept override;
 };
 
-/// Wrapping of state::transition() which operates on TestState.
-[[nodiscard]] std::variant<state::TransactionReceipt, std::error_code> transition(TestState& state,
+/// Wrapping of state::transition() which operates on TestState or LayeredState.
+template <typename StateT>
+[[nodiscard]] std::variant<state::TransactionReceipt, std::error_code> transition(StateT& state,
     const state::BlockInfo& block, const state::BlockHashes& block_hashes,
     const state::Transaction& tx, evmc_revision rev, evmc::VM& vm, int64_t block_gas_left,
     int64_t blob_gas_left);
 
-/// Wrapping of state::finalize() which operates on TestState.
-void finalize(TestState& state, evmc_revision rev, const address& coinbase,
+/// Wrapping of state::finalize() which operates on TestState or LayeredState.
+template <typename StateT>
+void finalize(StateT& state, evmc_revision rev, const address& coinbase,
     std::optional<uint64_t> block_reward, std::span<const state::Ommer> ommers,
     std::span<const state::Withdrawal> withdrawals);
 
-/// Wrapping of state::system_call_block_start() which operates on TestState.
-void system_call_block_start(TestState& state, const state::BlockInfo& block,
+/// Wrapping of state::system_call_block_start() which operates on TestState or LayeredState.
+template <typename StateT>
+void system_call_block_start(StateT& state, const state::BlockInfo& block,
     const state::BlockHashes& block_hashes, evmc_revision rev, evmc::VM& vm);
 
-/// Wrapping of state::system_call_block_end() which operates on TestState.
-std::optional<std::vector<state::Requests>> system_call_block_end(TestState& state,
+/// Wrapping of state::system_call_block_end() which operates on TestState or LayeredState.
+template <typename StateT>
+std::optional<std::vector<state::Requests>> system_call_block_end(StateT& state,
     const state::BlockInfo& block, const state::BlockHashes& block_hashes, evmc_revision rev,
     evmc::VM& vm);
 }  // namespace test
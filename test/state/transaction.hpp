@@ -129,6 +129,12 @@ struct TransactionReceipt
 
     /// Root hash of the state after this transaction. Used only in old pre-Byzantium transactions.
     std::optional<bytes32> post_state;
+
+    /// Whether the transaction execution depends on the balance of the block coinbase account
+    /// (the coinbase is the sender or the EVM has read its balance). Otherwise, the transaction
+    /// only increases the coinbase balance (e.g. by the priority fee) and the result is valid for
+    /// any non-zero initial coinbase balance. Used by the parallel block execution.
+    bool coinbase_balance_read = false;
 };
 
 /// Defines how to RLP-encode a Transaction.
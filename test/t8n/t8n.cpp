@@ -147,6 +147,12 @@ int main(int argc, const char* argv[])
                 if (!pre_state_only)
                     test::system_call_block_start(state, block, block_hashes, rev, vm);
 
+                // Before Byzantium receipts contain the state root after each transaction:
+                // keep the state trie to compute the state roots incrementally.
+                std::optional<state::StateTrie> state_trie;
+                if (rev < EVMC_BYZANTIUM)
+                    state_trie.emplace(state);
+
                 for (size_t i = 0; i < j_txs.size(); ++i)
                 {
                     auto tx = test::from_json<state::Transaction>(j_txs[i]);
@@ -205,8 +211,11 @@ int main(int argc, const char* argv[])
                         j_receipt["gasUsed"] = hex0x(static_cast<uint64_t>(receipt.gas_used));
                         cumulative_gas_used += receipt.gas_used;
                         receipt.cumulative_gas_used = cumulative_gas_used;
-                        if (rev < EVMC_BYZANTIUM)
-                            receipt.post_state = state::mpt_hash(state);
+                        if (state_trie.has_value())
+                        {
+                            state_trie->apply(receipt.state_diff);
+                            receipt.post_state = state_trie->hash();
+                        }
                         j_receipt["cumulativeGasUsed"] = hex0x(cumulative_gas_used);
 
                         j_receipt["blockHash"] = hex0x(bytes32{});
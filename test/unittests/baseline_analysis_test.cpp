@@ -2,9 +2,13 @@
 // Copyright 2024 The evmone Authors.
 // SPDX-License-Identifier: Apache-2.0
 
+#include <evmone/analysis_store.hpp>
 #include <evmone/baseline.hpp>
 #include <gtest/gtest.h>
 #include <test/utils/bytecode.hpp>
+#include <filesystem>
+#include <fstream>
+#include <limits>
 
 using namespace evmone::test;
 
@@ -32,3 +36,154 @@ TEST(baseline_analysis, eof1)
     EXPECT_EQ(analysis.raw_code(), container);
     EXPECT_EQ(analysis.raw_code().data(), container.data()) << "copy should not be made";
 }
+
+TEST(baseline_analysis, fusion)
+{
+    // SWAP1 POP, undefined 0x21, PUSH1 JUMP, PUSH2 with truncated push data 0x21.
+    const bytecode code{"9050" "21" "600456" "6121"};
+    auto analysis = evmone::baseline::analyze(code, false);
+    evmone::baseline::fuse_instructions(analysis);
+
+    EXPECT_TRUE(analysis.is_fused());
+    EXPECT_EQ(analysis.executable_code(), bytecode{"2650" "0c" "210456" "6121"});
+    EXPECT_EQ(analysis.unfused_code(), code);
+    EXPECT_EQ(analysis.raw_code(), code);
+}
+
+TEST(baseline_analysis, fusion_eof)
+{
+    const auto code = push(1) + push(2) + OP_SWAP1 + OP_POP + OP_STOP;
+    const bytecode container = eof_bytecode(code, 2);
+    auto analysis = evmone::baseline::analyze(container, true);
+    evmone::baseline::fuse_instructions(analysis);
+
+    EXPECT_FALSE(analysis.is_fused());
+    EXPECT_EQ(analysis.executable_code(), code);
+}
+
+TEST(baseline_analysis, blocks)
+{
+    // PUSH1 PUSH1 ADD | JUMPDEST PUSH1 GAS | SLOAD PUSH0 | STOP
+    const bytecode code{"6001600201" "5b60005a" "545f" "00"};
+    auto analysis = evmone::baseline::analyze(code, false);
+    evmone::baseline::analyze_blocks(analysis);
+
+    const auto blocks = analysis.blocks();
+    ASSERT_EQ(blocks.size(), 4);
+    EXPECT_EQ(blocks[0].begin, 0);
+    EXPECT_EQ(blocks[0].last, 4);
+    EXPECT_EQ(blocks[0].end, 5);
+    EXPECT_EQ(blocks[0].gas_cost, 9);
+    EXPECT_EQ(blocks[0].stack_req, 0);
+    EXPECT_EQ(blocks[0].stack_max_growth, 2);
+    EXPECT_EQ(blocks[1].begin, 5);
+    EXPECT_EQ(blocks[1].last, 8);
+    EXPECT_EQ(blocks[1].end, 9);
+    EXPECT_EQ(blocks[1].gas_cost, 6);
+    EXPECT_EQ(blocks[1].stack_req, 0);
+    EXPECT_EQ(blocks[1].stack_max_growth, 2);
+    EXPECT_EQ(blocks[2].begin, 11);
+    EXPECT_EQ(blocks[2].last, 11);
+    EXPECT_EQ(blocks[2].end, 12);
+    EXPECT_EQ(blocks[2].gas_cost, 0);
+    EXPECT_EQ(blocks[3].begin, std::numeric_limits<uint32_t>::max()) << "sentinel";
+}
+
+TEST(baseline_analysis, blocks_stack_req)
+{
+    // POP SWAP2 DUP4 ADD PUSH1 JUMP with truncated push data.
+    const bytecode code{"50" "91" "83" "01" "56" "60"};
+    auto analysis = evmone::baseline::analyze(code, false);
+    evmone::baseline::analyze_blocks(analysis);
+
+    const auto blocks = analysis.blocks();
+    ASSERT_EQ(blocks.size(), 3);
+    EXPECT_EQ(blocks[0].begin, 0);
+    EXPECT_EQ(blocks[0].last, 4);
+    EXPECT_EQ(blocks[0].end, 5);
+    EXPECT_EQ(blocks[0].stack_req, 5);
+    EXPECT_EQ(blocks[0].stack_max_growth, 0);
+    EXPECT_EQ(blocks[1].begin, 5);
+    EXPECT_EQ(blocks[1].last, 5);
+    EXPECT_EQ(blocks[1].end, 7) << "push data extends into the padding";
+}
+
+TEST(baseline_analysis, store)
+{
+    using namespace evmc::literals;
+    using evmone::baseline::AnalysisStore;
+
+    const auto code1 = push(1) + OP_JUMPDEST + ret_top();
+    const auto code2 = 40 * OP_JUMPDEST + push(0xff) + OP_JUMPDEST;
+    const bytecode eof_container = eof_bytecode(OP_STOP);
+    const std::pair<evmc::bytes32, bytes_view> codes[]{
+        {0x02_bytes32, code2},
+        {0x01_bytes32, code1},
+        {0x02_bytes32, code1},  // Duplicate: skipped.
+        {0x03_bytes32, eof_container},
+    };
+
+    const auto path = std::filesystem::temp_directory_path() / "evmone_analysis_store_test.bin";
+    ASSERT_TRUE(evmone::baseline::write_analysis_store(path.string().c_str(), codes));
+    const auto store = AnalysisStore::load(path.string().c_str());
+    std::filesystem::remove(path);
+    ASSERT_NE(store, nullptr);
+    EXPECT_EQ(store->size(), 2);
+
+    const auto analysis1 = store->find(0x01_bytes32, code1);
+    ASSERT_TRUE(analysis1.has_value());
+    EXPECT_EQ(analysis1->raw_code(), code1);
+    EXPECT_EQ(analysis1->executable_code(), code1);
+    EXPECT_FALSE(analysis1->check_jumpdest(0));
+    EXPECT_TRUE(analysis1->check_jumpdest(2));
+    EXPECT_FALSE(analysis1->check_jumpdest(code1.size()));
+
+    const auto analysis2 = store->find(0x02_bytes32, code2);
+    ASSERT_TRUE(analysis2.has_value());
+    EXPECT_EQ(analysis2->raw_code(), code2);
+    const auto reference = evmone::baseline::analyze(code2, false);
+    for (size_t i = 0; i < code2.size() + 2; ++i)
+        EXPECT_EQ(analysis2->check_jumpdest(i), reference.check_jumpdest(i)) << i;
+
+    EXPECT_FALSE(store->find(0x03_bytes32, eof_container).has_value());
+    EXPECT_FALSE(store->find(0x04_bytes32, code1).has_value());
+
+    // The stored code doesn't match the given code.
+    EXPECT_FALSE(store->find(0x02_bytes32, code1).has_value());
+    EXPECT_FALSE(store->find(0x01_bytes32, push(2) + OP_JUMPDEST + ret_top()).has_value());
+}
+
+TEST(baseline_analysis, store_corrupted_code)
+{
+    using namespace evmc::literals;
+    using evmone::baseline::AnalysisStore;
+
+    const auto code = push(1) + OP_JUMPDEST + ret_top();
+    const std::pair<evmc::bytes32, bytes_view> codes[]{{0x01_bytes32, code}};
+
+    const auto path = std::filesystem::temp_directory_path() / "evmone_analysis_store_corrupt.bin";
+    ASSERT_TRUE(evmone::baseline::write_analysis_store(path.string().c_str(), codes));
+    {
+        // Replace the PUSH1 argument of the stored code.
+        const auto layout = evmone::baseline::get_legacy_analysis_layout(code.size());
+        const auto code_offset = std::filesystem::file_size(path) - layout.total_size();
+        std::fstream f{path, std::ios::in | std::ios::out | std::ios::binary};
+        f.seekp(static_cast<std::streamoff>(code_offset + 1));
+        f.put(0x02);
+    }
+    const auto store = AnalysisStore::load(path.string().c_str());
+    std::filesystem::remove(path);
+    ASSERT_NE(store, nullptr);
+    EXPECT_FALSE(store->find(0x01_bytes32, code).has_value());
+}
+
+TEST(baseline_analysis, store_invalid_file)
+{
+    using evmone::baseline::AnalysisStore;
+    EXPECT_EQ(AnalysisStore::load(""), nullptr);
+
+    const auto path = std::filesystem::temp_directory_path() / "evmone_analysis_store_bad.bin";
+    std::ofstream{path} << "evmoneAS but not really";
+    EXPECT_EQ(AnalysisStore::load(path.string().c_str()), nullptr);
+    std::filesystem::remove(path);
+}
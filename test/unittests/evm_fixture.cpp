@@ -12,6 +12,10 @@ namespace
 evmc::VM advanced_vm{evmc_create_evmone(), {{"advanced", ""}}};
 evmc::VM baseline_vm{evmc_create_evmone()};
 evmc::VM bnocgoto_vm{evmc_create_evmone(), {{"cgoto", "no"}}};
+evmc::VM bfusion_vm{evmc_create_evmone(), {{"fusion", ""}}};
+evmc::VM bblocks_vm{evmc_create_evmone(), {{"block_check", ""}}};
+evmc::VM bjit_vm{evmc_create_evmone(), {{"jit", "0"}}};
+evmc::VM bvmem_vm{evmc_create_evmone(), {{"virtual_memory", ""}}};
 
 const char* print_vm_name(const testing::TestParamInfo<evmc::VM*>& info) noexcept
 {
@@ -21,12 +25,22 @@ const char* print_vm_name(const testing::TestParamInfo<evmc::VM*>& info) noexcep
         return "baseline";
     if (info.param == &bnocgoto_vm)
         return "bnocgoto";
+    if (info.param == &bfusion_vm)
+        return "bfusion";
+    if (info.param == &bblocks_vm)
+        return "bblocks";
+    if (info.param == &bjit_vm)
+        return "bjit";
+    if (info.param == &bvmem_vm)
+        return "bvmem";
     return "unknown";
 }
 }  // namespace
 
-INSTANTIATE_TEST_SUITE_P(
-    evmone, evm, testing::Values(&advanced_vm, &baseline_vm, &bnocgoto_vm), print_vm_name);
+INSTANTIATE_TEST_SUITE_P(evmone, evm,
+    testing::Values(&advanced_vm, &baseline_vm, &bnocgoto_vm, &bfusion_vm, &bblocks_vm, &bjit_vm,
+        &bvmem_vm),
+    print_vm_name);
 
 bool evm::is_advanced() noexcept
 {
@@ -242,3 +242,24 @@ TEST(evmmax, bn254_pt_mul)
         EXPECT_EQ(r, e);
     }
 }
+
+TEST(evmmax, bn254_pt_mul_glv)
+{
+    const Point G{1, 2};
+    const Point neg_G{1, FieldPrime - 2};
+
+    // The endomorphism φ(x, y) = (βx, y) is the multiplication by λ.
+    const auto lambda = 0x30644e72e131a029048b6e193fd84104cc37a73fec2bc5e9b8ca0b2d36636f23_u256;
+    const auto beta = 0x30644e72e131a0295e6dd9e7e0acccb0c28f069fbb966e3de4bd44e5607cfd48_u256;
+    const Point endo_G{beta, 2};
+    const Point neg_endo_G{beta, FieldPrime - 2};
+    EXPECT_EQ(mul(G, lambda), endo_G);
+    EXPECT_EQ(mul(G, Order - lambda), neg_endo_G);
+
+    EXPECT_EQ(mul(G, 1), G);
+    EXPECT_EQ(mul(G, Order - 1), neg_G);
+    EXPECT_EQ(mul(G, Order), Point{});
+    EXPECT_EQ(mul(G, Order + 1), G);
+    EXPECT_EQ(mul(G, ~uint256{}), mul(G, ~uint256{} % Order));
+    EXPECT_EQ(mul(G, 2), add(G, G));
+}
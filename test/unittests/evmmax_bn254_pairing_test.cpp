@@ -3,11 +3,36 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include "evmone_precompiles/bn254.hpp"
+#include "evmone_precompiles/pairing/bn254/fields.hpp"
+#include "evmone_precompiles/parallel.hpp"
 #include <gtest/gtest.h>
 
 using namespace evmmax::bn254;
 using namespace intx;
 
+namespace
+{
+/// Returns the pairs {P, Q} and {-P, Q} with the pairing product equal 1.
+std::vector<std::pair<Point, ExtPoint>> inverse_pairs()
+{
+    const auto P = Point{
+        0x1c76476f4def4bb94541d57ebba1193381ffa7aa76ada664dd31c16024c43f59_u256,
+        0x3034dd2920f673e204fee2811c678745fc819b55d3e9d294e45c9b03a76aef41_u256,
+    };
+    const auto nP = Point{P.x, FieldPrime - P.y};
+    const auto Q = ExtPoint{
+        {
+            0x04bf11ca01483bfa8b34b43561848d28905960114c8ac04049af4b6315a41678_u256,
+            0x209dd15ebff5d46c4bd888e51a93cf99a7329636c63514396b4a452003a35bf7_u256,
+        },
+        {
+            0x120a2a4cf30c1bf9845f20c6fe39e07ea2cce61f0c9bb048165fe5e4de877550_u256,
+            0x2bb8324af6cfc93537a2ad1a445cfd0ca2a71acd7ac41fadbf933c2a51be344d_u256,
+        },
+    };
+    return {{P, Q}, {nP, Q}};
+}
+}  // namespace
 
 TEST(evmmax, bn254_pairing)
 {
@@ -250,3 +275,67 @@ TEST(evmmax_bn254, evm_codes_example_changed_order)
     ASSERT_TRUE(!result.has_value())
         << "Pairing check should not return value. Modified points are not on twisted curve.";
 }
+
+TEST(evmmax_bn254, pairing_g2_cache)
+{
+    const auto pairs = inverse_pairs();
+
+    clear_g2_cache();
+    EXPECT_EQ(pairing_check(pairs), true);
+    EXPECT_EQ(get_g2_cache_stats().misses, 1u);
+    EXPECT_EQ(get_g2_cache_stats().hits, 1u);
+
+    EXPECT_EQ(pairing_check(pairs), true);
+    EXPECT_EQ(get_g2_cache_stats().misses, 1u);
+    EXPECT_EQ(get_g2_cache_stats().hits, 3u);
+
+    // The invalid G2 point is not cached.
+    auto invalid_pairs = pairs;
+    invalid_pairs[1].second.x.first += 1;
+    EXPECT_EQ(pairing_check(invalid_pairs), std::nullopt);
+    EXPECT_EQ(pairing_check(invalid_pairs), std::nullopt);
+    EXPECT_EQ(get_g2_cache_stats().misses, 1u);
+    EXPECT_EQ(get_g2_cache_stats().hits, 5u);
+
+    clear_g2_cache();
+    EXPECT_EQ(get_g2_cache_stats().misses, 0u);
+    EXPECT_EQ(get_g2_cache_stats().hits, 0u);
+    EXPECT_EQ(pairing_check(pairs), true);
+    EXPECT_EQ(get_g2_cache_stats().misses, 1u);
+}
+
+TEST(evmmax_bn254, pairing_parallel)
+{
+    const auto inverse = inverse_pairs();
+
+    evmone::crypto::set_parallel_pairing(3, 2);
+
+    std::vector<std::pair<Point, ExtPoint>> pairs;
+    for (size_t i = 0; i < 4; ++i)
+        pairs.insert(pairs.end(), inverse.begin(), inverse.end());
+    EXPECT_EQ(pairing_check(pairs), true);
+
+    pairs.push_back(inverse[0]);
+    EXPECT_EQ(pairing_check(pairs), false);
+
+    pairs.back().second.x.first += 1;
+    EXPECT_EQ(pairing_check(pairs), std::nullopt);
+
+    evmone::crypto::set_parallel_pairing(0);
+}
+
+TEST(evmmax_bn254, fq6_multiply_max_coefficients)
+{
+    // The lazily reduced sums of products are the largest for the coefficients p - 1.
+    const auto m = -Fq::one();
+    const auto a = Fq6({Fq2({m, m}), Fq2({m, m}), Fq2({m, m})});
+    const auto b = Fq6({Fq2({m, Fq::one()}), Fq2({m, m}), Fq2({Fq::one(), m})});
+
+    EXPECT_EQ(a * a.inv(), Fq6::one());
+    EXPECT_EQ(a * b, b * a);
+    EXPECT_EQ(a * (b + Fq6::one()), a * b + a);
+    EXPECT_EQ(multiply_by_ksi(a.coeffs[0]), a.coeffs[0] * Fq6Config::ksi);
+
+    const auto c = Fq12({a, b});
+    EXPECT_EQ(c * c.inv(), Fq12::one());
+}
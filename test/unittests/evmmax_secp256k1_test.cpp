@@ -5,6 +5,8 @@
 #include <evmone_precompiles/secp256k1.hpp>
 #include <gtest/gtest.h>
 #include <test/utils/utils.hpp>
+#include <array>
+#include <vector>
 
 using namespace evmmax::secp256k1;
 using namespace evmc::literals;
@@ -272,6 +274,59 @@ TEST(evmmax, secp256k1_pt_mul)
 }
 
 
+TEST(evmmax, secp256k1_pt_mul_glv)
+{
+    const Point G{0x79be667ef9dcbbac55a06295ce870b07029bfcdb2dce28d959f2815b16f81798_u256,
+        0x483ada7726a3c4655da4fbfc0e1108a8fd17b448a68554199c47d08ffb10d4b8_u256};
+    const Point neg_G{G.x, FieldPrime - G.y};
+
+    // The endomorphism φ(x, y) = (βx, y) is the multiplication by λ.
+    const auto lambda = 0x5363ad4cc05c30e0a5261c028812645a122e22ea20816678df02967c1b23bd72_u256;
+    const auto beta = 0x7ae96a2b657c07106e64479eac3434e99cf0497512f58995c1396c28719501ee_u256;
+    const Point endo_G{mulmod(beta, G.x, FieldPrime), G.y};
+    const Point neg_endo_G{endo_G.x, neg_G.y};
+    EXPECT_EQ(mul(G, lambda), endo_G);
+    EXPECT_EQ(mul(G, Order - lambda), neg_endo_G);
+
+    EXPECT_EQ(mul(G, 1), G);
+    EXPECT_EQ(mul(G, Order - 1), neg_G);
+    EXPECT_EQ(mul(G, Order + 1), G);
+    EXPECT_EQ(mul(G, ~uint256{}), mul(G, ~uint256{} - Order));
+    EXPECT_EQ(mul(G, 2), add(G, G));
+    EXPECT_EQ(mul(G, Order - 2), add(neg_G, neg_G));
+}
+
+TEST(ecc, wnaf)
+{
+    const uint256 scalars[]{0, 1, 15, 16, 17, 31, 0xff, Order - 1, ~uint256{},
+        0x5363ad4cc05c30e0a5261c028812645a122e22ea20816678df02967c1b23bd72_u256};
+    for (const auto& c : scalars)
+    {
+        std::array<int8_t, 257> naf{};
+        const auto len = evmmax::ecc::wnaf<5>(naf, c);
+
+        uint256 value;
+        size_t last_nonzero = 0;
+        for (size_t i = len; i != 0; --i)
+        {
+            const auto d = naf[i - 1];
+            value = 2 * value + (d < 0 ? 0 - uint256(-d) : uint256(d));
+            if (d != 0)
+            {
+                EXPECT_EQ(d % 2, d < 0 ? -1 : 1);
+                EXPECT_LT(d < 0 ? -d : d, 16);
+                if (last_nonzero != 0)
+                    EXPECT_GE(last_nonzero - i, 5);
+                last_nonzero = i;
+            }
+        }
+        EXPECT_EQ(value, c);
+        if (len != 0)
+            EXPECT_NE(naf[len - 1], 0);
+    }
+}
+
+
 struct TestCaseECR
 {
     evmc::bytes32 hash;
@@ -361,3 +416,54 @@ TEST(evmmax, ecrecovery)
         }
     }
 }
+
+TEST(evmmax, ecrecovery_batch)
+{
+    // Repeat the test cases to cover multiple internal chunks of the batch.
+    std::vector<RecoveryInput> inputs;
+    std::vector<const TestCaseECRecovery*> cases;
+    for (size_t i = 0; i < 5; ++i)
+    {
+        for (const auto& t : test_cases)
+        {
+            ASSERT_EQ(t.input.size(), 128);
+            RecoveryInput& input = inputs.emplace_back();
+            std::memcpy(input.e.bytes, t.input.data(), 32);
+            input.v = be::unsafe::load<uint256>(&t.input[32]) == 28;
+            input.r = be::unsafe::load<uint256>(&t.input[64]);
+            input.s = be::unsafe::load<uint256>(&t.input[96]);
+            cases.push_back(&t);
+        }
+    }
+
+    std::vector<std::optional<evmc::address>> results(inputs.size());
+    ecrecover_batch(inputs, results);
+
+    std::vector<std::optional<Point>> points(inputs.size());
+    secp256k1_ecdsa_recover_batch(inputs, points);
+
+    for (size_t i = 0; i < inputs.size(); ++i)
+    {
+        const auto& expected_output = cases[i]->expected_output;
+        if (expected_output.empty())
+        {
+            EXPECT_FALSE(results[i].has_value());
+            EXPECT_FALSE(points[i].has_value());
+        }
+        else
+        {
+            evmc::address e;
+            memcpy(&e.bytes[0], &expected_output[12], 20);
+            ASSERT_TRUE(results[i].has_value());
+            EXPECT_EQ(*results[i], e);
+            ASSERT_TRUE(points[i].has_value());
+            EXPECT_EQ(to_address(*points[i]), e);
+        }
+    }
+}
+
+TEST(evmmax, ecrecovery_batch_empty)
+{
+    ecrecover_batch({}, {});
+    secp256k1_ecdsa_recover_batch({}, {});
+}
@@ -76,6 +76,7 @@ static auto get_test_values(const Mod& m) noexcept
     static_assert(m.add(a, b) == m.to_mont(14));
     static_assert(m.sub(a, b) == m.to_mont(BN254Mod - 8));
     static_assert(m.mul(a, b) == m.to_mont(33));
+    static_assert(m.sqr(b) == m.to_mont(121));
 }
 
 TYPED_TEST(evmmax_test, add)
@@ -148,6 +149,47 @@ TYPED_TEST(evmmax_test, mul)
     }
 }
 
+TYPED_TEST(evmmax_test, sqr)
+{
+    const TypeParam m;
+    for (const auto& x : get_test_values(m))
+    {
+        const auto xm = m.to_mont(x);
+        const auto sm = m.sqr(xm);
+        EXPECT_EQ(sm, m.mul(xm, xm));
+        EXPECT_EQ(m.from_mont(sm), udivrem(umul(x, x), m.mod).rem);
+    }
+}
+
+TYPED_TEST(evmmax_test, lazy_reduction)
+{
+    using Uint = typename TypeParam::uint;
+    const TypeParam m;
+    const auto values = get_test_values(m);
+
+    // The sum of two products is reducible if the modulus top bit is clear.
+    const auto sum_reducible = m.mod < (Uint{1} << (Uint::num_bits - 1));
+
+    for (const auto& x : values)
+    {
+        const auto xm = m.to_mont(x);
+        EXPECT_EQ(m.reduce(m.sqr_wide(xm)), m.mul(xm, xm));
+        for (const auto& y : values)
+        {
+            const auto ym = m.to_mont(y);
+            const auto pm = m.mul(xm, ym);
+            EXPECT_EQ(m.reduce(m.mul_wide(xm, ym)), pm);
+            EXPECT_EQ(m.reduce(m.sub_wide(m.mul_wide(xm, ym), m.sqr_wide(ym))),
+                m.sub(pm, m.sqr(ym)));
+            if (sum_reducible)
+            {
+                EXPECT_EQ(m.reduce(m.add_wide(m.mul_wide(xm, ym), m.sqr_wide(xm))),
+                    m.add(pm, m.sqr(xm)));
+            }
+        }
+    }
+}
+
 TYPED_TEST(evmmax_test, inv)
 {
     const TypeParam m;
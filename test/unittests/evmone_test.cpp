@@ -3,9 +3,16 @@
 // SPDX-License-Identifier: Apache-2.0
 
 #include <evmc/evmc.hpp>
+#include <evmc/mocked_host.hpp>
+#include <evmone/baseline_jit.hpp>
 #include <evmone/evmone.h>
 #include <evmone/vm.hpp>
 #include <gtest/gtest.h>
+#include <test/utils/bytecode.hpp>
+#include <limits>
+#include <optional>
+#include <utility>
+#include <vector>
 
 TEST(evmone, info)
 {
@@ -53,3 +60,168 @@ TEST(evmone, set_option_cgoto)
     EXPECT_EQ(vm.set_option("cgoto", "no"), EVMC_SET_OPTION_INVALID_NAME);
 #endif
 }
+
+TEST(evmone, set_option_jit)
+{
+    evmc::VM vm{evmc_create_evmone()};
+#if EVMONE_JIT_SUPPORTED
+    const auto& evmone_vm = *static_cast<evmone::VM*>(vm.get_raw_pointer());
+    EXPECT_EQ(vm.set_option("jit", ""), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(evmone_vm.jit_min_code_size, std::numeric_limits<size_t>::max());
+    EXPECT_EQ(vm.set_option("jit", "1024"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(evmone_vm.jit_min_code_size, size_t{1024});
+    EXPECT_EQ(vm.set_option("jit", "12x"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(evmone_vm.jit_min_code_size, size_t{1024});
+    EXPECT_EQ(vm.set_option("jit", ""), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(evmone_vm.jit_min_code_size, std::numeric_limits<size_t>::max());
+    EXPECT_EQ(vm.set_option("jit", "0"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(evmone_vm.jit_min_code_size, size_t{0});
+    EXPECT_EQ(vm.set_option("jit", "x"), EVMC_SET_OPTION_INVALID_VALUE);
+#else
+    EXPECT_EQ(vm.set_option("jit", ""), EVMC_SET_OPTION_INVALID_NAME);
+#endif
+}
+
+TEST(evmone, set_option_virtual_memory)
+{
+    evmc::VM vm{evmc_create_evmone()};
+    const auto expected = evmone::Memory::virtual_supported() ? EVMC_SET_OPTION_SUCCESS :
+                                                                EVMC_SET_OPTION_INVALID_NAME;
+    EXPECT_EQ(vm.set_option("virtual_memory", ""), expected);
+}
+
+TEST(evmone, set_option_analysis_cache)
+{
+    evmc::VM vm{evmc_create_evmone()};
+    EXPECT_EQ(vm.set_option("analysis_cache", ""), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("analysis_cache", "x"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("analysis_cache", "-1"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("analysis_cache", "1k"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("analysis_cache", "1000"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("analysis_cache", "0"), EVMC_SET_OPTION_SUCCESS);
+}
+
+TEST(evmone, set_option_shared_analysis_cache)
+{
+    evmc::VM vm1{evmc_create_evmone()};
+    evmc::VM vm2{evmc_create_evmone()};
+    EXPECT_EQ(vm1.set_option("shared_analysis_cache", ""), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm1.set_option("shared_analysis_cache", "100"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm2.set_option("shared_analysis_cache", "200"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(static_cast<evmone::VM*>(vm1.get_raw_pointer())->get_code_cache(),
+        static_cast<evmone::VM*>(vm2.get_raw_pointer())->get_code_cache());
+    EXPECT_EQ(vm2.set_option("shared_analysis_cache", "0"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(static_cast<evmone::VM*>(vm2.get_raw_pointer())->get_code_cache(), nullptr);
+}
+
+TEST(evmone, analysis_cache)
+{
+    using namespace evmc::literals;
+    using evmone::test::push;
+    using evmone::test::ret_top;
+
+    evmc::VM vm{evmc_create_evmone(), {{"analysis_cache", "1"}}};
+    evmc::MockedHost host;
+
+    constexpr auto addr_a = 0xaa_address;
+    constexpr auto addr_b = 0xbb_address;
+    const auto code_a = push(1) + ret_top();
+    const auto code_b = push(2) + evmone::OP_JUMPDEST + ret_top();
+    host.accounts[addr_a].codehash = 0x0a_bytes32;
+    host.accounts[addr_b].codehash = 0x0b_bytes32;
+
+    const auto execute = [&](const evmc::address& addr, const evmone::test::bytecode& code) {
+        evmc_message msg{};
+        msg.gas = 1000;
+        msg.recipient = addr;
+        msg.code_address = addr;
+        const auto r = vm.execute(host, EVMC_CANCUN, msg, code.data(), code.size());
+        EXPECT_EQ(r.status_code, EVMC_SUCCESS);
+        EXPECT_EQ(r.output_size, 32);
+        return r.output_size == 32 ? r.output_data[31] : 0;
+    };
+
+    EXPECT_EQ(execute(addr_a, code_a), 1);
+    EXPECT_EQ(execute(addr_a, code_a), 1);
+    EXPECT_EQ(execute(addr_b, code_b), 2);  // Evicts code_a.
+    EXPECT_EQ(execute(addr_a, code_a), 1);
+
+    // The same code hash with different code size is re-analyzed.
+    host.accounts[addr_b].codehash = 0x0a_bytes32;
+    EXPECT_EQ(execute(addr_b, code_b), 2);
+}
+
+TEST(evmone, set_option_tiering)
+{
+    evmc::VM vm{evmc_create_evmone()};
+    const auto& evmone_vm = *static_cast<evmone::VM*>(vm.get_raw_pointer());
+    EXPECT_EQ(vm.set_option("tiering", ""), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("tiering", "x"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("tiering", "-1"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("tiering", "100"), EVMC_SET_OPTION_SUCCESS);
+    ASSERT_NE(evmone_vm.get_tiering(), nullptr);
+    EXPECT_EQ(evmone_vm.get_tiering()->threshold(), 100);
+    EXPECT_EQ(vm.set_option("tiering", "0"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(evmone_vm.get_tiering(), nullptr);
+}
+
+TEST(evmone, set_option_parallel_pairing)
+{
+    evmc::VM vm{evmc_create_evmone()};
+    EXPECT_EQ(vm.set_option("parallel_pairing", ""), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("parallel_pairing", "x"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("parallel_pairing", "-1"), EVMC_SET_OPTION_INVALID_VALUE);
+    EXPECT_EQ(vm.set_option("parallel_pairing", "2"), EVMC_SET_OPTION_SUCCESS);
+    EXPECT_EQ(vm.set_option("parallel_pairing", "0"), EVMC_SET_OPTION_SUCCESS);
+}
+
+TEST(evmone, tiering)
+{
+    using namespace evmc::literals;
+    using evmone::test::push;
+    using evmone::test::ret_top;
+
+    evmc::VM vm{evmc_create_evmone(), {{"tiering", "2"}}};
+    auto& tiering = *static_cast<evmone::VM*>(vm.get_raw_pointer())->get_tiering();
+    evmc::MockedHost host;
+
+    std::vector<std::pair<evmc::bytes32, uint64_t>> promotions;
+    tiering.set_promotion_handler(
+        [&](const evmc::bytes32& code_hash, evmc_revision /*rev*/, uint64_t count) {
+            promotions.emplace_back(code_hash, count);
+        });
+
+    constexpr auto addr = 0xaa_address;
+    const auto code = push(1) + push(2) + evmone::OP_ADD + ret_top();
+    host.accounts[addr].codehash = 0x0a_bytes32;
+
+    std::optional<int64_t> gas_left;
+    const auto execute = [&](evmc_revision rev) {
+        evmc_message msg{};
+        msg.gas = 1000;
+        msg.recipient = addr;
+        msg.code_address = addr;
+        const auto r = vm.execute(host, rev, msg, code.data(), code.size());
+        EXPECT_EQ(r.status_code, EVMC_SUCCESS);
+        EXPECT_EQ(r.gas_left, gas_left.value_or(r.gas_left)) << "same in both interpreters";
+        gas_left = r.gas_left;
+        EXPECT_EQ(r.output_size, 32);
+        return r.output_size == 32 ? r.output_data[31] : 0;
+    };
+
+    EXPECT_EQ(execute(EVMC_CANCUN), 3);
+    EXPECT_EQ(execute(EVMC_CANCUN), 3);
+    EXPECT_EQ(tiering.stats().promotions, 0);
+    EXPECT_EQ(execute(EVMC_CANCUN), 3);  // Promoted.
+    EXPECT_EQ(execute(EVMC_CANCUN), 3);
+    EXPECT_EQ(execute(EVMC_SHANGHAI), 3);  // Re-analyzed for the different revision.
+
+    EXPECT_EQ(tiering.stats().baseline_executions, 2);
+    EXPECT_EQ(tiering.stats().advanced_executions, 3);
+    EXPECT_EQ(tiering.stats().promotions, 2);
+    EXPECT_EQ(tiering.get_execution_count(0x0a_bytes32), 5);
+    EXPECT_EQ(tiering.get_execution_count(0x0b_bytes32), 0);
+    ASSERT_EQ(promotions.size(), 2);
+    EXPECT_EQ(promotions[0], std::pair(0x0a_bytes32, uint64_t{3}));
+    EXPECT_EQ(promotions[1], std::pair(0x0a_bytes32, uint64_t{5}));
+}
@@ -4,6 +4,7 @@
 
 #include <evmone/advanced_analysis.hpp>
 #include <evmone/execution_state.hpp>
+#include <evmone/execution_state_pool.hpp>
 #include <gtest/gtest.h>
 #include <type_traits>
 
@@ -80,7 +81,7 @@ TEST(execution_state, reset_advanced)
     st.memory.grow(64);
     st.msg = &msg;
     st.rev = EVMC_BYZANTIUM;
-    st.return_data.push_back('0');
+    st.return_data.assign(reinterpret_cast<const uint8_t*>("0"), 1);
     st.status = EVMC_FAILURE;
     st.output_offset = 3;
     st.output_size = 4;
@@ -144,3 +145,189 @@ TEST(execution_state, memory_view)
     EXPECT_EQ(view[1], 0x00);
     EXPECT_EQ(view[2], 0xc2);
 }
+
+TEST(execution_state, memory_lazy_allocation)
+{
+    evmone::Memory memory;
+    EXPECT_EQ(memory.size(), 0);
+    EXPECT_EQ(memory.capacity(), 0);
+    EXPECT_EQ(memory.data(), nullptr);
+
+    memory.grow(32);
+    EXPECT_EQ(memory.size(), 32);
+    EXPECT_EQ(memory.capacity(), 4096);
+    EXPECT_NE(memory.data(), nullptr);
+
+    memory.grow(8192 + 32);
+    EXPECT_EQ(memory.capacity(), 12288);
+
+    memory.clear();
+    EXPECT_EQ(memory.size(), 0);
+    EXPECT_EQ(memory.capacity(), 12288);
+
+    memory.release();
+    EXPECT_EQ(memory.size(), 0);
+    EXPECT_EQ(memory.capacity(), 0);
+    EXPECT_EQ(memory.data(), nullptr);
+}
+
+TEST(execution_state, memory_virtual)
+{
+    evmone::Memory memory;
+    memory.set_virtual(true);
+    if (!evmone::Memory::virtual_supported())
+    {
+        EXPECT_FALSE(memory.is_virtual());
+        GTEST_SKIP();
+    }
+    EXPECT_TRUE(memory.is_virtual());
+    EXPECT_EQ(memory.capacity(), 0);
+
+    memory.grow(32);
+    EXPECT_EQ(memory.capacity(), 64 * 1024);
+    memory[0] = 0xc0;
+    memory[31] = 0xc1;
+
+    // The growth within the reservation does not move the data.
+    const auto data = memory.data();
+    memory.grow(1024 * 1024);
+    EXPECT_EQ(memory.data(), data);
+    EXPECT_EQ(memory.capacity(), 1024 * 1024);
+    EXPECT_EQ(memory[0], 0xc0);
+    EXPECT_EQ(memory[31], 0xc1);
+    EXPECT_EQ(memory[1024 * 1024 - 1], 0x00);
+
+    // The memory reused after clear() is zeroed.
+    memory[1024 * 1024 - 1] = 0xff;
+    memory.clear();
+    memory.grow(32);
+    EXPECT_EQ(memory[0], 0x00);
+    EXPECT_EQ(memory[31], 0x00);
+    memory.grow(1024 * 1024);
+    EXPECT_EQ(memory[1024 * 1024 - 1], 0x00);
+
+    // Exceeding the initial reservation moves the data.
+    memory[1] = 0xc2;
+    memory.grow(100 * 1024 * 1024);
+    EXPECT_EQ(memory[1], 0xc2);
+    EXPECT_EQ(memory[100 * 1024 * 1024 - 1], 0x00);
+
+    memory.release();
+    EXPECT_EQ(memory.capacity(), 0);
+    EXPECT_TRUE(memory.is_virtual());
+
+    memory.set_virtual(false);
+    memory.grow(32);
+    EXPECT_EQ(memory.capacity(), 4096);
+}
+
+TEST(execution_state, reset_keeps_call_stack_capacity)
+{
+    const evmc_message msg{};
+    const evmc_host_interface host_interface{};
+    const uint8_t code[]{0x00};
+
+    evmone::ExecutionState st;
+    st.call_stack.resize(100);
+    const auto capacity = st.call_stack.capacity();
+
+    st.reset(msg, EVMC_OSAKA, host_interface, nullptr, {code, std::size(code)});
+    EXPECT_TRUE(st.call_stack.empty());
+    EXPECT_EQ(st.call_stack.capacity(), capacity);
+}
+
+TEST(execution_state, return_data_handoff)
+{
+    const uint8_t output[]{0xa0, 0xa1, 0xa2};
+
+    evmone::ExecutionState caller;
+    evmone::ExecutionState callee;
+    caller.callee_state = &callee;
+
+    // The output buffer is passed with the result and taken over by the caller without copying.
+    evmc::Result result{
+        callee.output_buffer.make_result(EVMC_SUCCESS, 10, 1, output, std::size(output))};
+    EXPECT_EQ(callee.output_buffer.capacity(), 0);
+    const auto output_data = result.output_data;
+    caller.set_return_data(result);
+    EXPECT_EQ(caller.return_data.data(), output_data);
+    EXPECT_EQ(evmone::bytes_view{caller.return_data}, (evmone::bytes_view{output, 3}));
+    EXPECT_EQ(result.output_data, output_data);
+    EXPECT_EQ(result.gas_left, 10);
+
+    // The previous return data buffer is given to the callee for reuse.
+    evmc::Result result2{callee.output_buffer.make_result(EVMC_REVERT, 0, 0, output, 1)};
+    caller.set_return_data(result2);
+    EXPECT_EQ(caller.return_data.size(), 1);
+    EXPECT_EQ(callee.output_buffer.data(), output_data);
+    EXPECT_EQ(callee.output_buffer.capacity(), 3);
+
+    // The result without output does not take the buffer.
+    evmc::Result result3{callee.output_buffer.make_result(EVMC_SUCCESS, 0, 0, nullptr, 0)};
+    EXPECT_EQ(callee.output_buffer.data(), output_data);
+    caller.set_return_data(result3);
+    EXPECT_TRUE(caller.return_data.empty());
+
+    // The output of other results is copied.
+    evmc::Result result4{EVMC_SUCCESS, 0, 0, output, std::size(output)};
+    caller.set_return_data(result4);
+    EXPECT_NE(caller.return_data.data(), result4.output_data);
+    EXPECT_EQ(evmone::bytes_view{caller.return_data}, (evmone::bytes_view{output, 3}));
+}
+
+TEST(execution_state_pool, get)
+{
+    using evmone::ExecutionStatePool;
+    using evmone::StackSpace;
+
+    ExecutionStatePool pool;
+    EXPECT_EQ(pool.stats().num_states, 0);
+    EXPECT_EQ(pool.stats().stack_arena_size, 0);
+
+    auto& st0 = pool.get(0);
+    EXPECT_EQ(&pool.get(0), &st0);
+    EXPECT_EQ(st0.memory.capacity(), 0);
+    EXPECT_EQ(pool.stats().num_states, 1);
+    EXPECT_EQ(pool.stats().stack_arena_size,
+        ExecutionStatePool::stacks_per_chunk * StackSpace::size);
+
+    // The states up to the requested depth are created.
+    // The stack spaces are consecutive within the chunk.
+    auto& st2 = pool.get(2);
+    EXPECT_EQ(pool.stats().num_states, 3);
+    EXPECT_EQ(st2.stack_space.bottom(), st0.stack_space.bottom() + 2 * StackSpace::limit);
+    EXPECT_EQ(&pool.get(0), &st0);
+    EXPECT_EQ(st0.callee_state, &pool.get(1));
+    EXPECT_EQ(pool.get(1).callee_state, &st2);
+    EXPECT_EQ(st2.callee_state, nullptr);
+
+    pool.get(ExecutionStatePool::stacks_per_chunk);
+    EXPECT_EQ(pool.stats().stack_arena_size,
+        2 * ExecutionStatePool::stacks_per_chunk * StackSpace::size);
+
+    auto& st_max = pool.get(ExecutionStatePool::max_depth);
+    EXPECT_EQ(pool.stats().num_states, ExecutionStatePool::max_depth + 1);
+    EXPECT_EQ(&pool.get(0), &st0);
+    st_max.stack_space.bottom()[StackSpace::limit - 1] = 1;
+}
+
+TEST(execution_state_pool, stats_and_trim)
+{
+    evmone::ExecutionStatePool pool;
+    pool.get(0).memory.grow(32);
+    pool.get(1).memory.grow(64 * 1024);
+    pool.get(2).call_stack.resize(10);
+
+    auto stats = pool.stats();
+    EXPECT_EQ(stats.num_states, 3);
+    EXPECT_EQ(stats.memory_capacity, 4096 + 64 * 1024);
+    EXPECT_EQ(stats.max_memory_capacity, 64 * 1024);
+    EXPECT_GE(stats.max_call_stack_capacity, 10);
+
+    pool.trim(4096);
+    stats = pool.stats();
+    EXPECT_EQ(stats.memory_capacity, 4096);
+    EXPECT_EQ(stats.max_memory_capacity, 4096);
+    EXPECT_EQ(pool.get(0).memory.size(), 32);
+    EXPECT_EQ(pool.get(1).memory.size(), 0);
+}
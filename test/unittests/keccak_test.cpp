@@ -0,0 +1,58 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <evmc/hex.hpp>
+#include <evmone_precompiles/keccak.hpp>
+#include <gtest/gtest.h>
+#include <cstring>
+#include <vector>
+
+using namespace evmc::literals;
+
+namespace
+{
+bool operator==(const ethash::hash256& a, const ethash::hash256& b) noexcept
+{
+    return std::memcmp(a.bytes, b.bytes, sizeof(a)) == 0;
+}
+}  // namespace
+
+TEST(keccak, test_vectors)
+{
+    const auto empty = ethash::keccak256(nullptr, 0);
+    EXPECT_EQ(evmc::hex({empty.bytes, sizeof(empty)}),
+        "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470");
+
+    const auto abc = "616263"_hex;
+    const auto h = ethash::keccak256(abc.data(), abc.size());
+    EXPECT_EQ(evmc::hex({h.bytes, sizeof(h)}),
+        "4e03657aea45a94fc7d47ba826c8d667c0d1e6e33a64a036ec44f58fa12d6c45");
+}
+
+TEST(keccak, batch)
+{
+    // The sizes around the block size (136) and the batch of inputs of different sizes
+    // not being a multiple of the number of inputs processed together.
+    constexpr size_t sizes[] = {0, 1, 20, 32, 64, 135, 136, 137, 271, 272, 273, 1000, 32, 7, 32};
+
+    std::vector<uint8_t> data(2000);
+    for (size_t i = 0; i < data.size(); ++i)
+        data[i] = static_cast<uint8_t>(i * 7 + 1);
+
+    for (size_t n = 0; n <= std::size(sizes); ++n)
+    {
+        std::vector<const uint8_t*> inputs(n);
+        for (size_t i = 0; i < n; ++i)
+            inputs[i] = &data[i * 13];
+
+        std::vector<ethash::hash256> hashes(n);
+        ethash::keccak256_batch(hashes.data(), inputs.data(), sizes, n);
+
+        for (size_t i = 0; i < n; ++i)
+        {
+            EXPECT_TRUE(hashes[i] == ethash::keccak256(inputs[i], sizes[i]))
+                << "n: " << n << ", i: " << i;
+        }
+    }
+}
@@ -7,7 +7,9 @@
 #include <algorithm>
 #include <numeric>
 #include <random>
+#include <thread>
 
+using evmone::ConcurrentLRUCache;
 using evmone::LRUCache;
 
 TEST(lru_cache, capacity1)
@@ -232,3 +234,75 @@ TEST(lru_cache, mass_put_over_capacity)
     for (size_t i = N / 2; i < N; ++i)
         EXPECT_EQ(*c.get(values[i]), values[i]);
 }
+
+TEST(concurrent_lru_cache, put_get)
+{
+    ConcurrentLRUCache<char, int> c(3);
+    EXPECT_EQ(c.get('a'), std::nullopt);
+    c.put('a', 1);
+    c.put('b', 2);
+    EXPECT_EQ(c.get('a'), 1);
+    EXPECT_EQ(c.get('b'), 2);
+    c.put('a', 3);
+    EXPECT_EQ(c.get('a'), 3);
+    c.clear();
+    EXPECT_EQ(c.get('a'), std::nullopt);
+    EXPECT_EQ(c.get('b'), std::nullopt);
+}
+
+TEST(concurrent_lru_cache, capacity_below_num_shards)
+{
+    // Each shard holds at least one entry.
+    ConcurrentLRUCache<int, int> c(1, 16);
+    for (int i = 0; i < 16; ++i)
+    {
+        c.put(i, i);
+        EXPECT_EQ(c.get(i), i);
+    }
+}
+
+TEST(concurrent_lru_cache, single_shard_evict)
+{
+    ConcurrentLRUCache<char, int> c(2, 1);
+    c.put('a', 1);
+    c.put('b', 2);
+    EXPECT_EQ(c.get('a'), 1);
+    c.put('c', 3);
+    EXPECT_EQ(c.get('a'), 1);
+    EXPECT_EQ(c.get('b'), std::nullopt);
+    EXPECT_EQ(c.get('c'), 3);
+}
+
+TEST(concurrent_lru_cache, shared_value_outlives_eviction)
+{
+    ConcurrentLRUCache<int, std::shared_ptr<int>> c(1, 1);
+    c.put(1, std::make_shared<int>(1));
+    const auto v = c.get(1);
+    ASSERT_TRUE(v.has_value());
+    c.put(2, std::make_shared<int>(2));  // Evicts the entry 1.
+    EXPECT_EQ(c.get(1), std::nullopt);
+    EXPECT_EQ(**v, 1);
+}
+
+TEST(concurrent_lru_cache, multithreaded)
+{
+    static constexpr auto N = 10'000;
+    static constexpr auto num_threads = 4;
+
+    ConcurrentLRUCache<int, int> c(N);
+    std::vector<std::thread> threads;
+    for (int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back([&c, t] {
+            for (int i = 0; i < N; ++i)
+            {
+                const auto k = (i * (t + 1)) % N;
+                c.put(k, k);
+                if (const auto v = c.get((k * 7) % N); v.has_value())
+                    EXPECT_EQ(*v, (k * 7) % N);
+            }
+        });
+    }
+    for (auto& thread : threads)
+        thread.join();
+}
@@ -4,6 +4,7 @@
 
 #include <evmc/bytes.hpp>
 #include <evmone_precompiles/bls.hpp>
+#include <evmone_precompiles/parallel.hpp>
 #include <gtest/gtest.h>
 #include <test/utils/utils.hpp>
 #include <array>
@@ -459,3 +460,24 @@ TEST(bls, paring_check_two_pairs_g2_inf)
     EXPECT_TRUE(evmone::crypto::bls::pairing_check(r, input.data(), input.size()));
     EXPECT_EQ(evmc::bytes_view(r, sizeof r), RESULT_ZERO);
 }
+
+TEST(bls, paring_check_parallel)
+{
+    evmone::crypto::set_parallel_pairing(3, 2);
+
+    const auto correct = (G1_1 + G2_1) + (G1_2 + G2_1) + (G1_3 + G2_m1);
+    const auto input = correct + correct + (G1_inf + G2_1) + correct;
+    uint8_t r[32];
+    EXPECT_TRUE(evmone::crypto::bls::pairing_check(r, input.data(), input.size()));
+    EXPECT_EQ(evmc::bytes_view(r, sizeof r), RESULT_ONE);
+
+    const auto incorrect = input + (G1_1 + G2_1);
+    EXPECT_TRUE(evmone::crypto::bls::pairing_check(r, incorrect.data(), incorrect.size()));
+    EXPECT_EQ(evmc::bytes_view(r, sizeof r), RESULT_ZERO);
+
+    auto invalid = input;
+    invalid[invalid.size() - 1] ^= 1;
+    EXPECT_FALSE(evmone::crypto::bls::pairing_check(r, invalid.data(), invalid.size()));
+
+    evmone::crypto::set_parallel_pairing(0);
+}
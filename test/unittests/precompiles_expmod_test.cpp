@@ -127,6 +127,39 @@ TEST(expmod, test_vectors)
     }
 }
 
+TEST(expmod, fermat_little_theorem)
+{
+    // Checks a^(k⋅(p-1)+1) ≡ a (mod p) for prime p. The exponents have various bit widths
+    // to cover all the window sizes of the exponentiation.
+    using namespace intx;
+    using uint1536 = intx::uint<1536>;
+    for (const auto p :
+        {23_u256, 0xfffffffffffffffffffffffffffffffffffffffffffffffffffffffefffffc2f_u256})
+    {
+        const auto base = p - 5;
+        for (const auto k_bits : {0u, 1u, 20u, 60u, 200u, 600u, 1000u})
+        {
+            const auto k = (uint1536{1} << k_bits) - 1;
+            const auto exp = k * (uint1536{p} - 1) + 1;
+
+            evmc::bytes input(3 * 32 + 32 + sizeof(exp) + 32, 0);
+            be::unsafe::store(&input[0], uint256{32});
+            be::unsafe::store(&input[32], uint256{sizeof(exp)});
+            be::unsafe::store(&input[64], uint256{32});
+            be::unsafe::store(&input[96], base);
+            be::unsafe::store(&input[128], exp);
+            be::unsafe::store(&input[128 + sizeof(exp)], p);
+
+            uint8_t result[32]{};
+            const auto [status, output_size] = evmone::state::expmod_execute(
+                input.data(), input.size(), result, std::size(result));
+            EXPECT_EQ(status, EVMC_SUCCESS);
+            EXPECT_EQ(output_size, std::size(result));
+            EXPECT_EQ(be::unsafe::load<uint256>(result), base) << k_bits;
+        }
+    }
+}
+
 TEST(expmod, analysis_oog)
 {
     // Tests the gas cost calculation of the expmod precompile.
@@ -5,8 +5,10 @@
 #include <evmc/hex.hpp>
 #include <evmone_precompiles/sha256.hpp>
 #include <gtest/gtest.h>
+#include <vector>
 
 using evmone::crypto::sha256;
+using evmone::crypto::SHA256_HASH_SIZE;
 
 TEST(sha256, test_vectors)
 {
@@ -30,3 +32,63 @@ TEST(sha256, test_vectors)
         EXPECT_EQ(hash_hex, expected_hash_hex);
     }
 }
+
+namespace
+{
+/// The known SHA256 hashes of the inputs of repeated 'a' of the sizes around the chunk size (64)
+/// and the padding boundary (56).
+const std::pair<size_t, std::string_view> batch_test_cases[] = {
+    {0, "e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855"},
+    {55, "9f4390f8d30c2dd92ec9f095b65e2b9ae9b0a925a5258e241c9f1e910f734318"},
+    {56, "b35439a4ac6f0948b6d6f9e3c6af0f5f590ce20f1bde7090ef7970686ec6738a"},
+    {63, "7d3e74a05d7db15bce4ad9ec0658ea98e3f06eeecf16b4c6fff2da457ddc2f34"},
+    {64, "ffe054fe7ae0cb6dc65c3af9b61d5209f439851db43d0ba5997337df154668eb"},
+    {65, "635361c48bb9eab14198e76ea8ab7f1a41685d6ad62aa9146d301d4f17eb0ae0"},
+    {119, "31eba51c313a5c08226adf18d4a359cfdfd8d2e816b13f4af952f7ea6584dcfb"},
+    {120, "2f3d335432c70b580af0e8e1b3674a7c020d683aa5f73aaaedfdc55af904c21c"},
+    {128, "6836cf13bac400e9105071cd6af47084dfacad4e5e302c94bfed24e013afb73e"},
+    {1000, "41edece42d63e8d9bf515a9ba6932e1c20cbc9f5a5d134645adb5db1b9737ea3"},
+};
+
+using BatchFn = void (*)(std::byte*, const std::byte* const[], const size_t[], size_t);
+
+/// Checks the batch function for the first n batch test cases.
+void check_batch(BatchFn batch_fn, size_t n)
+{
+    const std::vector<std::byte> data(1000, std::byte{'a'});
+    std::vector<const std::byte*> inputs(n, data.data());
+    std::vector<size_t> sizes(n);
+    for (size_t i = 0; i < n; ++i)
+        sizes[i] = batch_test_cases[i].first;
+
+    std::vector<std::byte> hashes(n * SHA256_HASH_SIZE);
+    batch_fn(hashes.data(), inputs.data(), sizes.data(), n);
+
+    for (size_t i = 0; i < n; ++i)
+    {
+        const auto hash = reinterpret_cast<const uint8_t*>(&hashes[i * SHA256_HASH_SIZE]);
+        const auto hash_hex = evmc::hex({hash, SHA256_HASH_SIZE});
+        EXPECT_EQ(hash_hex, batch_test_cases[i].second) << "n: " << n << ", i: " << i;
+    }
+}
+}  // namespace
+
+TEST(sha256, batch)
+{
+    // All the batch sizes: including the ones not being a multiple of the number of inputs
+    // hashed together.
+    for (size_t n = 0; n <= std::size(batch_test_cases); ++n)
+        check_batch(evmone::crypto::sha256_batch, n);
+}
+
+#if defined(__x86_64__)
+TEST(sha256, avx2_lanes)
+{
+    // The AVX2 implementation is not used by sha256_batch() on CPUs with the SHA extensions.
+    if (!__builtin_cpu_supports("avx2"))
+        GTEST_SKIP() << "AVX2 not supported";
+
+    for (size_t n = 1; n <= evmone::crypto::SHA256_AVX2_LANES; ++n)
+        check_batch(evmone::crypto::sha_256_x86_avx2_lanes, n);
+}
+#endif
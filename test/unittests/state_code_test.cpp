@@ -0,0 +1,105 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/state/code.hpp>
+#include <test/state/hash_utils.hpp>
+#include <test/state/test_state.hpp>
+#include <test/utils/utils.hpp>
+
+using namespace evmone;
+using namespace evmone::state;
+
+TEST(state_code, empty)
+{
+    const Code code;
+    EXPECT_TRUE(code.empty());
+    EXPECT_EQ(code.size(), 0);
+    EXPECT_EQ(code.hash(), keccak256({}));
+    EXPECT_FALSE(code.is_eof());
+    EXPECT_FALSE(code.delegate().has_value());
+    EXPECT_EQ(Code{bytes{}}, code);
+    EXPECT_TRUE(Code::find(keccak256({})).has_value());
+}
+
+TEST(state_code, shared)
+{
+    const auto bytecode = "6001600055"_hex;
+    const auto hash = keccak256(bytecode);
+
+    const Code a{bytecode};
+    EXPECT_EQ(a, bytecode);
+    EXPECT_EQ(a.hash(), hash);
+    EXPECT_FALSE(a.is_eof());
+
+    // The same code is stored once.
+    const Code b{bytecode, hash};
+    EXPECT_EQ(b, a);
+    EXPECT_EQ(b.data(), a.data());
+    const auto found = Code::find(hash);
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->data(), a.data());
+
+    const Code c{"6002600055"_hex};
+    EXPECT_NE(c, a);
+}
+
+TEST(state_code, released)
+{
+    const auto bytecode = "60016001"_hex;
+    {
+        const Code code{bytecode};
+        EXPECT_TRUE(Code::find(code.hash()).has_value());
+    }
+    // The code is not held by any handle anymore.
+    EXPECT_FALSE(Code::find(keccak256(bytecode)).has_value());
+}
+
+TEST(state_code, metadata)
+{
+    const Code eof{"EF0001010004020001000304000000008000000000"_hex};
+    EXPECT_TRUE(eof.is_eof());
+    EXPECT_FALSE(eof.delegate().has_value());
+
+    const Code delegated{"EF01000000000000000000000000000000000000000042"_hex};
+    EXPECT_FALSE(delegated.is_eof());
+    EXPECT_EQ(delegated.delegate(), 0x42_address);
+
+    // Invalid delegation designator (too short).
+    const Code invalid{"EF0100000000000000000000000000000000000000"_hex};
+    EXPECT_FALSE(invalid.delegate().has_value());
+}
+
+TEST(state_code, test_state_cache)
+{
+    const auto bytecode = "60036003"_hex;
+    test::TestState state{{0x01_address, {.code = bytecode}}, {0x02_address, {}}};
+
+    // The code loaded from the TestState stays interned.
+    const auto code_ptr = state.get_account_code(0x01_address).data();
+    const auto found = Code::find(keccak256(bytecode));
+    ASSERT_TRUE(found.has_value());
+    EXPECT_EQ(found->data(), code_ptr);
+    EXPECT_EQ(state.get_account_code(0x01_address).data(), code_ptr);
+    EXPECT_EQ(state.get_account(0x01_address)->code_hash, keccak256(bytecode));
+
+    EXPECT_TRUE(state.get_account_code(0x02_address).empty());
+    EXPECT_EQ(state.get_account(0x02_address)->code_hash, keccak256({}));
+
+    // The account modified directly gets the new code.
+    state[0x01_address].code = "60046004"_hex;
+    EXPECT_EQ(state.get_account_code(0x01_address), "60046004"_hex);
+    EXPECT_EQ(state.get_account(0x01_address)->code_hash, keccak256("60046004"_hex));
+
+    // The copy of the state shares the cached codes.
+    auto copy = state;
+    EXPECT_EQ(copy.get_account_code(0x01_address).data(),
+        state.get_account_code(0x01_address).data());
+
+    // The copies diverging after the modification keep their own codes.
+    copy[0x01_address].code = bytecode;
+    EXPECT_EQ(copy.get_account_code(0x01_address), bytecode);
+    EXPECT_EQ(state.get_account_code(0x01_address), "60046004"_hex);
+    EXPECT_EQ(copy.get_account_code(0x01_address), bytecode);
+}
@@ -0,0 +1,146 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <evmc/evmc.hpp>
+#include <gtest/gtest.h>
+#include <test/state/flat_hash_map.hpp>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace evmc::literals;
+using evmc::address;
+using evmc::bytes32;
+using evmone::state::FlatHashMap;
+
+TEST(state_flat_hash_map, empty)
+{
+    const FlatHashMap<bytes32, int> m;
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.size(), 0);
+    EXPECT_EQ(m.capacity(), 0);
+    EXPECT_EQ(m.begin(), m.end());
+    EXPECT_EQ(m.find(0x01_bytes32), m.end());
+    EXPECT_FALSE(m.contains(0x01_bytes32));
+    EXPECT_THROW((void)m.at(0x01_bytes32), std::out_of_range);
+}
+
+TEST(state_flat_hash_map, insert_find_erase)
+{
+    FlatHashMap<address, std::string> m;
+    const auto [it, inserted] = m.try_emplace(0x01_address, "a");
+    EXPECT_TRUE(inserted);
+    EXPECT_EQ(it->first, 0x01_address);
+    EXPECT_EQ(it->second, "a");
+
+    EXPECT_FALSE(m.try_emplace(0x01_address, "b").second);
+    EXPECT_EQ(m.at(0x01_address), "a");
+    m.insert_or_assign(0x01_address, "c");
+    EXPECT_EQ(m.at(0x01_address), "c");
+    m[0x02_address] = "d";
+    EXPECT_EQ(m.size(), 2);
+    EXPECT_EQ(m.count(0x02_address), 1);
+
+    EXPECT_EQ(m.erase(0x01_address), 1);
+    EXPECT_EQ(m.erase(0x01_address), 0);
+    EXPECT_EQ(m.find(0x01_address), m.end());
+    EXPECT_EQ(m.size(), 1);
+    EXPECT_EQ(m.begin()->second, "d");
+}
+
+TEST(state_flat_hash_map, clear_keeps_capacity)
+{
+    FlatHashMap<bytes32, std::shared_ptr<int>> m;
+    const auto value = std::make_shared<int>(1);
+    for (uint64_t i = 0; i < 100; ++i)
+        m[bytes32{i}] = value;
+    EXPECT_EQ(value.use_count(), 101);
+
+    const auto capacity = m.capacity();
+    m.clear();
+    EXPECT_TRUE(m.empty());
+    EXPECT_EQ(m.capacity(), capacity);
+    EXPECT_EQ(value.use_count(), 1);  // The values are destroyed.
+    EXPECT_FALSE(m.contains(bytes32{1}));
+    EXPECT_EQ(m.begin(), m.end());
+}
+
+TEST(state_flat_hash_map, copy_move_compare)
+{
+    FlatHashMap<bytes32, int> a;
+    for (uint64_t i = 0; i < 50; ++i)
+        a[bytes32{i}] = static_cast<int>(i);
+
+    auto b = a;
+    EXPECT_EQ(b, a);
+    b[bytes32{1}] = -1;
+    EXPECT_NE(b, a);
+    b[bytes32{1}] = 1;
+    EXPECT_EQ(b, a);
+    b.erase(bytes32{2});
+    EXPECT_NE(b, a);
+
+    const auto c = std::move(b);
+    EXPECT_TRUE(b.empty());  // NOLINT(bugprone-use-after-move)
+    EXPECT_EQ(c.size(), 49);
+    EXPECT_EQ(c.at(bytes32{49}), 49);
+}
+
+TEST(state_flat_hash_map, tombstones_reuse)
+{
+    // Insert and erase many different keys while keeping the map small.
+    // The capacity must not grow because of the deleted entries.
+    FlatHashMap<bytes32, uint64_t> m;
+    for (uint64_t i = 0; i < 10; ++i)
+        m[bytes32{i}] = i;
+    const auto capacity = m.capacity();
+    for (uint64_t i = 10; i < 10'000; ++i)
+    {
+        m[bytes32{i}] = i;
+        m.erase(bytes32{i - 10});
+    }
+    EXPECT_EQ(m.size(), 10);
+    EXPECT_EQ(m.capacity(), capacity);
+    for (uint64_t i = 9'990; i < 10'000; ++i)
+        EXPECT_EQ(m.at(bytes32{i}), i);
+}
+
+TEST(state_flat_hash_map, random_vs_unordered_map)
+{
+    std::mt19937_64 rng{1};
+    FlatHashMap<bytes32, uint64_t> m;
+    std::unordered_map<bytes32, uint64_t> expected;
+    for (int i = 0; i < 100'000; ++i)
+    {
+        const auto key = bytes32{rng() % 2'000};
+        switch (rng() % 4)
+        {
+        case 0:
+        case 1:
+            m[key] = expected[key] = rng();
+            break;
+        case 2:
+            EXPECT_EQ(m.erase(key), expected.erase(key));
+            break;
+        default:
+            if (rng() % 1'000 == 0)
+            {
+                m.clear();
+                expected.clear();
+            }
+            EXPECT_EQ(m.contains(key), expected.contains(key));
+            break;
+        }
+        ASSERT_EQ(m.size(), expected.size());
+    }
+
+    size_t n = 0;
+    for (const auto& [k, v] : m)
+    {
+        EXPECT_EQ(expected.at(k), v);
+        ++n;
+    }
+    EXPECT_EQ(n, expected.size());
+}
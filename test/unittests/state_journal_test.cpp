@@ -0,0 +1,87 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <evmc/evmc.hpp>
+#include <gtest/gtest.h>
+#include <test/state/journal.hpp>
+#include <string>
+#include <vector>
+
+using namespace evmc::literals;
+using evmone::state::Journal;
+
+namespace
+{
+struct Small
+{
+    uint8_t value;
+};
+
+struct Large
+{
+    evmc::address addr;
+    evmc::bytes32 key;
+};
+
+/// Records the rolled back entries as strings.
+struct Recorder
+{
+    std::vector<std::string> entries;
+
+    void operator()(const Small& e) { entries.emplace_back("S" + std::to_string(e.value)); }
+    void operator()(const Large& e)
+    {
+        entries.emplace_back("L" + std::to_string(e.addr.bytes[19]) + ":" +
+                             std::to_string(e.key.bytes[31]));
+    }
+};
+}  // namespace
+
+TEST(state_journal, empty)
+{
+    Journal<Small, Large> j;
+    EXPECT_TRUE(j.empty());
+    EXPECT_EQ(j.checkpoint(), 0);
+    Recorder r;
+    j.rollback(0, r);
+    EXPECT_TRUE(r.entries.empty());
+}
+
+TEST(state_journal, entry_sizes)
+{
+    Journal<Small, Large> j;
+    j.push(Small{1});
+    EXPECT_EQ(j.size_bytes(), sizeof(Small) + 1);
+    j.push(Large{});
+    EXPECT_EQ(j.size_bytes(), sizeof(Small) + sizeof(Large) + 2);
+}
+
+TEST(state_journal, rollback_in_reverse_order)
+{
+    Journal<Small, Large> j;
+    j.push(Small{1});
+    const auto cp1 = j.checkpoint();
+    j.push(Large{0x02_address, 0x03_bytes32});
+    j.push(Small{4});
+    const auto cp2 = j.checkpoint();
+    j.push(Small{5});
+    j.push(Large{0x06_address, 0x07_bytes32});
+
+    Recorder r;
+    j.rollback(cp2, r);
+    EXPECT_EQ(r.entries, (std::vector<std::string>{"L6:7", "S5"}));
+    EXPECT_EQ(j.checkpoint(), cp2);
+
+    // The journal can be extended after the rollback.
+    j.push(Small{8});
+    r.entries.clear();
+    j.rollback(cp1, r);
+    EXPECT_EQ(r.entries, (std::vector<std::string>{"S8", "S4", "L2:3"}));
+    EXPECT_EQ(j.checkpoint(), cp1);
+
+    r.entries.clear();
+    j.rollback(0, r);
+    EXPECT_EQ(r.entries, (std::vector<std::string>{"S1"}));
+    EXPECT_TRUE(j.empty());
+}
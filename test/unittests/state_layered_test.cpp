@@ -0,0 +1,205 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include <gtest/gtest.h>
+#include <test/state/layered_state.hpp>
+#include <test/state/mpt_hash.hpp>
+#include <test/state/state_diff.hpp>
+#include <test/utils/utils.hpp>
+
+using namespace evmone;
+using namespace evmone::state;
+using namespace evmone::test;
+
+namespace
+{
+/// Checks that the layered state reports the same accounts as the expected TestState.
+void expect_same_state(const LayeredState& layered, const TestState& expected)
+{
+    EXPECT_EQ(layered.to_test_state(), expected);
+    EXPECT_EQ(layered.flatten().to_test_state(), expected);
+    for (const auto& [addr, acc] : expected)
+    {
+        const auto layered_acc = layered.get_account(addr);
+        const auto expected_acc = expected.get_account(addr);
+        ASSERT_TRUE(layered_acc.has_value());
+        EXPECT_EQ(layered_acc->nonce, expected_acc->nonce);
+        EXPECT_EQ(layered_acc->balance, expected_acc->balance);
+        EXPECT_EQ(layered_acc->code_hash, expected_acc->code_hash);
+        EXPECT_EQ(layered_acc->has_storage, expected_acc->has_storage);
+        EXPECT_EQ(layered.get_account_code(addr), acc.code);
+        for (const auto& [key, value] : acc.storage)
+            EXPECT_EQ(layered.get_storage(addr, key), value);
+    }
+}
+}  // namespace
+
+TEST(state_layered, reads_base)
+{
+    const auto base = std::make_shared<const TestState>(TestState{
+        {0x01_address, {.nonce = 1, .balance = 2, .storage = {{0x01_bytes32, 0x02_bytes32}}}},
+        {0x02_address, {.code = "00"_hex}},
+    });
+    const LayeredState layer{base};
+    EXPECT_EQ(layer.depth(), 1u);
+    expect_same_state(layer, *base);
+    EXPECT_FALSE(layer.get_account(0x03_address).has_value());
+    EXPECT_EQ(layer.get_storage(0x01_address, 0x02_bytes32), bytes32{});
+}
+
+TEST(state_layered, modify_and_delete)
+{
+    const auto base = std::make_shared<const TestState>(TestState{
+        {0x01_address, {.nonce = 1, .storage = {{0x01_bytes32, 0x01_bytes32}}}},
+        {0x02_address, {.balance = 1, .code = "00"_hex}},
+    });
+    const auto parent = std::make_shared<LayeredState>(base);
+    auto expected = *base;
+
+    const StateDiff diff1{
+        .modified_accounts = {{.addr = 0x01_address,
+                                  .nonce = 2,
+                                  .balance = 3,
+                                  .modified_storage = {{0x01_bytes32, bytes32{}},
+                                      {0x02_bytes32, 0x02_bytes32}}},
+            {.addr = 0x03_address, .nonce = 1, .balance = 0, .code = "fe"_hex}},
+        .deleted_accounts = {0x02_address},
+    };
+    parent->apply(diff1);
+    expected.apply(diff1);
+    expect_same_state(*parent, expected);
+    EXPECT_FALSE(parent->get_account(0x02_address).has_value());
+    EXPECT_EQ(parent->get_account_code(0x02_address), bytes{});
+
+    // Re-create the deleted account in a child layer: the base code must not be visible.
+    LayeredState child{parent};
+    EXPECT_EQ(child.depth(), 2u);
+    const StateDiff diff2{
+        .modified_accounts = {{.addr = 0x02_address, .nonce = 0, .balance = 5},
+            {.addr = 0x01_address,
+                .nonce = 2,
+                .balance = 3,
+                .modified_storage = {{0x02_bytes32, bytes32{}}}}},
+    };
+    child.apply(diff2);
+    expected.apply(diff2);
+    expect_same_state(child, expected);
+    EXPECT_EQ(child.get_account_code(0x02_address), bytes{});
+    EXPECT_FALSE(child.get_account(0x01_address)->has_storage);
+
+    // The parent layer is not affected.
+    EXPECT_EQ(parent->get_storage(0x01_address, 0x02_bytes32), 0x02_bytes32);
+    EXPECT_FALSE(parent->get_account(0x02_address).has_value());
+}
+
+TEST(state_layered, delete_and_recreate_in_same_layer)
+{
+    const auto base = std::make_shared<const TestState>(TestState{
+        {0x01_address, {.storage = {{0x01_bytes32, 0x01_bytes32}}, .code = "00"_hex}},
+    });
+    LayeredState layer{base};
+    auto expected = *base;
+
+    const StateDiff diff1{.deleted_accounts = {0x01_address}};
+    const StateDiff diff2{.modified_accounts = {{.addr = 0x01_address,
+                              .nonce = 1,
+                              .balance = 1,
+                              .modified_storage = {{0x02_bytes32, 0x02_bytes32}}}}};
+    for (const auto* diff : {&diff1, &diff2})
+    {
+        layer.apply(*diff);
+        expected.apply(*diff);
+        expect_same_state(layer, expected);
+    }
+    EXPECT_EQ(layer.get_storage(0x01_address, 0x01_bytes32), bytes32{});
+    EXPECT_EQ(layer.get_account_code(0x01_address), bytes{});
+}
+
+TEST(state_layered, sibling_layers)
+{
+    const auto base = std::make_shared<const TestState>(TestState{{0x01_address, {.balance = 1}}});
+    const auto parent = std::make_shared<const LayeredState>(base);
+
+    LayeredState a{parent};
+    LayeredState b{parent};
+    a.apply({.modified_accounts = {{.addr = 0x01_address, .nonce = 0, .balance = 2}}});
+    b.apply({.deleted_accounts = {0x01_address}});
+
+    EXPECT_EQ(a.get_account(0x01_address)->balance, 2);
+    EXPECT_FALSE(b.get_account(0x01_address).has_value());
+    EXPECT_EQ(parent->get_account(0x01_address)->balance, 1);
+}
+
+TEST(state_layered, flatten_long_chain)
+{
+    const auto base = std::make_shared<const TestState>(TestState{
+        {0x01_address, {.storage = {{0x01_bytes32, 0x01_bytes32}}}},
+    });
+    auto expected = *base;
+    auto layer = std::make_shared<const LayeredState>(base);
+
+    for (uint64_t i = 1; i <= 3 * LayeredState::MAX_DEPTH; ++i)
+    {
+        auto child = std::make_shared<LayeredState>(layer);
+        EXPECT_LE(child->depth(), LayeredState::MAX_DEPTH + 1);
+
+        const auto addr = address{i % 5};
+        const auto key = bytes32{i % 3};
+        const auto value = bytes32{i % 4};  // Zero every 4th time.
+
+        StateDiff diff;
+        if (i % 7 == 0)
+            diff.deleted_accounts.emplace_back(addr);
+        else
+            diff.modified_accounts.push_back(
+                {.addr = addr, .nonce = i, .balance = i, .modified_storage = {{key, value}}});
+        child->apply(diff);
+        expected.apply(diff);
+        layer = std::move(child);
+    }
+    expect_same_state(*layer, expected);
+}
+
+TEST(state_layered, diff)
+{
+    const auto base = std::make_shared<const TestState>(TestState{
+        {0x01_address, {.nonce = 1, .storage = {{0x01_bytes32, 0x01_bytes32}}}},
+        {0x02_address, {.storage = {{0x01_bytes32, 0x01_bytes32}}, .code = "00"_hex}},
+        {0x03_address, {.balance = 1}},
+    });
+    const auto parent = std::make_shared<const LayeredState>(base);
+    LayeredState layer{parent};
+
+    // Modify, delete and re-create, create and clear the storage, delete.
+    const StateDiff diff1{
+        .modified_accounts = {{.addr = 0x01_address,
+                                  .nonce = 2,
+                                  .balance = 0,
+                                  .modified_storage = {{0x01_bytes32, bytes32{}},
+                                      {0x02_bytes32, 0x02_bytes32}}},
+            {.addr = 0x04_address,
+                .nonce = 1,
+                .balance = 0,
+                .modified_storage = {{0x01_bytes32, 0x01_bytes32}}}},
+        .deleted_accounts = {0x02_address, 0x03_address},
+    };
+    const StateDiff diff2{
+        .modified_accounts = {{.addr = 0x02_address, .nonce = 1, .balance = 1},
+            {.addr = 0x04_address,
+                .nonce = 1,
+                .balance = 0,
+                .modified_storage = {{0x01_bytes32, bytes32{}}}}},
+    };
+    layer.apply(diff1);
+    layer.apply(diff2);
+
+    const auto diff = layer.diff();
+    auto state = *base;
+    state.apply(diff);
+    EXPECT_EQ(state, layer.to_test_state());
+
+    StateTrie trie{*base};
+    trie.apply(diff);
+    EXPECT_EQ(trie.hash(), mpt_hash(state));
+}
@@ -62,6 +62,48 @@ TEST(state_mpt_hash, deleted_storage)
         0x4e7338c16731491e0fb5d1623f5265c17699c970c816bab71d4d717f6071414d_bytes32);
 }
 
+TEST(state_mpt_hash, state_trie)
+{
+    TestState state;
+    state[0x01_address] = {.nonce = 1, .balance = 2};
+    state[0x01_address].storage[0x01_bytes32] = 0x11_bytes32;
+    state[0x01_address].storage[0x02_bytes32] = 0x22_bytes32;
+    state[0x02_address] = {.balance = 3, .code = bytes{0x00}};
+    state[0x03_address] = {.nonce = 5};
+
+    StateTrie trie{state};
+    EXPECT_EQ(trie.hash(), mpt_hash(state));
+
+    StateDiff diff1;
+    diff1.modified_accounts.push_back({.addr = 0x01_address,
+        .nonce = 2,
+        .balance = 2,
+        .modified_storage = {{0x01_bytes32, {}}, {0x03_bytes32, 0x33_bytes32}}});
+    diff1.modified_accounts.push_back(
+        {.addr = 0x04_address, .nonce = 1, .balance = 7, .code = bytes{0xfe}});
+    diff1.deleted_accounts.push_back(0x03_address);
+    state.apply(diff1);
+    trie.apply(diff1);
+    EXPECT_EQ(trie.hash(), mpt_hash(state));
+
+    // Apply multiple diffs before computing the hash.
+    StateDiff diff2;
+    diff2.modified_accounts.push_back({.addr = 0x03_address, .nonce = 1, .balance = 0});
+    diff2.modified_accounts.push_back({.addr = 0x01_address,
+        .nonce = 2,
+        .balance = 2,
+        .modified_storage = {{0x02_bytes32, {}}, {0x03_bytes32, {}}}});
+    StateDiff diff3;
+    diff3.modified_accounts.push_back({.addr = 0x02_address, .nonce = 0, .balance = 4});
+    diff3.deleted_accounts.push_back(0x04_address);
+    for (const auto* diff : {&diff2, &diff3})
+    {
+        state.apply(*diff);
+        trie.apply(*diff);
+    }
+    EXPECT_EQ(trie.hash(), mpt_hash(state));
+}
+
 TEST(state_mpt_hash, one_transactions)
 {
     // https://sepolia.etherscan.io/tx/0xd4070618ed3026722ae5dbacc95e70714327d65abce292bba9de38201895cdff
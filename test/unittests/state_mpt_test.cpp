@@ -245,6 +245,29 @@ TEST(state_mpt, long_list_random)
     EXPECT_EQ(trie.hash(), LONG_LIST_HASH);
 }
 
+TEST(state_mpt, long_list_update_and_erase)
+{
+    // Modify the trie having the node hashes cached and compare with the trie built from scratch.
+    MPT trie;
+    for (uint64_t key = 0; key < LONG_LIST_SIZE; ++key)
+        trie.insert(rlp::encode(key), {});
+    EXPECT_EQ(trie.hash(), LONG_LIST_HASH);
+
+    MPT expected;
+    for (uint64_t key = 0; key < LONG_LIST_SIZE; key += 2)
+    {
+        trie.erase(rlp::encode(key + 1));
+        trie.insert(rlp::encode(key), rlp::encode(key));
+        expected.insert(rlp::encode(key), rlp::encode(key));
+    }
+    EXPECT_EQ(trie.hash(), expected.hash());
+
+    // Erase all keys, including the ones already erased.
+    for (uint64_t key = 0; key < LONG_LIST_SIZE; ++key)
+        trie.erase(rlp::encode(key));
+    EXPECT_EQ(trie.hash(), EMPTY_MPT_HASH);
+}
+
 TEST(state_mpt, trie_topologies)
 {
     struct KVH
@@ -434,6 +457,7 @@ TEST(state_mpt, trie_topologies)
     for (const auto& test : tests)
     {
         // Insert in order and check hash at every step.
+        // Then erase in reverse order and check the hash gets back to the previous steps.
         {
             MPT trie;
             for (const auto& kv : test)
@@ -441,6 +465,13 @@ TEST(state_mpt, trie_topologies)
                 trie.insert(from_hex(kv.key_hex).value(), to_bytes(kv.value));
                 EXPECT_EQ(hex(trie.hash()), kv.hash_hex);
             }
+            for (size_t i = test.size(); i-- > 1;)
+            {
+                trie.erase(from_hex(test[i].key_hex).value());
+                EXPECT_EQ(hex(trie.hash()), test[i - 1].hash_hex);
+            }
+            trie.erase(from_hex(test[0].key_hex).value());
+            EXPECT_EQ(trie.hash(), EMPTY_MPT_HASH);
         }
 
         // Check if all insert order permutations give the same final hash.
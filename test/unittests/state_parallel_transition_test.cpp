@@ -0,0 +1,138 @@
+// evmone: Fast Ethereum Virtual Machine implementation
+// Copyright 2025 The evmone Authors.
+// SPDX-License-Identifier: Apache-2.0
+
+#include "../utils/bytecode.hpp"
+#include <evmone/evmone.h>
+#include <gtest/gtest.h>
+#include <test/state/parallel_transition.hpp>
+#include <test/state/state.hpp>
+#include <test/state/test_state.hpp>
+#include <algorithm>
+#include <array>
+
+using namespace evmc::literals;
+using namespace evmone;
+using namespace evmone::state;
+using namespace evmone::test;
+
+namespace
+{
+using TransactionResult = std::variant<TransactionReceipt, std::error_code>;
+
+constexpr auto Coinbase = 0xc014bace_address;
+
+/// Increments the counter in the storage slot 0.
+constexpr auto Counter = 0xc0de01_address;
+
+/// Stores the coinbase balance in the storage slot 0.
+constexpr auto CoinbaseReader = 0xc0de02_address;
+
+void expect_same_results(
+    const std::vector<TransactionResult>& expected, const std::vector<TransactionResult>& actual)
+{
+    ASSERT_EQ(actual.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); ++i)
+    {
+        SCOPED_TRACE(i);
+        ASSERT_EQ(actual[i].index(), expected[i].index());
+        if (const auto* err = std::get_if<std::error_code>(&expected[i]))
+        {
+            EXPECT_EQ(std::get<std::error_code>(actual[i]), *err);
+            continue;
+        }
+
+        const auto& e = std::get<TransactionReceipt>(expected[i]);
+        const auto& a = std::get<TransactionReceipt>(actual[i]);
+        EXPECT_EQ(a.status, e.status);
+        EXPECT_EQ(a.gas_used, e.gas_used);
+        EXPECT_EQ(a.logs.size(), e.logs.size());
+        EXPECT_EQ(a.state_diff.deleted_accounts, e.state_diff.deleted_accounts);
+        ASSERT_EQ(a.state_diff.modified_accounts.size(), e.state_diff.modified_accounts.size());
+        for (size_t j = 0; j < e.state_diff.modified_accounts.size(); ++j)
+        {
+            const auto& em = e.state_diff.modified_accounts[j];
+            const auto& am = a.state_diff.modified_accounts[j];
+            EXPECT_EQ(am.addr, em.addr);
+            EXPECT_EQ(am.nonce, em.nonce);
+            EXPECT_EQ(am.balance, em.balance);
+            EXPECT_EQ(am.code, em.code);
+            EXPECT_EQ(am.modified_storage, em.modified_storage);
+        }
+    }
+}
+}  // namespace
+
+TEST(state_parallel_transition, same_as_sequential)
+{
+    constexpr auto rev = EVMC_SHANGHAI;
+    const BlockInfo block{
+        .number = 1, .gas_limit = 700'000, .coinbase = Coinbase, .base_fee = 7};
+    const TestBlockHashes block_hashes;
+    const std::array senders{0x5e01_address, 0x5e02_address, 0x5e03_address, 0x5e04_address};
+
+    TestState pre{
+        {Coinbase, {.balance = 1}},
+        {Counter, {.code = sstore(0, add(sload(0), 1))}},
+        {CoinbaseReader, {.code = sstore(0, bytecode{OP_COINBASE} + OP_BALANCE)}},
+    };
+    for (const auto& sender : senders)
+        pre[sender] = {.balance = 1'000'000'000'000};
+
+    // The mix of independent transfers, the transactions of the same senders,
+    // the counter increments and the coinbase balance reads. The last transactions exceed
+    // the block gas limit.
+    std::vector<Transaction> txs;
+    std::array<uint64_t, senders.size()> nonces{};
+    for (uint64_t i = 0; i < 40; ++i)
+    {
+        const auto s = i % senders.size();
+        auto& tx = txs.emplace_back(Transaction{
+            .type = Transaction::Type::eip1559,
+            .gas_limit = 100'000,
+            .max_gas_price = 10,
+            .max_priority_gas_price = 1 + i % 2,
+            .sender = senders[s],
+            .to = address{0x1000 + i},
+            .value = 1,
+            .nonce = nonces[s]++,
+        });
+        if (i % 3 == 1)
+            tx.to = Counter;
+        else if (i % 8 == 5)
+            tx.to = CoinbaseReader;
+        if (i == 13)
+        {
+            tx.nonce = 1000;  // Invalid nonce.
+            --nonces[s];
+        }
+    }
+
+    evmc::VM vm{evmc_create_evmone()};
+    auto expected_state = pre;
+    const auto expected = transition_parallel(expected_state, block, block_hashes, txs, rev,
+        {&vm, 1}, block.gas_limit, 0);
+
+    for (const size_t num_threads : {2, 3, 8})
+    {
+        SCOPED_TRACE(num_threads);
+        std::vector<evmc::VM> vms;
+        for (size_t i = 0; i < num_threads; ++i)
+            vms.emplace_back(evmc_create_evmone());
+
+        auto state = pre;
+        const auto results =
+            transition_parallel(state, block, block_hashes, txs, rev, vms, block.gas_limit, 0);
+        expect_same_results(expected, results);
+        EXPECT_EQ(state, expected_state);
+    }
+
+    // Check the test covers the interesting cases.
+    EXPECT_TRUE(std::holds_alternative<std::error_code>(expected[13]));
+    EXPECT_TRUE(std::holds_alternative<std::error_code>(expected.back()));
+    EXPECT_TRUE(std::ranges::any_of(expected, [](const auto& res) {
+        const auto* receipt = std::get_if<TransactionReceipt>(&res);
+        return receipt != nullptr && receipt->coinbase_balance_read;
+    }));
+    EXPECT_FALSE(expected_state[Counter].storage.empty());
+}
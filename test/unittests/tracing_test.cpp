@@ -155,6 +155,80 @@ PUSH1,2
 )");
 }
 
+TEST_F(tracing, histogram_ngrams)
+{
+    vm.add_tracer(evmone::create_histogram_tracer(trace_stream, 3));
+
+    trace_stream << '\n';
+    EXPECT_EQ(trace(add(0, 0)), R"(
+--- # HISTOGRAM depth=0
+opcode,count
+ADD,1
+PUSH1,2
+--- # NGRAMS depth=0
+ngram,count
+PUSH1 ADD,1
+PUSH1 PUSH1,1
+PUSH1 PUSH1 ADD,1
+)");
+}
+
+TEST_F(tracing, histogram_ngrams_jump)
+{
+    vm.add_tracer(evmone::create_histogram_tracer(trace_stream, 2));
+
+    // The jump breaks the sequence: JUMP JUMPDEST is not an n-gram.
+    trace_stream << '\n';
+    EXPECT_EQ(trace(jump(4) + OP_INVALID + OP_JUMPDEST), R"(
+--- # HISTOGRAM depth=0
+opcode,count
+JUMP,1
+JUMPDEST,1
+PUSH1,1
+--- # NGRAMS depth=0
+ngram,count
+PUSH1 JUMP,1
+)");
+}
+
+TEST_F(tracing, histogram_ngrams_jump_to_next)
+{
+    vm.add_tracer(evmone::create_histogram_tracer(trace_stream, 2));
+
+    // The jump to the next instruction also breaks the sequence.
+    trace_stream << '\n';
+    EXPECT_EQ(trace(jump(3) + OP_JUMPDEST), R"(
+--- # HISTOGRAM depth=0
+opcode,count
+JUMP,1
+JUMPDEST,1
+PUSH1,1
+--- # NGRAMS depth=0
+ngram,count
+PUSH1 JUMP,1
+)");
+}
+
+TEST_F(tracing, histogram_ngrams_jumpi_not_taken)
+{
+    vm.add_tracer(evmone::create_histogram_tracer(trace_stream, 2));
+
+    // The not taken JUMPI continues the sequence.
+    trace_stream << '\n';
+    EXPECT_EQ(trace(jumpi(5, 0) + OP_JUMPDEST), R"(
+--- # HISTOGRAM depth=0
+opcode,count
+JUMPI,1
+JUMPDEST,1
+PUSH1,2
+--- # NGRAMS depth=0
+ngram,count
+JUMPI JUMPDEST,1
+PUSH1 JUMPI,1
+PUSH1 PUSH1,1
+)");
+}
+
 TEST_F(tracing, histogram_undefined_instruction)
 {
     vm.add_tracer(evmone::create_histogram_tracer(trace_stream));